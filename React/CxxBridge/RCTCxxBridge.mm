@@ -26,12 +26,14 @@
 #import <React/RCTPerformanceLogger.h>
 #import <React/RCTProfile.h>
 #import <React/RCTRedBox.h>
+#import <React/RCTRootView.h>
 #import <React/RCTUtils.h>
 #import <React/RCTFollyConvert.h>
 #import <cxxreact/CxxNativeModule.h>
 #import <cxxreact/Instance.h>
 #import <cxxreact/JSBundleType.h>
 #import <cxxreact/JSCExecutor.h>
+#import <cxxreact/JSCodeCache.h>
 #import <cxxreact/JSIndexedRAMBundle.h>
 #import <cxxreact/Platform.h>
 #import <cxxreact/RAMBundleRegistry.h>
@@ -103,6 +105,19 @@ static bool isRAMBundle(NSData *script) {
   return parseTypeFromHeader(header) == ScriptTag::RAMBundle;
 }
 
+// Per app, as the caches directory is shared on macOS.
+static NSString *cachesDirectory(NSString *name) {
+  NSString *appName = [NSBundle mainBundle].bundleIdentifier ?: @"React";
+  NSString *directory = [[NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject
+                          stringByAppendingPathComponent:appName]
+                         stringByAppendingPathComponent:name];
+  BOOL created = [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                           withIntermediateDirectories:YES
+                                                            attributes:nil
+                                                                 error:NULL];
+  return created ? directory : nil;
+}
+
 static void registerPerformanceLoggerHooks(RCTPerformanceLogger *performanceLogger) {
   __weak RCTPerformanceLogger *weakPerformanceLogger = performanceLogger;
   ReactMarker::logTaggedMarker = [weakPerformanceLogger](const ReactMarker::ReactMarkerId markerId, const char *tag) {
@@ -125,6 +140,8 @@ static void registerPerformanceLoggerHooks(RCTPerformanceLogger *performanceLogg
       case ReactMarker::JS_BUNDLE_STRING_CONVERT_STOP:
       case ReactMarker::NATIVE_MODULE_SETUP_START:
       case ReactMarker::NATIVE_MODULE_SETUP_STOP:
+      case ReactMarker::JS_CODE_CACHE_HIT:
+      case ReactMarker::JS_CODE_CACHE_MISS:
         // These are not used on iOS.
         break;
     }
@@ -504,6 +521,21 @@ struct RCTInstanceCallback : public InstanceCallback {
 
     [self _initializeBridgeLocked:executorFactory];
 
+    NSString *codeCacheDirectory = cachesDirectory(@"RCTCodeCache");
+    if (codeCacheDirectory) {
+      _reactInstance->setCodeCache(std::make_shared<JSCodeCache>(codeCacheDirectory.UTF8String));
+    }
+    // RAM bundles record their requires until startup is done, or prefetch
+    // the modules of the requires recorded before.
+    NSString *profileDirectory = cachesDirectory(@"RCTRAMBundleProfile");
+    if (profileDirectory) {
+      _reactInstance->setRAMBundleProfilePath([profileDirectory stringByAppendingPathComponent:@"main.profile"].UTF8String);
+      [[NSNotificationCenter defaultCenter] addObserver:self
+                                               selector:@selector(contentDidAppear:)
+                                                   name:RCTContentDidAppearNotification
+                                                 object:nil];
+    }
+
 #if RCT_PROFILE
     if (RCTProfileIsProfiling()) {
       _reactInstance->setGlobalVariable(
@@ -516,6 +548,23 @@ struct RCTInstanceCallback : public InstanceCallback {
   RCT_PROFILE_END_EVENT(RCTProfileTagAlways, @"");
 }
 
+- (void)contentDidAppear:(NSNotification *)notification
+{
+  RCTRootView *rootView = notification.object;
+  if (![rootView isKindOfClass:[RCTRootView class]] || rootView.bridge != _parentBridge) {
+    return;
+  }
+
+  [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                  name:RCTContentDidAppearNotification
+                                                object:nil];
+  [self ensureOnJavaScriptThread:^{
+    if (self->_reactInstance) {
+      self->_reactInstance->writeRAMBundleProfile();
+    }
+  }];
+}
+
 - (void)_initializeBridgeLocked:(std::shared_ptr<JSExecutorFactory>)executorFactory
 {
   std::lock_guard<std::mutex> guard(_moduleRegistryLock);
@@ -525,7 +574,8 @@ struct RCTInstanceCallback : public InstanceCallback {
                                    std::make_unique<RCTInstanceCallback>(self),
                                    executorFactory,
                                    _jsMessageThread,
-                                   [self _buildModuleRegistryUnlocked]);
+                                   [self _buildModuleRegistryUnlocked],
+                                   _reactInstance);
   _moduleRegistryCreated = YES;
 }
 
@@ -925,6 +975,10 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
   RCTAssertMainQueue();
   RCTLogInfo(@"Invalidating %@ (parent: %@, executor: %@)", self, _parentBridge, [self executorClass]);
 
+  [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                  name:RCTContentDidAppearNotification
+                                                object:nil];
+
   _loading = NO;
   _valid = NO;
   _didInvalidate = YES;
@@ -1177,6 +1231,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
       [self->_performanceLogger setValue:scriptStr->size() forTag:RCTPLRAMStartupCodeSize];
       if (self->_reactInstance) {
         auto registry = RAMBundleRegistry::multipleBundlesRegistry(std::move(ramBundle), JSIndexedRAMBundle::buildFactory());
+        self->_reactInstance->applyRAMBundleProfile(*registry, sourceUrlStr.UTF8String);
         self->_reactInstance->loadRAMBundle(std::move(registry), std::move(scriptStr),
                                             sourceUrlStr.UTF8String, !async);
       }
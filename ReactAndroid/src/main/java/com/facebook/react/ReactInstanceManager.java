@@ -84,6 +84,7 @@ import com.facebook.react.views.imagehelper.ResourceDrawableIdHelper;
 import com.facebook.soloader.SoLoader;
 import com.facebook.systrace.Systrace;
 import com.facebook.systrace.SystraceMessage;
+import java.io.File;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
@@ -1090,7 +1091,9 @@ public class ReactInstanceManager {
       .setJSExecutor(jsExecutor)
       .setRegistry(nativeModuleRegistry)
       .setJSBundleLoader(jsBundleLoader)
-      .setNativeModuleCallExceptionHandler(exceptionHandler);
+      .setNativeModuleCallExceptionHandler(exceptionHandler)
+      .setCodeCacheDirectory(getCacheDirectory("ReactCodeCache"))
+      .setRAMBundleProfilePath(getRAMBundleProfilePath());
 
     ReactMarker.logMarker(CREATE_CATALYST_INSTANCE_START);
     // CREATE_CATALYST_INSTANCE_END is in JSCExecutor.cpp
@@ -1116,6 +1119,16 @@ public class ReactInstanceManager {
     return reactContext;
   }
 
+  private @Nullable String getCacheDirectory(String name) {
+    File directory = new File(mApplicationContext.getCacheDir(), name);
+    return directory.isDirectory() || directory.mkdirs() ? directory.getPath() : null;
+  }
+
+  private @Nullable String getRAMBundleProfilePath() {
+    String directory = getCacheDirectory("ReactRAMBundleProfile");
+    return directory != null ? new File(directory, "main.profile").getPath() : null;
+  }
+
   private NativeModuleRegistry processPackages(
     ReactApplicationContext reactContext,
     List<ReactPackage> packages,
@@ -29,6 +29,7 @@ import java.lang.ref.WeakReference;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import javax.annotation.Nullable;
 
@@ -90,6 +91,7 @@ public class CatalystInstanceImpl implements CatalystInstance {
   private @Nullable String mSourceURL;
 
   private JavaScriptContextHolder mJavaScriptContextHolder;
+  private @Nullable RAMBundleProfileWriter mRAMBundleProfileWriter;
 
   // C++ parts
   private final HybridData mHybridData;
@@ -100,7 +102,9 @@ public class CatalystInstanceImpl implements CatalystInstance {
       final JavaScriptExecutor jsExecutor,
       final NativeModuleRegistry nativeModuleRegistry,
       final JSBundleLoader jsBundleLoader,
-      NativeModuleCallExceptionHandler nativeModuleCallExceptionHandler) {
+      NativeModuleCallExceptionHandler nativeModuleCallExceptionHandler,
+      @Nullable String codeCacheDirectory,
+      @Nullable String ramBundleProfilePath) {
     Log.d(ReactConstants.TAG, "Initializing React Xplat Bridge.");
     mHybridData = initHybrid();
 
@@ -124,10 +128,49 @@ public class CatalystInstanceImpl implements CatalystInstance {
       mNativeModuleRegistry.getJavaModules(this),
       mNativeModuleRegistry.getCxxModules());
     Log.d(ReactConstants.TAG, "Initializing React Xplat Bridge after initializeBridge");
+    if (codeCacheDirectory != null) {
+      jniSetCodeCacheDirectory(codeCacheDirectory);
+    }
+    if (ramBundleProfilePath != null) {
+      jniSetRAMBundleProfilePath(ramBundleProfilePath);
+      mRAMBundleProfileWriter = new RAMBundleProfileWriter(this);
+      ReactMarker.addListener(mRAMBundleProfileWriter);
+    }
 
     mJavaScriptContextHolder = new JavaScriptContextHolder(getJavaScriptContext());
   }
 
+  /**
+   * Writes the RAM bundle profile on the JS thread once content first
+   * appeared, which is when startup is done.
+   */
+  private static class RAMBundleProfileWriter implements ReactMarker.MarkerListener {
+    private final WeakReference<CatalystInstanceImpl> mOuter;
+    private final AtomicBoolean mWritten = new AtomicBoolean(false);
+
+    public RAMBundleProfileWriter(CatalystInstanceImpl outer) {
+      mOuter = new WeakReference<CatalystInstanceImpl>(outer);
+    }
+
+    @Override
+    public void logMarker(ReactMarkerConstants name, @Nullable String tag, int instanceKey) {
+      final CatalystInstanceImpl impl = mOuter.get();
+      if (name != ReactMarkerConstants.CONTENT_APPEARED || impl == null ||
+          !mWritten.compareAndSet(false, true)) {
+        return;
+      }
+      impl.mReactQueueConfiguration.getJSQueueThread().runOnQueue(
+          new Runnable() {
+            @Override
+            public void run() {
+              if (!impl.mDestroyed) {
+                impl.jniWriteRAMBundleProfile();
+              }
+            }
+          });
+    }
+  }
+
   private static class BridgeCallback implements ReactCallback {
     // We do this so the callback doesn't keep the CatalystInstanceImpl alive.
     // In this case, the callback is held in C++ code, so the GC can't see it
@@ -222,6 +265,9 @@ public class CatalystInstanceImpl implements CatalystInstance {
   }
 
   private native void jniSetSourceURL(String sourceURL);
+  private native void jniSetCodeCacheDirectory(String directory);
+  private native void jniSetRAMBundleProfilePath(String profilePath);
+  private native void jniWriteRAMBundleProfile();
   private native void jniRegisterSegment(int segmentId, String path);
   private native void jniLoadScriptFromAssets(AssetManager assetManager, String assetURL, boolean loadSynchronously);
   private native void jniLoadScriptFromFile(String fileName, String sourceURL, boolean loadSynchronously);
@@ -323,6 +369,9 @@ public class CatalystInstanceImpl implements CatalystInstance {
     // TODO: tell all APIs to shut down
     ReactMarker.logMarker(ReactMarkerConstants.DESTROY_CATALYST_INSTANCE_START);
     mDestroyed = true;
+    if (mRAMBundleProfileWriter != null) {
+      ReactMarker.removeListener(mRAMBundleProfileWriter);
+    }
 
     mNativeModulesQueueThread.runOnQueue(
         new Runnable() {
@@ -553,6 +602,8 @@ public class CatalystInstanceImpl implements CatalystInstance {
     private @Nullable NativeModuleRegistry mRegistry;
     private @Nullable JavaScriptExecutor mJSExecutor;
     private @Nullable NativeModuleCallExceptionHandler mNativeModuleCallExceptionHandler;
+    private @Nullable String mCodeCacheDirectory;
+    private @Nullable String mRAMBundleProfilePath;
 
     public Builder setReactQueueConfigurationSpec(
         ReactQueueConfigurationSpec ReactQueueConfigurationSpec) {
@@ -581,13 +632,34 @@ public class CatalystInstanceImpl implements CatalystInstance {
       return this;
     }
 
+    /**
+     * Directory in which the JS executor keeps the compiled form of the
+     * application script, if it can produce one.  It must exist.
+     */
+    public Builder setCodeCacheDirectory(@Nullable String codeCacheDirectory) {
+      mCodeCacheDirectory = codeCacheDirectory;
+      return this;
+    }
+
+    /**
+     * File in which RAM bundles loaded from a file record the modules they
+     * require during startup.  Later launches of the same bundle prefetch
+     * those modules on a background thread.
+     */
+    public Builder setRAMBundleProfilePath(@Nullable String ramBundleProfilePath) {
+      mRAMBundleProfilePath = ramBundleProfilePath;
+      return this;
+    }
+
     public CatalystInstanceImpl build() {
       return new CatalystInstanceImpl(
           Assertions.assertNotNull(mReactQueueConfigurationSpec),
           Assertions.assertNotNull(mJSExecutor),
           Assertions.assertNotNull(mRegistry),
           Assertions.assertNotNull(mJSBundleLoader),
-          Assertions.assertNotNull(mNativeModuleCallExceptionHandler));
+          Assertions.assertNotNull(mNativeModuleCallExceptionHandler),
+          mCodeCacheDirectory,
+          mRAMBundleProfilePath);
     }
   }
 }
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+
+/**
+ * Reads the contents of a native map or array, exported in a single JNI call as
+ * {int[] ops, double[] numbers, String[] strings}. The tags and layout are
+ * described in FlatDynamic.h.
+ */
+/* package */ class FlatDynamicReader {
+  private static final int NULL = 0;
+  private static final int FALSE = 1;
+  private static final int TRUE = 2;
+  private static final int NUMBER = 3;
+  private static final int STRING = 4;
+  private static final int ARRAY = 5;
+  private static final int OBJECT = 6;
+
+  private final int[] mOps;
+  private final double[] mNumbers;
+  private final String[] mStrings;
+  private int mOp;
+  private int mNumber;
+
+  private FlatDynamicReader(Object[] contents) {
+    mOps = (int[]) contents[0];
+    mNumbers = (double[]) contents[1];
+    mStrings = (String[]) contents[2];
+  }
+
+  @SuppressWarnings("unchecked")
+  public static HashMap<String, Object> readMap(Object[] contents) {
+    return (HashMap<String, Object>) new FlatDynamicReader(contents).readValue();
+  }
+
+  @SuppressWarnings("unchecked")
+  public static ArrayList<Object> readArray(Object[] contents) {
+    return (ArrayList<Object>) new FlatDynamicReader(contents).readValue();
+  }
+
+  private Object readValue() {
+    int tag = mOps[mOp++];
+    switch (tag) {
+      case NULL:
+        return null;
+      case FALSE:
+        return false;
+      case TRUE:
+        return true;
+      case NUMBER:
+        return mNumbers[mNumber++];
+      case STRING:
+        return mStrings[mOps[mOp++]];
+      case ARRAY: {
+        int size = mOps[mOp++];
+        ArrayList<Object> array = new ArrayList<>(size);
+        for (int i = 0; i < size; i++) {
+          array.add(readValue());
+        }
+        return array;
+      }
+      case OBJECT: {
+        int size = mOps[mOp++];
+        HashMap<String, Object> map = new HashMap<>();
+        for (int i = 0; i < size; i++) {
+          String key = mStrings[mOps[mOp++]];
+          map.put(key, readValue());
+        }
+        return map;
+      }
+      default:
+        throw new IllegalArgumentException("Unknown tag " + tag + " at " + (mOp - 1) + ".");
+    }
+  }
+}
@@ -57,6 +57,8 @@ public enum ReactMarkerConstants {
   UNPACKING_JS_BUNDLE_LOADER_BLOCKED,
   loadApplicationScript_startStringConvert,
   loadApplicationScript_endStringConvert,
+  JS_CODE_CACHE_HIT,
+  JS_CODE_CACHE_MISS,
   PRE_SETUP_REACT_CONTEXT_START,
   PRE_SETUP_REACT_CONTEXT_END,
   PRE_RUN_JS_BUNDLE_START,
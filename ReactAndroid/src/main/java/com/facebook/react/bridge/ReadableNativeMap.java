@@ -59,37 +59,12 @@ public class ReadableNativeMap extends NativeMap implements ReadableMap {
 
   @Override
   public HashMap<String, Object> toHashMap() {
-    ReadableMapKeySetIterator iterator = keySetIterator();
-    HashMap<String, Object> hashMap = new HashMap<>();
-
-    while (iterator.hasNextKey()) {
-      String key = iterator.nextKey();
-      switch (getType(key)) {
-        case Null:
-          hashMap.put(key, null);
-          break;
-        case Boolean:
-          hashMap.put(key, getBoolean(key));
-          break;
-        case Number:
-          hashMap.put(key, getDouble(key));
-          break;
-        case String:
-          hashMap.put(key, getString(key));
-          break;
-        case Map:
-          hashMap.put(key, getMap(key).toHashMap());
-          break;
-        case Array:
-          hashMap.put(key, getArray(key).toArrayList());
-          break;
-        default:
-          throw new IllegalArgumentException("Could not convert object with key: " + key + ".");
-      }
-    }
-    return hashMap;
+    return FlatDynamicReader.readMap(exportContents());
   }
 
+  // Exports the whole map in one call, rather than one call per key.
+  private native Object[] exportContents();
+
   /**
    * Implementation of a {@link ReadableNativeMap} iterator in native memory.
    */
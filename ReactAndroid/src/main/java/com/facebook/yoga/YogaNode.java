@@ -37,9 +37,15 @@ public class YogaNode {
   private Object mData;
 
   /* Those flags needs be in sync with YGJNI.cpp */
-  private final static int MARGIN = 1;
-  private final static int PADDING = 2;
-  private final static int BORDER = 4;
+  final static int MARGIN = 1;
+  final static int PADDING = 2;
+  final static int BORDER = 4;
+
+  /* Layout buffer format, needs be in sync with YGJNILayoutBuffer.h */
+  private final static int LAYOUT_FLAG_NEW_LAYOUT = 1;
+  private final static int LAYOUT_RECORD_SIZE = 19;
+
+  private static boolean sUseBulkLayoutTransfer = false;
 
   @DoNotStrip
   private int mEdgeSetFlag = 0;
@@ -179,9 +185,74 @@ public class YogaNode {
     return mChildren == null ? -1 : mChildren.indexOf(child);
   }
 
+  /**
+   * Whether calculateLayout copies the outputs of all nodes with a new layout
+   * to Java in a single buffer, instead of setting each node's fields from
+   * native.
+   */
+  public static void setUseBulkLayoutTransfer(boolean useBulkLayoutTransfer) {
+    sUseBulkLayoutTransfer = useBulkLayoutTransfer;
+  }
+
   private native void jni_YGNodeCalculateLayout(long nativePointer, float width, float height);
+  private native float[] jni_YGNodeCalculateLayoutBulk(long nativePointer, float width, float height);
   public void calculateLayout(float width, float height) {
-    jni_YGNodeCalculateLayout(mNativePointer, width, height);
+    if (sUseBulkLayoutTransfer) {
+      unpackLayoutOutputs(jni_YGNodeCalculateLayoutBulk(mNativePointer, width, height), 0);
+    } else {
+      jni_YGNodeCalculateLayout(mNativePointer, width, height);
+    }
+  }
+
+  /**
+   * Reads this node's record, and those of its children, from a buffer filled
+   * by jni_YGNodeCalculateLayoutBulk. Returns the offset after them.
+   */
+  private int unpackLayoutOutputs(float[] layout, int offset) {
+    if (((int) layout[offset] & LAYOUT_FLAG_NEW_LAYOUT) == 0) {
+      return offset + 1;
+    }
+
+    int childCount = (int) layout[offset + 1];
+    if (childCount != getChildCount()) {
+      throw new IllegalStateException(
+          "Native node has " + childCount + " children, Java node has " + getChildCount());
+    }
+
+    mWidth = layout[offset + 2];
+    mHeight = layout[offset + 3];
+    mLeft = layout[offset + 4];
+    mTop = layout[offset + 5];
+    mLayoutDirection = (int) layout[offset + 6];
+
+    if ((mEdgeSetFlag & MARGIN) == MARGIN) {
+      mMarginLeft = layout[offset + 7];
+      mMarginTop = layout[offset + 8];
+      mMarginRight = layout[offset + 9];
+      mMarginBottom = layout[offset + 10];
+    }
+
+    if ((mEdgeSetFlag & PADDING) == PADDING) {
+      mPaddingLeft = layout[offset + 11];
+      mPaddingTop = layout[offset + 12];
+      mPaddingRight = layout[offset + 13];
+      mPaddingBottom = layout[offset + 14];
+    }
+
+    if ((mEdgeSetFlag & BORDER) == BORDER) {
+      mBorderLeft = layout[offset + 15];
+      mBorderTop = layout[offset + 16];
+      mBorderRight = layout[offset + 17];
+      mBorderBottom = layout[offset + 18];
+    }
+
+    mHasNewLayout = true;
+
+    offset += LAYOUT_RECORD_SIZE;
+    for (int i = 0; i < childCount; i++) {
+      offset = getChildAt(i).unpackLayoutOutputs(layout, offset);
+    }
+    return offset;
   }
 
   public boolean hasNewLayout() {
@@ -203,6 +274,17 @@ public class YogaNode {
     jni_YGNodeCopyStyle(mNativePointer, srcNode.mNativePointer);
   }
 
+  private native void jni_YGNodeStyleApplyUpdates(long nativePointer, float[] records, int count);
+  /**
+   * Sets the style properties of the updates, in the order they were set, and marks this node
+   * dirty once if any of them changed.
+   */
+  public void applyStyleUpdates(YogaStyleUpdates updates) {
+    mEdgeSetFlag |= updates.mEdgeSetFlag;
+    mHasSetPosition |= updates.mHasSetPosition;
+    jni_YGNodeStyleApplyUpdates(mNativePointer, updates.mRecords, updates.mCount);
+  }
+
   public void markLayoutSeen() {
     mHasNewLayout = false;
   }
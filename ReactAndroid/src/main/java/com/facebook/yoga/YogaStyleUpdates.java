@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2014-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.yoga;
+
+import java.util.Arrays;
+
+/**
+ * Style properties to set on a node with {@link YogaNode#applyStyleUpdates}, which sets them all
+ * in one JNI call and marks the node dirty at most once. The setters are those of YogaNode, and
+ * the updates can be cleared and reused.
+ */
+public class YogaStyleUpdates {
+
+  /* Properties, needs be in sync with YGStyleProp in Yoga.h */
+  private final static int DIRECTION = 0;
+  private final static int FLEX_DIRECTION = 1;
+  private final static int JUSTIFY_CONTENT = 2;
+  private final static int ALIGN_CONTENT = 3;
+  private final static int ALIGN_ITEMS = 4;
+  private final static int ALIGN_SELF = 5;
+  private final static int POSITION_TYPE = 6;
+  private final static int FLEX_WRAP = 7;
+  private final static int OVERFLOW = 8;
+  private final static int DISPLAY = 9;
+  private final static int FLEX = 10;
+  private final static int FLEX_GROW = 11;
+  private final static int FLEX_SHRINK = 12;
+  private final static int FLEX_BASIS = 13;
+  private final static int MARGIN = 14;
+  private final static int POSITION = 23;
+  private final static int PADDING = 32;
+  private final static int BORDER = 41;
+  private final static int DIMENSIONS = 50;
+  private final static int MAX_DIMENSIONS = 52;
+  private final static int MIN_DIMENSIONS = 54;
+  private final static int ASPECT_RATIO = 56;
+
+  /* Record format, needs be in sync with YGJNIStyleUpdates.h */
+  private final static int RECORD_SIZE = 3;
+
+  float[] mRecords = new float[RECORD_SIZE * 8];
+  int mCount = 0;
+  int mEdgeSetFlag = 0;
+  boolean mHasSetPosition = false;
+
+  public void clear() {
+    mCount = 0;
+    mEdgeSetFlag = 0;
+    mHasSetPosition = false;
+  }
+
+  public boolean isEmpty() {
+    return mCount == 0;
+  }
+
+  private void add(int prop, YogaUnit unit, float value) {
+    int offset = mCount * RECORD_SIZE;
+    if (offset == mRecords.length) {
+      mRecords = Arrays.copyOf(mRecords, mRecords.length * 2);
+    }
+    mRecords[offset] = prop;
+    mRecords[offset + 1] = unit.intValue();
+    mRecords[offset + 2] = value;
+    mCount++;
+  }
+
+  public void setDirection(YogaDirection direction) {
+    add(DIRECTION, YogaUnit.POINT, direction.intValue());
+  }
+
+  public void setFlexDirection(YogaFlexDirection flexDirection) {
+    add(FLEX_DIRECTION, YogaUnit.POINT, flexDirection.intValue());
+  }
+
+  public void setJustifyContent(YogaJustify justifyContent) {
+    add(JUSTIFY_CONTENT, YogaUnit.POINT, justifyContent.intValue());
+  }
+
+  public void setAlignItems(YogaAlign alignItems) {
+    add(ALIGN_ITEMS, YogaUnit.POINT, alignItems.intValue());
+  }
+
+  public void setAlignSelf(YogaAlign alignSelf) {
+    add(ALIGN_SELF, YogaUnit.POINT, alignSelf.intValue());
+  }
+
+  public void setAlignContent(YogaAlign alignContent) {
+    add(ALIGN_CONTENT, YogaUnit.POINT, alignContent.intValue());
+  }
+
+  public void setPositionType(YogaPositionType positionType) {
+    add(POSITION_TYPE, YogaUnit.POINT, positionType.intValue());
+  }
+
+  public void setWrap(YogaWrap flexWrap) {
+    add(FLEX_WRAP, YogaUnit.POINT, flexWrap.intValue());
+  }
+
+  public void setOverflow(YogaOverflow overflow) {
+    add(OVERFLOW, YogaUnit.POINT, overflow.intValue());
+  }
+
+  public void setDisplay(YogaDisplay display) {
+    add(DISPLAY, YogaUnit.POINT, display.intValue());
+  }
+
+  public void setFlex(float flex) {
+    add(FLEX, YogaUnit.POINT, flex);
+  }
+
+  public void setFlexGrow(float flexGrow) {
+    add(FLEX_GROW, YogaUnit.POINT, flexGrow);
+  }
+
+  public void setFlexShrink(float flexShrink) {
+    add(FLEX_SHRINK, YogaUnit.POINT, flexShrink);
+  }
+
+  public void setFlexBasis(float flexBasis) {
+    add(FLEX_BASIS, YogaUnit.POINT, flexBasis);
+  }
+
+  public void setFlexBasisPercent(float percent) {
+    add(FLEX_BASIS, YogaUnit.PERCENT, percent);
+  }
+
+  public void setFlexBasisAuto() {
+    add(FLEX_BASIS, YogaUnit.AUTO, YogaConstants.UNDEFINED);
+  }
+
+  public void setMargin(YogaEdge edge, float margin) {
+    mEdgeSetFlag |= YogaNode.MARGIN;
+    add(MARGIN + edge.intValue(), YogaUnit.POINT, margin);
+  }
+
+  public void setMarginPercent(YogaEdge edge, float percent) {
+    mEdgeSetFlag |= YogaNode.MARGIN;
+    add(MARGIN + edge.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setMarginAuto(YogaEdge edge) {
+    mEdgeSetFlag |= YogaNode.MARGIN;
+    add(MARGIN + edge.intValue(), YogaUnit.AUTO, YogaConstants.UNDEFINED);
+  }
+
+  public void setPadding(YogaEdge edge, float padding) {
+    mEdgeSetFlag |= YogaNode.PADDING;
+    add(PADDING + edge.intValue(), YogaUnit.POINT, padding);
+  }
+
+  public void setPaddingPercent(YogaEdge edge, float percent) {
+    mEdgeSetFlag |= YogaNode.PADDING;
+    add(PADDING + edge.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setBorder(YogaEdge edge, float border) {
+    mEdgeSetFlag |= YogaNode.BORDER;
+    add(BORDER + edge.intValue(), YogaUnit.POINT, border);
+  }
+
+  public void setPosition(YogaEdge edge, float position) {
+    mHasSetPosition = true;
+    add(POSITION + edge.intValue(), YogaUnit.POINT, position);
+  }
+
+  public void setPositionPercent(YogaEdge edge, float percent) {
+    mHasSetPosition = true;
+    add(POSITION + edge.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setWidth(float width) {
+    add(DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.POINT, width);
+  }
+
+  public void setWidthPercent(float percent) {
+    add(DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setWidthAuto() {
+    add(DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.AUTO, YogaConstants.UNDEFINED);
+  }
+
+  public void setHeight(float height) {
+    add(DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.POINT, height);
+  }
+
+  public void setHeightPercent(float percent) {
+    add(DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setHeightAuto() {
+    add(DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.AUTO, YogaConstants.UNDEFINED);
+  }
+
+  public void setMinWidth(float minWidth) {
+    add(MIN_DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.POINT, minWidth);
+  }
+
+  public void setMinWidthPercent(float percent) {
+    add(MIN_DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setMinHeight(float minHeight) {
+    add(MIN_DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.POINT, minHeight);
+  }
+
+  public void setMinHeightPercent(float percent) {
+    add(MIN_DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setMaxWidth(float maxWidth) {
+    add(MAX_DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.POINT, maxWidth);
+  }
+
+  public void setMaxWidthPercent(float percent) {
+    add(MAX_DIMENSIONS + YogaDimension.WIDTH.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setMaxHeight(float maxHeight) {
+    add(MAX_DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.POINT, maxHeight);
+  }
+
+  public void setMaxHeightPercent(float percent) {
+    add(MAX_DIMENSIONS + YogaDimension.HEIGHT.intValue(), YogaUnit.PERCENT, percent);
+  }
+
+  public void setAspectRatio(float aspectRatio) {
+    add(ASPECT_RATIO, YogaUnit.POINT, aspectRatio);
+  }
+}
@@ -11,6 +11,8 @@
 #include <yoga/YGNode.h>
 #include <yoga/Yoga.h>
 #include <iostream>
+#include "YGJNILayoutBuffer.h"
+#include "YGJNIStyleUpdates.h"
 
 using namespace facebook::jni;
 using namespace std;
@@ -247,6 +249,24 @@ void jni_YGNodeCalculateLayout(alias_ref<jobject>,
   YGTransferLayoutOutputsRecursive(root);
 }
 
+local_ref<jfloatArray> jni_YGNodeCalculateLayoutBulk(alias_ref<jobject>,
+                                                    jlong nativePointer,
+                                                    jfloat width,
+                                                    jfloat height) {
+  const YGNodeRef root = _jlong2YGNodeRef(nativePointer);
+  YGNodeCalculateLayout(root,
+                        static_cast<float>(width),
+                        static_cast<float>(height),
+                        YGNodeStyleGetDirection(root));
+
+  std::vector<float> buffer;
+  buffer.reserve(YGJNILayoutBufferRecordSize * (1 + YGNodeGetChildCount(root)));
+  YGJNIPackLayoutOutputs(root, buffer);
+  auto layout = JArrayFloat::newArray(buffer.size());
+  layout->setRegion(0, buffer.size(), buffer.data());
+  return layout;
+}
+
 void jni_YGNodeMarkDirty(alias_ref<jobject>, jlong nativePointer) {
   YGNodeMarkDirty(_jlong2YGNodeRef(nativePointer));
 }
@@ -271,6 +291,16 @@ void jni_YGNodeCopyStyle(alias_ref<jobject>, jlong dstNativePointer, jlong srcNa
   YGNodeCopyStyle(_jlong2YGNodeRef(dstNativePointer), _jlong2YGNodeRef(srcNativePointer));
 }
 
+void jni_YGNodeStyleApplyUpdates(alias_ref<jobject>,
+                                 jlong nativePointer,
+                                 alias_ref<jfloatArray> records,
+                                 jint count) {
+  const auto values = records->getRegion(0, count * YGJNIStyleUpdateRecordSize);
+  std::vector<YGStyleUpdate> updates;
+  YGJNIUnpackStyleUpdates(values.get(), count, updates);
+  YGNodeStyleApplyUpdates(_jlong2YGNodeRef(nativePointer), updates.data(), updates.size());
+}
+
 struct JYogaValue : public JavaClass<JYogaValue> {
   constexpr static auto kJavaDescriptor = "Lcom/facebook/yoga/YogaValue;";
 
@@ -458,11 +488,13 @@ jint JNI_OnLoad(JavaVM *vm, void *) {
                         YGMakeNativeMethod(jni_YGNodeInsertChild),
                         YGMakeNativeMethod(jni_YGNodeRemoveChild),
                         YGMakeNativeMethod(jni_YGNodeCalculateLayout),
+                        YGMakeNativeMethod(jni_YGNodeCalculateLayoutBulk),
                         YGMakeNativeMethod(jni_YGNodeMarkDirty),
                         YGMakeNativeMethod(jni_YGNodeIsDirty),
                         YGMakeNativeMethod(jni_YGNodeSetHasMeasureFunc),
                         YGMakeNativeMethod(jni_YGNodeSetHasBaselineFunc),
                         YGMakeNativeMethod(jni_YGNodeCopyStyle),
+                        YGMakeNativeMethod(jni_YGNodeStyleApplyUpdates),
                         YGMakeNativeMethod(jni_YGNodeStyleGetDirection),
                         YGMakeNativeMethod(jni_YGNodeStyleSetDirection),
                         YGMakeNativeMethod(jni_YGNodeStyleGetFlexDirection),
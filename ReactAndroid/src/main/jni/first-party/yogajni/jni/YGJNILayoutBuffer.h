@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#pragma once
+
+#include <vector>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+// Packs layout outputs into a float array, so that they can be copied to Java
+// in one JNI call rather than with a field write per value.
+//
+// Nodes are visited depth first, starting at the root and descending only
+// into nodes with a new layout, which is the traversal YogaNode.java repeats
+// over its own children to unpack them.  Each visited node writes a record:
+//
+//   [0]      YGJNILayoutBufferFlagNewLayout if the node has a new layout,
+//            otherwise 0 and the record ends there
+//   [1]      child count
+//   [2..5]   width, height, left, top
+//   [6]      layout direction
+//   [7..10]  margin left, top, right, bottom
+//   [11..14] padding left, top, right, bottom
+//   [15..18] border left, top, right, bottom
+//
+// followed by the records of its children.  Packing clears hasNewLayout, as
+// the field by field transfer does.
+
+enum {
+  YGJNILayoutBufferFlagNewLayout = 1,
+  YGJNILayoutBufferRecordSize = 19,
+};
+
+static inline void YGJNIPackEdges(
+    std::vector<float>& buffer,
+    float (*getter)(YGNodeRef, YGEdge),
+    YGNodeRef node) {
+  buffer.push_back(getter(node, YGEdgeLeft));
+  buffer.push_back(getter(node, YGEdgeTop));
+  buffer.push_back(getter(node, YGEdgeRight));
+  buffer.push_back(getter(node, YGEdgeBottom));
+}
+
+static inline void YGJNIPackLayoutOutputsRecursive(
+    YGNodeRef node,
+    std::vector<float>& buffer) {
+  if (!node->getHasNewLayout()) {
+    buffer.push_back(0);
+    return;
+  }
+
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  buffer.push_back(YGJNILayoutBufferFlagNewLayout);
+  buffer.push_back(childCount);
+  buffer.push_back(YGNodeLayoutGetWidth(node));
+  buffer.push_back(YGNodeLayoutGetHeight(node));
+  buffer.push_back(YGNodeLayoutGetLeft(node));
+  buffer.push_back(YGNodeLayoutGetTop(node));
+  buffer.push_back(YGNodeLayoutGetDirection(node));
+  YGJNIPackEdges(buffer, YGNodeLayoutGetMargin, node);
+  YGJNIPackEdges(buffer, YGNodeLayoutGetPadding, node);
+  YGJNIPackEdges(buffer, YGNodeLayoutGetBorder, node);
+  node->setHasNewLayout(false);
+
+  for (uint32_t i = 0; i < childCount; i++) {
+    YGJNIPackLayoutOutputsRecursive(YGNodeGetChild(node, i), buffer);
+  }
+}
+
+// Replaces the buffer's contents, keeping its capacity.
+static inline void YGJNIPackLayoutOutputs(
+    YGNodeRef root,
+    std::vector<float>& buffer) {
+  buffer.clear();
+  YGJNIPackLayoutOutputsRecursive(root, buffer);
+}
@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#pragma once
+
+#include <vector>
+#include <yoga/Yoga.h>
+
+// Unpacks style updates that YogaStyleUpdates.java has packed into a float
+// array, so that a node's style can be updated in one JNI call rather than
+// with a call per property.  Each update is a record of:
+//
+//   [0]  the YGStyleProp, plus the edge or dimension for those that have one
+//   [1]  the YGUnit of the value
+//   [2]  the value, or the value of the enum
+
+enum {
+  YGJNIStyleUpdateRecordSize = 3,
+};
+
+// Replaces the contents of updates, keeping its capacity.
+static inline void YGJNIUnpackStyleUpdates(
+    const float* records,
+    size_t count,
+    std::vector<YGStyleUpdate>& updates) {
+  updates.clear();
+  for (size_t i = 0; i < count; i++) {
+    const float* record = records + i * YGJNIStyleUpdateRecordSize;
+    updates.push_back(YGStyleUpdate{
+        static_cast<uint32_t>(record[0]),
+        YGValue{record[2], static_cast<YGUnit>(record[1])}});
+  }
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#include <gtest/gtest.h>
+#include <YGJNILayoutBuffer.h>
+
+TEST(YGJNILayoutBufferTest, packs_records_depth_first) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 50);
+  YGNodeStyleSetPadding(root, YGEdgeLeft, 5);
+  YGNodeStyleSetBorder(root, YGEdgeTop, 2);
+
+  const YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetWidth(child, 10);
+  YGNodeStyleSetHeight(child, 20);
+  YGNodeStyleSetMargin(child, YGEdgeRight, 3);
+  YGNodeInsertChild(root, child, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionRTL);
+
+  std::vector<float> buffer;
+  YGJNIPackLayoutOutputs(root, buffer);
+
+  const std::vector<float> expected = {
+      // root
+      YGJNILayoutBufferFlagNewLayout, 1,
+      100, 50, 0, 0,
+      YGDirectionRTL,
+      0, 0, 0, 0,
+      5, 0, 0, 0,
+      0, 2, 0, 0,
+      // child, right aligned by RTL: 100 - 10 - 3 margin
+      YGJNILayoutBufferFlagNewLayout, 0,
+      10, 20, 87, 2,
+      YGDirectionRTL,
+      0, 0, 3, 0,
+      0, 0, 0, 0,
+      0, 0, 0, 0,
+  };
+  ASSERT_EQ(2 * YGJNILayoutBufferRecordSize, buffer.size());
+  ASSERT_EQ(expected, buffer);
+
+  ASSERT_FALSE(root->getHasNewLayout());
+  ASSERT_FALSE(child->getHasNewLayout());
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YGJNILayoutBufferTest, skips_subtrees_without_new_layout) {
+  const YGNodeRef root = YGNodeNew();
+  const YGNodeRef first = YGNodeNew();
+  const YGNodeRef second = YGNodeNew();
+  const YGNodeRef grandchild = YGNodeNew();
+  YGNodeInsertChild(root, first, 0);
+  YGNodeInsertChild(root, second, 1);
+  YGNodeInsertChild(first, grandchild, 0);
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+
+  first->setHasNewLayout(false);
+
+  std::vector<float> buffer;
+  YGJNIPackLayoutOutputs(root, buffer);
+
+  // root, a single 0 for first and its child, then second.
+  ASSERT_EQ(2 * YGJNILayoutBufferRecordSize + 1, buffer.size());
+  ASSERT_EQ(2, buffer[1]);
+  ASSERT_EQ(0, buffer[YGJNILayoutBufferRecordSize]);
+  ASSERT_EQ(YGJNILayoutBufferFlagNewLayout, buffer[YGJNILayoutBufferRecordSize + 1]);
+  ASSERT_TRUE(grandchild->getHasNewLayout());
+
+  // Nothing is new the second time.
+  YGJNIPackLayoutOutputs(root, buffer);
+  ASSERT_EQ(std::vector<float>{0}, buffer);
+
+  YGNodeFreeRecursive(root);
+}
@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#include <gtest/gtest.h>
+#include <YGJNIStyleUpdates.h>
+
+TEST(YGJNIStyleUpdatesTest, unpacks_records_in_order) {
+  const float records[] = {
+      YGStylePropFlexDirection, YGUnitPoint, YGFlexDirectionRow,
+      YGStylePropMargin + YGEdgeTop, YGUnitPercent, 10,
+      YGStylePropDimensions + YGDimensionWidth, YGUnitAuto, YGUndefined,
+  };
+
+  std::vector<YGStyleUpdate> updates;
+  YGJNIUnpackStyleUpdates(records, 3, updates);
+
+  ASSERT_EQ(3u, updates.size());
+  ASSERT_EQ(YGStylePropFlexDirection, updates[0].prop);
+  ASSERT_EQ(YGUnitPoint, updates[0].value.unit);
+  ASSERT_EQ(YGFlexDirectionRow, updates[0].value.value);
+  ASSERT_EQ(YGStylePropMargin + YGEdgeTop, updates[1].prop);
+  ASSERT_EQ(YGUnitPercent, updates[1].value.unit);
+  ASSERT_EQ(10, updates[1].value.value);
+  ASSERT_EQ(YGStylePropDimensions + YGDimensionWidth, updates[2].prop);
+  ASSERT_EQ(YGUnitAuto, updates[2].value.unit);
+
+  const YGNodeRef node = YGNodeNew();
+  YGNodeStyleApplyUpdates(node, updates.data(), updates.size());
+  ASSERT_EQ(YGFlexDirectionRow, YGNodeStyleGetFlexDirection(node));
+  ASSERT_EQ(10, YGNodeStyleGetMargin(node, YGEdgeTop).value);
+  ASSERT_EQ(YGUnitPercent, YGNodeStyleGetMargin(node, YGEdgeTop).unit);
+  ASSERT_EQ(YGUnitAuto, YGNodeStyleGetWidth(node).unit);
+  YGNodeFree(node);
+}
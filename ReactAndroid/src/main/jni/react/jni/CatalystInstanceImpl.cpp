@@ -9,9 +9,11 @@
 #include <cxxreact/Instance.h>
 #include <cxxreact/JSBigString.h>
 #include <cxxreact/JSBundleType.h>
+#include <cxxreact/JSCodeCache.h>
 #include <cxxreact/JSIndexedRAMBundle.h>
 #include <cxxreact/MethodCall.h>
 #include <cxxreact/ModuleRegistry.h>
+#include <cxxreact/NativeCallScheduler.h>
 #include <cxxreact/RecoverableError.h>
 #include <cxxreact/RAMBundleRegistry.h>
 #include <fb/log.h>
@@ -42,15 +44,22 @@ class JInstanceCallback : public InstanceCallback {
  public:
   explicit JInstanceCallback(
     alias_ref<ReactCallback::javaobject> jobj,
-    std::shared_ptr<JMessageQueueThread> messageQueueThread)
+    std::shared_ptr<MessageQueueThread> messageQueueThread)
   : jobj_(make_global(jobj)), messageQueueThread_(std::move(messageQueueThread)) {}
 
   void onBatchComplete() override {
-    messageQueueThread_->runOnQueue([this] {
+    auto task = [this] {
       static auto method =
         ReactCallback::javaClassStatic()->getMethod<void()>("onBatchComplete");
       method(jobj_);
-    });
+    };
+    // Behind the batch's background calls too, which the scheduler may have
+    // put off.
+    if (auto scheduler = dynamic_cast<NativeCallScheduler*>(messageQueueThread_.get())) {
+      scheduler->runAfterPending(std::move(task));
+    } else {
+      messageQueueThread_->runOnQueue(std::move(task));
+    }
   }
 
   void incrementPendingJSCalls() override {
@@ -72,7 +81,7 @@ class JInstanceCallback : public InstanceCallback {
 
  private:
   global_ref<ReactCallback::javaobject> jobj_;
-  std::shared_ptr<JMessageQueueThread> messageQueueThread_;
+  std::shared_ptr<MessageQueueThread> messageQueueThread_;
 };
 
 }
@@ -97,6 +106,9 @@ void CatalystInstanceImpl::registerNatives() {
     makeNativeMethod("initializeBridge", CatalystInstanceImpl::initializeBridge),
     makeNativeMethod("jniExtendNativeModules", CatalystInstanceImpl::extendNativeModules),
     makeNativeMethod("jniSetSourceURL", CatalystInstanceImpl::jniSetSourceURL),
+    makeNativeMethod("jniSetCodeCacheDirectory", CatalystInstanceImpl::jniSetCodeCacheDirectory),
+    makeNativeMethod("jniSetRAMBundleProfilePath", CatalystInstanceImpl::jniSetRAMBundleProfilePath),
+    makeNativeMethod("jniWriteRAMBundleProfile", CatalystInstanceImpl::jniWriteRAMBundleProfile),
     makeNativeMethod("jniRegisterSegment", CatalystInstanceImpl::jniRegisterSegment),
     makeNativeMethod("jniLoadScriptFromAssets", CatalystInstanceImpl::jniLoadScriptFromAssets),
     makeNativeMethod("jniLoadScriptFromFile", CatalystInstanceImpl::jniLoadScriptFromFile),
@@ -120,7 +132,10 @@ void CatalystInstanceImpl::initializeBridge(
     jni::alias_ref<jni::JCollection<ModuleHolder::javaobject>::javaobject> cxxModules) {
   // TODO mhorowitz: how to assert here?
   // Assertions.assertCondition(mBridge == null, "initializeBridge should be called once");
-  moduleMessageQueue_ = std::make_shared<JMessageQueueThread>(nativeModulesQueue);
+  // C++ module calls declared UI-critical run ahead of queued calls to
+  // other modules; everything else keeps its order.
+  moduleMessageQueue_ = std::make_shared<NativeCallScheduler>(
+    std::make_shared<JMessageQueueThread>(nativeModulesQueue));
 
   // This used to be:
   //
@@ -151,7 +166,8 @@ void CatalystInstanceImpl::initializeBridge(
     moduleMessageQueue_),
     jseh->getExecutorFactory(),
     folly::make_unique<JMessageQueueThread>(jsQueue),
-    moduleRegistry_);
+    moduleRegistry_,
+    instance_);
 }
 
 void CatalystInstanceImpl::extendNativeModules(
@@ -168,6 +184,18 @@ void CatalystInstanceImpl::jniSetSourceURL(const std::string& sourceURL) {
   instance_->setSourceURL(sourceURL);
 }
 
+void CatalystInstanceImpl::jniSetCodeCacheDirectory(const std::string& directory) {
+  instance_->setCodeCache(std::make_shared<JSCodeCache>(directory));
+}
+
+void CatalystInstanceImpl::jniSetRAMBundleProfilePath(const std::string& profilePath) {
+  instance_->setRAMBundleProfilePath(profilePath);
+}
+
+void CatalystInstanceImpl::jniWriteRAMBundleProfile() {
+  instance_->writeRAMBundleProfile();
+}
+
 void CatalystInstanceImpl::jniRegisterSegment(int segmentId, const std::string& path) {
   instance_->registerBundle((uint32_t)segmentId, path);
 }
@@ -58,6 +58,18 @@ class CatalystInstanceImpl : public jni::HybridClass<CatalystInstanceImpl> {
    */
   void jniSetSourceURL(const std::string& sourceURL);
 
+  /**
+   * Keeps the compiled form of scripts loaded from now on in the given
+   * directory, see JSCodeCache.
+   */
+  void jniSetCodeCacheDirectory(const std::string& directory);
+
+  /**
+   * See Instance::setRAMBundleProfilePath and writeRAMBundleProfile.
+   */
+  void jniSetRAMBundleProfilePath(const std::string& profilePath);
+  void jniWriteRAMBundleProfile();
+
   /**
    * Registers the file path of an additional JS segment by its ID.
    *
@@ -77,7 +89,7 @@ class CatalystInstanceImpl : public jni::HybridClass<CatalystInstanceImpl> {
   // will have a weak reference.
   std::shared_ptr<Instance> instance_;
   std::shared_ptr<ModuleRegistry> moduleRegistry_;
-  std::shared_ptr<JMessageQueueThread> moduleMessageQueue_;
+  std::shared_ptr<MessageQueueThread> moduleMessageQueue_;
 };
 
 }}
@@ -0,0 +1,99 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <folly/Conv.h>
+
+namespace facebook {
+namespace react {
+
+// The parameter types in the signatures JavaMethodWrapper.java builds.
+enum class JavaParamType : uint8_t {
+  Boolean,
+  BoxedBoolean,
+  Int,
+  BoxedInt,
+  Float,
+  BoxedFloat,
+  Double,
+  BoxedDouble,
+  String,
+  Array,
+  Map,
+  Callback,
+  Promise,
+};
+
+/**
+ * A Java module method signature, such as "v.iSX" for
+ * void method(int, String, Callback), decoded once so that calls don't
+ * have to walk the string.  It is the return type, a '.' and a character
+ * per parameter.
+ */
+struct JavaMethodSignature {
+  char returnType;
+  std::vector<JavaParamType> params;
+  // Promises take two arguments from JS, resolve and reject.
+  std::size_t jsArgCount;
+};
+
+inline JavaParamType parseJavaParamType(char type) {
+  switch (type) {
+    case 'z': return JavaParamType::Boolean;
+    case 'Z': return JavaParamType::BoxedBoolean;
+    case 'i': return JavaParamType::Int;
+    case 'I': return JavaParamType::BoxedInt;
+    case 'f': return JavaParamType::Float;
+    case 'F': return JavaParamType::BoxedFloat;
+    case 'd': return JavaParamType::Double;
+    case 'D': return JavaParamType::BoxedDouble;
+    case 'S': return JavaParamType::String;
+    case 'A': return JavaParamType::Array;
+    case 'M': return JavaParamType::Map;
+    case 'X': return JavaParamType::Callback;
+    case 'P': return JavaParamType::Promise;
+    default:
+      throw std::invalid_argument(
+        folly::to<std::string>("Unknown param type: ", type));
+  }
+}
+
+inline JavaMethodSignature parseJavaMethodSignature(const std::string& signature, bool isSync) {
+  if (signature.size() < 2 || signature[1] != '.') {
+    throw std::invalid_argument(
+      folly::to<std::string>("Improper module method signature: ", signature));
+  }
+
+  JavaMethodSignature result;
+  result.returnType = signature[0];
+  switch (result.returnType) {
+    case 'v':
+      break;
+    case 'z': case 'Z': case 'i': case 'I': case 'f': case 'F':
+    case 'd': case 'D': case 'S': case 'A': case 'M':
+      if (!isSync) {
+        throw std::invalid_argument("Non-sync hooks cannot have a non-void return type");
+      }
+      break;
+    default:
+      throw std::invalid_argument(
+        folly::to<std::string>("Unknown return type: ", result.returnType));
+  }
+
+  result.params.reserve(signature.size() - 2);
+  result.jsArgCount = 0;
+  for (auto it = signature.begin() + 2; it != signature.end(); ++it) {
+    auto type = parseJavaParamType(*it);
+    result.params.push_back(type);
+    result.jsArgCount += type == JavaParamType::Promise ? 2 : 1;
+  }
+  return result;
+}
+
+}
+}
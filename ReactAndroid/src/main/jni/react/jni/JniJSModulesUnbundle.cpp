@@ -6,7 +6,6 @@
 #include <fb/assert.h>
 #include <libgen.h>
 #include <memory>
-#include <sstream>
 #include <sys/endian.h>
 #include <utility>
 
@@ -29,12 +28,12 @@ static std::string jsModulesDir(const std::string& entryFile) {
   return dir == "." ? "js-modules/" : dir + "/js-modules/";
 }
 
-static asset_ptr openAsset(
+static asset_ptr openAssetFile(
     AAssetManager *manager,
-    const std::string& fileName,
+    const char *fileName,
     int mode = AASSET_MODE_STREAMING) {
   return asset_ptr(
-    AAssetManager_open(manager, fileName.c_str(), mode),
+    AAssetManager_open(manager, fileName, mode),
     AAsset_close);
 }
 
@@ -45,8 +44,8 @@ std::unique_ptr<JniJSModulesUnbundle> JniJSModulesUnbundle::fromEntryFile(
   }
 
 JniJSModulesUnbundle::JniJSModulesUnbundle(AAssetManager *assetManager, const std::string& moduleDirectory) :
-  m_assetManager(assetManager),
-  m_moduleDirectory(moduleDirectory) {}
+  JSAssetModulesUnbundle(moduleDirectory),
+  m_assetManager(assetManager) {}
 
 bool JniJSModulesUnbundle::isUnbundle(
     AAssetManager *assetManager,
@@ -56,7 +55,7 @@ bool JniJSModulesUnbundle::isUnbundle(
   }
 
   auto magicFileName = jsModulesDir(assetName) + MAGIC_FILE_NAME;
-  auto asset = openAsset(assetManager, magicFileName.c_str());
+  auto asset = openAssetFile(assetManager, magicFileName.c_str());
   if (asset == nullptr) {
     return false;
   }
@@ -66,25 +65,45 @@ bool JniJSModulesUnbundle::isUnbundle(
   return fileHeader == htole32(MAGIC_FILE_HEADER);
 }
 
-JSModulesUnbundle::Module JniJSModulesUnbundle::getModule(uint32_t moduleId) const {
-  // can be nullptr for default constructor.
-  FBASSERTMSGF(m_assetManager != nullptr, "Unbundle has not been initialized with an asset manager");
+namespace {
+
+// The buffer of an asset opened with AASSET_MODE_BUFFER; module code points
+// into it for as long as the JS engine holds on to it.
+class BufferedAsset : public JSAssetModulesUnbundle::Asset {
+public:
+  BufferedAsset(asset_ptr asset, const char *buffer)
+  : m_asset(std::move(asset))
+  , m_buffer(buffer) {}
 
-  std::ostringstream sourceUrlBuilder;
-  sourceUrlBuilder << moduleId << ".js";
-  auto sourceUrl = sourceUrlBuilder.str();
+  const char* data() const override {
+    return m_buffer;
+  }
+
+  size_t size() const override {
+    return AAsset_getLength(m_asset.get());
+  }
 
-  auto fileName = m_moduleDirectory + sourceUrl;
-  auto asset = openAsset(m_assetManager, fileName, AASSET_MODE_BUFFER);
+private:
+  asset_ptr m_asset;
+  const char *m_buffer;
+};
+
+}
+
+std::unique_ptr<JSAssetModulesUnbundle::Asset> JniJSModulesUnbundle::openAsset(
+    const char* assetName) const {
+  // can be nullptr for default constructor.
+  FBASSERTMSGF(m_assetManager != nullptr, "Unbundle has not been initialized with an asset manager");
 
+  auto asset = openAssetFile(m_assetManager, assetName, AASSET_MODE_BUFFER);
   const char *buffer = nullptr;
   if (asset != nullptr) {
     buffer = static_cast<const char *>(AAsset_getBuffer(asset.get()));
   }
   if (buffer == nullptr) {
-    throw ModuleNotFound("Module not found: " + sourceUrl);
+    return nullptr;
   }
-  return {sourceUrl, std::string(buffer, AAsset_getLength(asset.get()))};
+  return folly::make_unique<BufferedAsset>(std::move(asset), buffer);
 }
 
 }
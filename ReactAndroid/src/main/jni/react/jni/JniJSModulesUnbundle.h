@@ -5,17 +5,17 @@
 #include <memory>
 
 #include <android/asset_manager.h>
-#include <cxxreact/JSModulesUnbundle.h>
+#include <cxxreact/JSAssetModulesUnbundle.h>
 
 namespace facebook {
 namespace react {
 
-class JniJSModulesUnbundle : public JSModulesUnbundle {
+class JniJSModulesUnbundle : public JSAssetModulesUnbundle {
   /**
    * This implementation reads modules as single file from the assets of an apk.
    */
 public:
-  JniJSModulesUnbundle() = default;
+  JniJSModulesUnbundle() : JSAssetModulesUnbundle("") {}
   JniJSModulesUnbundle(AAssetManager *assetManager, const std::string& moduleDirectory);
   JniJSModulesUnbundle(JniJSModulesUnbundle&& other) = delete;
   JniJSModulesUnbundle& operator= (JSModulesUnbundle&& other) = delete;
@@ -25,10 +25,10 @@ public:
   static bool isUnbundle(
     AAssetManager *assetManager,
     const std::string& assetName);
-  virtual Module getModule(uint32_t moduleId) const override;
+protected:
+  std::unique_ptr<Asset> openAsset(const char* assetName) const override;
 private:
   AAssetManager *m_assetManager = nullptr;
-  std::string m_moduleDirectory;
 };
 
 }
@@ -24,6 +24,8 @@ namespace {
 
 using dynamic_iterator = folly::dynamic::const_iterator;
 
+constexpr size_t kInlineArgs = 8;
+
 struct JPromiseImpl : public JavaClass<JPromiseImpl> {
   constexpr static auto kJavaDescriptor = "Lcom/facebook/react/bridge/PromiseImpl;";
 
@@ -54,110 +56,134 @@ local_ref<JCxxCallbackImpl::jhybridobject> extractCallback(std::weak_ptr<Instanc
   }
 }
 
-local_ref<JPromiseImpl::javaobject> extractPromise(std::weak_ptr<Instance>& instance, dynamic_iterator& it, dynamic_iterator& end) {
-  auto resolve = extractCallback(instance, *it++);
-  CHECK(it != end);
-  auto reject = extractCallback(instance, *it++);
-  return JPromiseImpl::create(resolve, reject);
+// Converters for each parameter type.  Primitives are written straight into
+// the jvalue; boxed types, strings, arrays, maps and callbacks may be null.
+
+jvalue convertBoolean(std::weak_ptr<Instance>&, dynamic_iterator& it) {
+  jvalue value;
+  value.z = static_cast<jboolean>((it++)->getBool());
+  return value;
 }
 
-bool isNullable(char type) {
-  switch (type) {
-    case 'Z':
-    case 'I':
-    case 'F':
-    case 'S':
-    case 'A':
-    case 'M':
-    case 'X':
-      return true;
-    default:
-      return false;;
-  }
+jvalue convertInt(std::weak_ptr<Instance>&, dynamic_iterator& it) {
+  jvalue value;
+  value.i = static_cast<jint>((it++)->getInt());
+  return value;
 }
 
-jvalue extract(std::weak_ptr<Instance>& instance, char type, dynamic_iterator& it, dynamic_iterator& end) {
-  CHECK(it != end);
+jvalue convertFloat(std::weak_ptr<Instance>&, dynamic_iterator& it) {
   jvalue value;
-  if (type == 'P') {
-    value.l = extractPromise(instance, it, end).release();
-    return value;
-  }
+  value.f = static_cast<jfloat>(extractDouble(*it++));
+  return value;
+}
 
-  const auto& arg = *it++;
-  if (isNullable(type) && arg.isNull()) {
-    value.l = nullptr;
-    return value;
-  }
+jvalue convertDouble(std::weak_ptr<Instance>&, dynamic_iterator& it) {
+  jvalue value;
+  value.d = extractDouble(*it++);
+  return value;
+}
 
-  switch (type) {
-    case 'z':
-      value.z = static_cast<jboolean>(arg.getBool());
-      break;
-    case 'Z':
-      value.l = JBoolean::valueOf(static_cast<jboolean>(arg.getBool())).release();
-      break;
-    case 'i':
-      value.i = static_cast<jint>(arg.getInt());
-      break;
-    case 'I':
-      value.l = JInteger::valueOf(static_cast<jint>(arg.getInt())).release();
-      break;
-    case 'f':
-      value.f = static_cast<jfloat>(extractDouble(arg));
-      break;
-    case 'F':
-      value.l = JFloat::valueOf(static_cast<jfloat>(extractDouble(arg))).release();
-      break;
-    case 'd':
-      value.d = extractDouble(arg);
-      break;
-    case 'D':
-      value.l = JDouble::valueOf(extractDouble(arg)).release();
-      break;
-    case 'S':
-      value.l = make_jstring(arg.getString().c_str()).release();
-      break;
-    case 'A':
-      value.l = ReadableNativeArray::newObjectCxxArgs(arg).release();
-      break;
-    case 'M':
-      value.l = ReadableNativeMap::newObjectCxxArgs(arg).release();
-      break;
-    case 'X':
-      value.l = extractCallback(instance, arg).release();
-      break;
-    default:
-      LOG(FATAL) << "Unknown param type: " << type;
-  }
+template <jobject (*Convert)(std::weak_ptr<Instance>&, const folly::dynamic&)>
+jvalue convertNullable(std::weak_ptr<Instance>& instance, dynamic_iterator& it) {
+  const auto& arg = *it++;
+  jvalue value;
+  value.l = arg.isNull() ? nullptr : Convert(instance, arg);
   return value;
 }
 
-std::size_t countJsArgs(const std::string& signature) {
-  std::size_t count = 0;
-  for (char c : signature) {
-    switch (c) {
-      case 'P':
-        count += 2;
-        break;
-      default:
-        count += 1;
-        break;
-    }
-  }
-  return count;
+jobject boxBoolean(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return JBoolean::valueOf(static_cast<jboolean>(arg.getBool())).release();
+}
+
+jobject boxInt(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return JInteger::valueOf(static_cast<jint>(arg.getInt())).release();
+}
+
+jobject boxFloat(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return JFloat::valueOf(static_cast<jfloat>(extractDouble(arg))).release();
+}
+
+jobject boxDouble(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return JDouble::valueOf(extractDouble(arg)).release();
+}
+
+jobject makeString(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return make_jstring(arg.getString().c_str()).release();
+}
+
+jobject makeArray(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return ReadableNativeArray::newObjectCxxArgs(arg).release();
+}
+
+jobject makeMap(std::weak_ptr<Instance>&, const folly::dynamic& arg) {
+  return ReadableNativeMap::newObjectCxxArgs(arg).release();
+}
+
+jobject wrapCallback(std::weak_ptr<Instance>& instance, const folly::dynamic& arg) {
+  return extractCallback(instance, arg).release();
+}
+
+jvalue convertPromise(std::weak_ptr<Instance>& instance, dynamic_iterator& it) {
+  auto resolve = extractCallback(instance, *it++);
+  auto reject = extractCallback(instance, *it++);
+  jvalue value;
+  value.l = JPromiseImpl::create(resolve, reject).release();
+  return value;
 }
 
 }
 
 MethodInvoker::MethodInvoker(alias_ref<JReflectMethod::javaobject> method, std::string signature, std::string traceName, bool isSync)
  : method_(method->getMethodID()),
- signature_(signature),
- jsArgCount_(countJsArgs(signature) -2),
  traceName_(std::move(traceName)),
  isSync_(isSync) {
-     CHECK(signature_.at(1) == '.') << "Improper module method signature";
-     CHECK(isSync_ || signature_.at(0) == 'v') << "Non-sync hooks cannot have a non-void return type";
+  auto parsed = parseJavaMethodSignature(signature, isSync);
+  returnType_ = parsed.returnType;
+  jsArgCount_ = parsed.jsArgCount;
+  argConverters_.reserve(parsed.params.size());
+  for (auto type : parsed.params) {
+    switch (type) {
+      case JavaParamType::Boolean:
+        argConverters_.push_back(convertBoolean);
+        break;
+      case JavaParamType::BoxedBoolean:
+        argConverters_.push_back(convertNullable<boxBoolean>);
+        break;
+      case JavaParamType::Int:
+        argConverters_.push_back(convertInt);
+        break;
+      case JavaParamType::BoxedInt:
+        argConverters_.push_back(convertNullable<boxInt>);
+        break;
+      case JavaParamType::Float:
+        argConverters_.push_back(convertFloat);
+        break;
+      case JavaParamType::BoxedFloat:
+        argConverters_.push_back(convertNullable<boxFloat>);
+        break;
+      case JavaParamType::Double:
+        argConverters_.push_back(convertDouble);
+        break;
+      case JavaParamType::BoxedDouble:
+        argConverters_.push_back(convertNullable<boxDouble>);
+        break;
+      case JavaParamType::String:
+        argConverters_.push_back(convertNullable<makeString>);
+        break;
+      case JavaParamType::Array:
+        argConverters_.push_back(convertNullable<makeArray>);
+        break;
+      case JavaParamType::Map:
+        argConverters_.push_back(convertNullable<makeMap>);
+        break;
+      case JavaParamType::Callback:
+        argConverters_.push_back(convertNullable<wrapCallback>);
+        break;
+      case JavaParamType::Promise:
+        argConverters_.push_back(convertPromise);
+        break;
+    }
+  }
 }
 
 MethodCallResult MethodInvoker::invoke(std::weak_ptr<Instance>& instance, alias_ref<JBaseJavaModule::javaobject> module, const folly::dynamic& params) {
@@ -174,16 +200,20 @@ MethodCallResult MethodInvoker::invoke(std::weak_ptr<Instance>& instance, alias_
   }
 
   auto env = Environment::current();
-  auto argCount = signature_.size() - 2;
+  auto argCount = argConverters_.size();
   JniLocalScope scope(env, argCount);
-  jvalue args[argCount];
-  std::transform(
-    signature_.begin() + 2,
-    signature_.end(),
-    args,
-    [&instance, it = params.begin(), end = params.end()] (char type) mutable {
-      return extract(instance, type, it, end);
-  });
+  // Most methods take a handful of arguments, which fit on the stack.
+  jvalue inlineArgs[kInlineArgs];
+  std::unique_ptr<jvalue[]> heapArgs;
+  jvalue* args = inlineArgs;
+  if (argCount > kInlineArgs) {
+    heapArgs.reset(new jvalue[argCount]);
+    args = heapArgs.get();
+  }
+  auto it = params.begin();
+  for (size_t i = 0; i < argCount; i++) {
+    args[i] = argConverters_[i](instance, it);
+  }
 
 #define PRIMITIVE_CASE(METHOD) {                                             \
   auto result = env->Call ## METHOD ## MethodA(module.get(), method_, args); \
@@ -211,8 +241,7 @@ MethodCallResult MethodInvoker::invoke(std::weak_ptr<Instance>& instance, alias_
   return folly::dynamic(static_cast<RESULT_TYPE>(result->ACTIONS()));     \
 }
 
-  char returnType = signature_.at(0);
-  switch (returnType) {
+  switch (returnType_) {
     case 'v':
       env->CallVoidMethodA(module.get(), method_, args);
       throwPendingJniExceptionAsCppException();
@@ -243,7 +272,7 @@ MethodCallResult MethodInvoker::invoke(std::weak_ptr<Instance>& instance, alias_
       OBJECT_CASE(WritableNativeArray, cthis()->consume)
 
     default:
-      LOG(FATAL) << "Unknown return type: " << returnType;
+      LOG(FATAL) << "Unknown return type: " << returnType_;
       return folly::none;
   }
 }
@@ -8,6 +8,8 @@
 #include <fb/fbjni.h>
 #include <folly/dynamic.h>
 
+#include "JavaMethodSignature.h"
+
 namespace facebook {
 namespace react {
 
@@ -37,8 +39,14 @@ public:
     return isSync_;
   }
 private:
+  // Converts the JS arguments for one parameter, advancing the iterator past
+  // them.
+  using ArgConverter = jvalue (*)(std::weak_ptr<Instance>& instance, folly::dynamic::const_iterator& it);
+
   jmethodID method_;
-  std::string signature_;
+  char returnType_;
+  // One per parameter, chosen from the signature at construction.
+  std::vector<ArgConverter> argConverters_;
   std::size_t jsArgCount_;
   std::string traceName_;
   bool isSync_;
@@ -2,6 +2,8 @@
 
 #include "NativeCommon.h"
 
+#include <cxxreact/FlatDynamic.h>
+
 using namespace facebook::jni;
 
 namespace facebook {
@@ -55,5 +57,29 @@ local_ref<ReadableType> ReadableType::getType(folly::dynamic::Type type) {
   }
 }
 
+local_ref<JArrayClass<jobject>::javaobject> exportFlatDynamic(const folly::dynamic& value) {
+  FlatDynamic flat;
+  try {
+    flat = flattenDynamic(value);
+  } catch (const std::invalid_argument& ex) {
+    throwNewJavaException(exceptions::gUnexpectedNativeTypeExceptionClass, ex.what());
+  }
+
+  auto ops = JArrayInt::newArray(flat.ops.size());
+  ops->setRegion(0, flat.ops.size(), flat.ops.data());
+  auto numbers = JArrayDouble::newArray(flat.numbers.size());
+  numbers->setRegion(0, flat.numbers.size(), flat.numbers.data());
+  auto strings = JArrayClass<jstring>::newArray(flat.strings.size());
+  for (size_t i = 0; i < flat.strings.size(); i++) {
+    strings->setElement(i, make_jstring(flat.strings[i]).get());
+  }
+
+  auto contents = JArrayClass<jobject>::newArray(3);
+  contents->setElement(0, ops.get());
+  contents->setElement(1, numbers.get());
+  contents->setElement(2, strings.get());
+  return contents;
+}
+
 } // namespace react
 } // namespace facebook
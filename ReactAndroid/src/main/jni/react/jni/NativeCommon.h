@@ -18,6 +18,11 @@ struct ReadableType : public jni::JavaClass<ReadableType> {
   static jni::local_ref<ReadableType> getType(folly::dynamic::Type type);
 };
 
+// Flattens the value with flattenDynamic into an Object[] of {int[] ops,
+// double[] numbers, String[] strings}, which FlatDynamicReader.java reads
+// without calling back into native.
+jni::local_ref<jni::JArrayClass<jobject>::javaobject> exportFlatDynamic(const folly::dynamic& value);
+
 namespace exceptions {
 
 extern const char *gUnexpectedNativeTypeExceptionClass;
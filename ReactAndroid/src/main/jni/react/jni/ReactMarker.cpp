@@ -51,6 +51,12 @@ void JReactMarker::logPerfMarker(const ReactMarker::ReactMarkerId markerId, cons
     case ReactMarker::NATIVE_MODULE_SETUP_STOP:
       JReactMarker::logMarker("NATIVE_MODULE_SETUP_END", tag);
       break;
+    case ReactMarker::JS_CODE_CACHE_HIT:
+      JReactMarker::logMarker("JS_CODE_CACHE_HIT", tag);
+      break;
+    case ReactMarker::JS_CODE_CACHE_MISS:
+      JReactMarker::logMarker("JS_CODE_CACHE_MISS", tag);
+      break;
     case ReactMarker::NATIVE_REQUIRE_START:
     case ReactMarker::NATIVE_REQUIRE_STOP:
       // These are not used on Android.
@@ -74,6 +74,10 @@ local_ref<NativeMap::jhybridobject> ReadableNativeArray::getMap(jint index) {
   return ReadableNativeMap::createWithContents(folly::dynamic(elem));
 }
 
+local_ref<JArrayClass<jobject>::javaobject> ReadableNativeArray::exportContents() {
+  return exportFlatDynamic(array_);
+}
+
 namespace {
 // This is just to allow signature deduction below.
 local_ref<ReadableNativeMap::jhybridobject> getMapFixed(alias_ref<ReadableNativeArray::jhybridobject> array, jint index) {
@@ -92,6 +96,7 @@ void ReadableNativeArray::registerNatives() {
     makeNativeMethod("getArray", ReadableNativeArray::getArray),
     makeNativeMethod("getMap", getMapFixed),
     makeNativeMethod("getType", ReadableNativeArray::getType),
+    makeNativeMethod("exportContents", ReadableNativeArray::exportContents),
   });
 }
 
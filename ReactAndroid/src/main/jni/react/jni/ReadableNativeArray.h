@@ -33,6 +33,7 @@ class ReadableNativeArray : public jni::HybridClass<ReadableNativeArray, NativeA
   // limitations of fbjni, we can't specify that here.
   jni::local_ref<NativeMap::jhybridobject> getMap(jint index);
   jni::local_ref<ReadableType> getType(jint index);
+  jni::local_ref<jni::JArrayClass<jobject>::javaobject> exportContents();
 
   static void registerNatives();
 };
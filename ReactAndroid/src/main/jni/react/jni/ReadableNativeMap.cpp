@@ -84,6 +84,10 @@ local_ref<ReadableType> ReadableNativeMap::getValueType(const std::string& key)
   return ReadableType::getType(getMapValue(key).type());
 }
 
+local_ref<JArrayClass<jobject>::javaobject> ReadableNativeMap::exportContents() {
+  return exportFlatDynamic(map_);
+}
+
 local_ref<ReadableNativeMap::jhybridobject> ReadableNativeMap::createWithContents(folly::dynamic&& map) {
   if (map.isNull()) {
     return local_ref<jhybridobject>(nullptr);
@@ -108,6 +112,7 @@ void ReadableNativeMap::registerNatives() {
       makeNativeMethod("getArray", ReadableNativeMap::getArrayKey),
       makeNativeMethod("getMap", ReadableNativeMap::getMapKey),
       makeNativeMethod("getType", ReadableNativeMap::getValueType),
+      makeNativeMethod("exportContents", ReadableNativeMap::exportContents),
   });
 }
 
@@ -28,6 +28,7 @@ struct ReadableNativeMap : jni::HybridClass<ReadableNativeMap, NativeMap> {
   jni::local_ref<ReadableNativeArray::jhybridobject> getArrayKey(const std::string& key);
   jni::local_ref<jhybridobject> getMapKey(const std::string& key);
   jni::local_ref<ReadableType> getValueType(const std::string& key);
+  jni::local_ref<jni::JArrayClass<jobject>::javaobject> exportContents();
   static jni::local_ref<jhybridobject> createWithContents(folly::dynamic&& map);
 
   static void mapException(const std::exception& ex);
@@ -0,0 +1,46 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <react/jni/JavaMethodSignature.h>
+
+#include <gtest/gtest.h>
+
+using namespace facebook::react;
+
+TEST(JavaMethodSignatureTest, ParsesParams) {
+  auto signature = parseJavaMethodSignature("v.zZiIfFdDSAMXP", false);
+  EXPECT_EQ(signature.returnType, 'v');
+  EXPECT_EQ(signature.params, (std::vector<JavaParamType>{
+    JavaParamType::Boolean,
+    JavaParamType::BoxedBoolean,
+    JavaParamType::Int,
+    JavaParamType::BoxedInt,
+    JavaParamType::Float,
+    JavaParamType::BoxedFloat,
+    JavaParamType::Double,
+    JavaParamType::BoxedDouble,
+    JavaParamType::String,
+    JavaParamType::Array,
+    JavaParamType::Map,
+    JavaParamType::Callback,
+    JavaParamType::Promise,
+  }));
+  // The promise takes two.
+  EXPECT_EQ(signature.jsArgCount, 14);
+}
+
+TEST(JavaMethodSignatureTest, NoParams) {
+  auto signature = parseJavaMethodSignature("M.", true);
+  EXPECT_EQ(signature.returnType, 'M');
+  EXPECT_TRUE(signature.params.empty());
+  EXPECT_EQ(signature.jsArgCount, 0);
+}
+
+TEST(JavaMethodSignatureTest, RejectsBadSignatures) {
+  EXPECT_THROW(parseJavaMethodSignature("", false), std::invalid_argument);
+  EXPECT_THROW(parseJavaMethodSignature("vi", false), std::invalid_argument);
+  EXPECT_THROW(parseJavaMethodSignature("v.iY", false), std::invalid_argument);
+  EXPECT_THROW(parseJavaMethodSignature("q.i", true), std::invalid_argument);
+  // Only sync hooks return values.
+  EXPECT_THROW(parseJavaMethodSignature("i.i", false), std::invalid_argument);
+  EXPECT_NO_THROW(parseJavaMethodSignature("i.i", true));
+}
@@ -5,10 +5,14 @@ include $(CLEAR_VARS)
 LOCAL_MODULE := reactnative
 
 LOCAL_SRC_FILES := \
+  BridgeAllocations.cpp \
   CxxNativeModule.cpp \
+  FlatDynamic.cpp \
   Instance.cpp \
+  JSAssetModulesUnbundle.cpp \
   JSBigString.cpp \
   JSBundleType.cpp \
+  JSCodeCache.cpp \
   JSCExecutor.cpp \
   JSCLegacyTracing.cpp \
   JSCMemory.cpp \
@@ -20,9 +24,12 @@ LOCAL_SRC_FILES := \
   JSIndexedRAMBundle.cpp \
   MethodCall.cpp \
   ModuleRegistry.cpp \
+  NativeCallScheduler.cpp \
   NativeToJsBridge.cpp \
   Platform.cpp \
+  RAMBundleProfile.cpp \
 	RAMBundleRegistry.cpp \
+  TraceRecorder.cpp \
 
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/..
 LOCAL_EXPORT_C_INCLUDES := $(LOCAL_C_INCLUDES)
@@ -0,0 +1,85 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "BridgeAllocations.h"
+
+#include <pthread.h>
+
+#include <glog/logging.h>
+
+namespace facebook {
+namespace react {
+
+std::atomic<bool> BridgeAllocations::s_enabled {false};
+
+namespace {
+
+constexpr size_t kNumOperations = static_cast<size_t>(BridgeOperation::InvokeNativeMethod) + 1;
+
+struct Counters {
+  std::atomic<uint64_t> operations {0};
+  std::atomic<uint64_t> allocations {0};
+  std::atomic<uint64_t> bytes {0};
+};
+
+Counters counters[kNumOperations];
+
+// Holds the innermost scope's operation + 1, so that no scope is nullptr,
+// rather than a pointer to the scope: nothing here may allocate.
+pthread_key_t currentOperationKey() {
+  static pthread_key_t key = [] {
+    pthread_key_t k;
+    CHECK_EQ(0, pthread_key_create(&k, nullptr));
+    return k;
+  }();
+  return key;
+}
+
+}
+
+void BridgeAllocations::Scope::enter(BridgeOperation operation) {
+  auto index = static_cast<size_t>(operation);
+  m_previous = pthread_getspecific(currentOperationKey());
+  pthread_setspecific(currentOperationKey(), reinterpret_cast<void*>(index + 1));
+  counters[index].operations.fetch_add(1, std::memory_order_relaxed);
+  m_entered = true;
+}
+
+void BridgeAllocations::Scope::exit() {
+  pthread_setspecific(currentOperationKey(), m_previous);
+}
+
+void BridgeAllocations::setEnabled(bool enabled) {
+  // Creates the key now rather than from inside operator new.
+  currentOperationKey();
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void BridgeAllocations::recordAllocationSlow(size_t bytes) {
+  auto current = reinterpret_cast<uintptr_t>(pthread_getspecific(currentOperationKey()));
+  if (current == 0) {
+    return;
+  }
+  auto& operationCounters = counters[current - 1];
+  operationCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+  operationCounters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+BridgeAllocationStats BridgeAllocations::stats(BridgeOperation operation) {
+  auto& operationCounters = counters[static_cast<size_t>(operation)];
+  return {
+    operationCounters.operations.load(std::memory_order_relaxed),
+    operationCounters.allocations.load(std::memory_order_relaxed),
+    operationCounters.bytes.load(std::memory_order_relaxed),
+  };
+}
+
+void BridgeAllocations::reset() {
+  for (auto& operationCounters : counters) {
+    operationCounters.operations.store(0, std::memory_order_relaxed);
+    operationCounters.allocations.store(0, std::memory_order_relaxed);
+    operationCounters.bytes.store(0, std::memory_order_relaxed);
+  }
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,95 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <jschelpers/noncopyable.h>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+enum class BridgeOperation : uint8_t {
+  CallFunction,
+  CallNativeModules,
+  InvokeNativeMethod,
+};
+
+struct BridgeAllocationStats {
+  uint64_t operations;
+  uint64_t allocations;
+  uint64_t bytes;
+};
+
+/**
+ * BridgeAllocations
+ *
+ * Counts the heap allocations made by each kind of bridge operation.  The
+ * bridge opens a Scope around each operation; allocations made on the same
+ * thread while it is open are charged to it.  Scopes nest, and only the
+ * innermost one is charged, so the counts of different operations add up.
+ *
+ * C++ offers no portable way to observe allocations, so the process has to
+ * report them, typically from a replacement of the global operator new:
+ *
+ *   void* operator new(size_t size) {
+ *     BridgeAllocations::recordAllocation(size);
+ *     ...
+ *   }
+ *
+ * Counting is off until setEnabled(true).  While off, scopes and
+ * recordAllocation cost a single relaxed load.
+ */
+class RN_EXPORT BridgeAllocations {
+public:
+  class RN_EXPORT Scope : noncopyable {
+  public:
+    explicit Scope(BridgeOperation operation) {
+      if (BridgeAllocations::isEnabled()) {
+        enter(operation);
+      }
+    }
+
+    ~Scope() {
+      if (m_entered) {
+        exit();
+      }
+    }
+
+  private:
+    void enter(BridgeOperation operation);
+    void exit();
+
+    bool m_entered = false;
+    void* m_previous = nullptr;
+  };
+
+  static bool isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+  static void setEnabled(bool enabled);
+
+  // Doesn't allocate, so it's safe to call from operator new.
+  static void recordAllocation(size_t bytes) {
+    if (isEnabled()) {
+      recordAllocationSlow(bytes);
+    }
+  }
+
+  static BridgeAllocationStats stats(BridgeOperation operation);
+  static void reset();
+
+private:
+  static void recordAllocationSlow(size_t bytes);
+
+  static std::atomic<bool> s_enabled;
+};
+
+} // namespace react
+} // namespace facebook
@@ -9,6 +9,8 @@
 
 #include <folly/dynamic.h>
 
+#include <cxxreact/JsArgumentDecoders.h>
+
 using namespace std::placeholders;
 
 namespace facebook {
@@ -45,7 +47,10 @@ namespace module {
  *
  * The second set of methods is similar, but instead of taking a
  * function, takes the method name, an object, and a pointer to a
- * method on that object.
+ * method on that object.  Methods whose parameters aren't
+ * folly::dynamic get their arguments converted to the parameter types,
+ * as described in JsArgumentDecoders.h, and export their signature to
+ * JS.
  */
 
 class CxxModule {
@@ -60,6 +65,19 @@ public:
   constexpr static AsyncTagType AsyncTag = AsyncTagType();
   constexpr static SyncTagType SyncTag = SyncTagType();
 
+  /**
+   * How urgently calls of an async method need to run.  When the module's
+   * queue is a NativeCallScheduler, calls to other modules with more urgent
+   * calls pending run first; otherwise this has no effect.  Calls to one
+   * module always run in the order they were made, and the end of their
+   * batch is signalled after all of them.
+   */
+  enum class Priority {
+    UICritical,
+    Normal,
+    Background,
+  };
+
   struct Method {
     std::string name;
 
@@ -68,6 +86,18 @@ public:
 
     std::function<folly::dynamic(folly::dynamic)> syncFunc;
 
+    Priority priority = Priority::Normal;
+
+    // Parameter types, e.g. "(number,string)", for methods with typed
+    // parameters, otherwise empty.
+    std::string signature;
+
+    // Method("logEvent", ...).withPriority(Priority::Background)
+    Method withPriority(Priority apriority) && {
+      priority = apriority;
+      return std::move(*this);
+    }
+
     const char *getType() {
       assert(func || syncFunc);
       return func ? (callbacks == 2 ? "promise" : "async") : "sync";
@@ -125,6 +155,21 @@ public:
       , callbacks(2)
       , func(std::bind(method, t, _1, _2, _3)) {}
 
+    // typed method pointer ctor, e.g. for void (T::*)(int64_t, std::string, Callback)
+
+    template <typename T, typename... Params>
+    Method(std::string aname, T* t, void (T::*method)(Params...))
+      : name(std::move(aname))
+      , callbacks(xplat::detail::TypedMethod<Callback, Params...>::kNumCallbacks)
+      , func([t, method](folly::dynamic args, Callback first, Callback second) {
+          xplat::detail::TypedMethod<Callback, Params...>::call(
+            [t, method](Params... params) {
+              (t->*method)(std::forward<Params>(params)...);
+            },
+            args, first, second);
+        })
+      , signature(xplat::detail::TypedMethod<Callback, Params...>::signature()) {}
+
     // sync std::function/lambda ctors
 
     // Overloads for functions returning void give ambiguity errors.
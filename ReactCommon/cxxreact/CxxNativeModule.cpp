@@ -4,12 +4,15 @@
 #include "Instance.h"
 
 #include <iterator>
+#include <pthread.h>
 #include <glog/logging.h>
 #include <folly/json.h>
 
+#include "BridgeAllocations.h"
 #include "JsArgumentHelpers.h"
 #include "SystraceSection.h"
 #include "MessageQueueThread.h"
+#include "NativeCallScheduler.h"
 
 using facebook::xplat::module::CxxModule;
 namespace facebook {
@@ -31,6 +34,16 @@ std::function<void(folly::dynamic)> makeCallback(
 
 namespace {
 
+// A pthread key rather than thread_local, which isn't available on iOS 8.
+pthread_key_t callingInstanceKey() {
+  static pthread_key_t key = [] {
+    pthread_key_t k;
+    CHECK_EQ(0, pthread_key_create(&k, nullptr));
+    return k;
+  }();
+  return key;
+}
+
 /**
  * CxxModule::Callback accepts a vector<dynamic>, makeCallback returns
  * a callback that accepts a dynamic, adapt the second into the first.
@@ -47,6 +60,21 @@ CxxModule::Callback convertCallback(
 
 }
 
+CallingInstanceScope::CallingInstanceScope(std::weak_ptr<Instance> instance)
+  : instance_(std::move(instance))
+  , previous_(current()) {
+  pthread_setspecific(callingInstanceKey(), &instance_);
+}
+
+CallingInstanceScope::~CallingInstanceScope() {
+  pthread_setspecific(callingInstanceKey(), previous_);
+}
+
+const std::weak_ptr<Instance>* CallingInstanceScope::current() {
+  return static_cast<const std::weak_ptr<Instance>*>(
+    pthread_getspecific(callingInstanceKey()));
+}
+
 std::string CxxNativeModule::getName() {
   return name_;
 }
@@ -56,7 +84,7 @@ std::vector<MethodDescriptor> CxxNativeModule::getMethods() {
 
   std::vector<MethodDescriptor> descs;
   for (auto& method : methods_) {
-    descs.emplace_back(method.name, method.getType());
+    descs.emplace_back(method.name, method.getType(), method.signature);
   }
   return descs;
 }
@@ -76,6 +104,8 @@ folly::dynamic CxxNativeModule::getConstants() {
 }
 
 void CxxNativeModule::invoke(unsigned int reactMethodId, folly::dynamic&& params, int callId) {
+  BridgeAllocations::Scope allocations(BridgeOperation::InvokeNativeMethod);
+
   if (reactMethodId >= methods_.size()) {
     throw std::invalid_argument(folly::to<std::string>("methodId ", reactMethodId,
         " out of range [0..", methods_.size(), "]"));
@@ -100,11 +130,13 @@ void CxxNativeModule::invoke(unsigned int reactMethodId, folly::dynamic&& params
         " callbacks, but only ", params.size(), " parameters provided"));
   }
 
+  auto callingInstance = CallingInstanceScope::current();
+  const auto& instance = callingInstance ? *callingInstance : instance_;
   if (method.callbacks == 1) {
-    first = convertCallback(makeCallback(instance_, params[params.size() - 1]));
+    first = convertCallback(makeCallback(instance, params[params.size() - 1]));
   } else if (method.callbacks == 2) {
-    first = convertCallback(makeCallback(instance_, params[params.size() - 2]));
-    second = convertCallback(makeCallback(instance_, params[params.size() - 1]));
+    first = convertCallback(makeCallback(instance, params[params.size() - 2]));
+    second = convertCallback(makeCallback(instance, params[params.size() - 1]));
   }
 
   params.resize(params.size() - method.callbacks);
@@ -128,7 +160,7 @@ void CxxNativeModule::invoke(unsigned int reactMethodId, folly::dynamic&& params
   // stack.  I'm told that will be possible in the future.  TODO
   // mhorowitz #7128529: convert C++ exceptions to Java
 
-  messageQueueThread_->runOnQueue([method, params=std::move(params), first, second, callId] () {
+  auto task = [method, params=std::move(params), first, second, callId] () {
   #ifdef WITH_FBSYSTRACE
     if (callId != -1) {
       fbsystrace_end_async_flow(TRACE_TAG_REACT_APPS, "native", callId);
@@ -149,7 +181,13 @@ void CxxNativeModule::invoke(unsigned int reactMethodId, folly::dynamic&& params
       LOG(ERROR) << "Method call " << method.name.c_str() << " failed. unknown error";
       std::terminate();
     }
-  });
+  };
+
+  if (auto scheduler = dynamic_cast<NativeCallScheduler*>(messageQueueThread_.get())) {
+    scheduler->runOnQueue(this, method.priority, std::move(task));
+  } else {
+    messageQueueThread_->runOnQueue(std::move(task));
+  }
 }
 
 MethodCallResult CxxNativeModule::callSerializableNativeHook(unsigned int hookId, folly::dynamic&& args) {
@@ -4,6 +4,7 @@
 
 #include <cxxreact/CxxModule.h>
 #include <cxxreact/NativeModule.h>
+#include <jschelpers/noncopyable.h>
 
 #ifndef RN_EXPORT
 #define RN_EXPORT __attribute__((visibility("default")))
@@ -18,6 +19,25 @@ class MessageQueueThread;
 std::function<void(folly::dynamic)> makeCallback(
   std::weak_ptr<Instance> instance, const folly::dynamic& callbackId);
 
+/**
+ * While alive, callbacks of CxxNativeModule methods invoked on this thread go
+ * to `instance` instead of the instance the module was created for.  This is
+ * what lets several instances, each with its own JS thread, share one
+ * ModuleRegistry.  Scopes nest.
+ */
+class RN_EXPORT CallingInstanceScope : noncopyable {
+public:
+  explicit CallingInstanceScope(std::weak_ptr<Instance> instance);
+  ~CallingInstanceScope();
+
+  // The instance of the innermost scope on this thread, or nullptr.
+  static const std::weak_ptr<Instance>* current();
+
+private:
+  std::weak_ptr<Instance> instance_;
+  const std::weak_ptr<Instance>* previous_;
+};
+
 class RN_EXPORT CxxNativeModule : public NativeModule {
 public:
   CxxNativeModule(std::weak_ptr<Instance> instance,
@@ -0,0 +1,190 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "FlatDynamic.h"
+
+#include <functional>
+#include <unordered_map>
+
+#include <folly/Conv.h>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+static const char *errorPrefix = "Malformed FlatDynamic: ";
+
+// The value being flattened outlives the flattener, so strings are
+// deduplicated by pointing into it rather than by copying them.
+struct StringPtrHash {
+  size_t operator()(const std::string* s) const {
+    return std::hash<std::string>()(*s);
+  }
+};
+
+struct StringPtrEqual {
+  bool operator()(const std::string* a, const std::string* b) const {
+    return *a == *b;
+  }
+};
+
+class Flattener {
+public:
+  explicit Flattener(FlatDynamic& flat) : m_flat(flat) {}
+
+  void flatten(const folly::dynamic& value) {
+    switch (value.type()) {
+      case folly::dynamic::NULLT:
+        m_flat.ops.push_back(FlatDynamic::Null);
+        break;
+      case folly::dynamic::BOOL:
+        m_flat.ops.push_back(value.getBool() ? FlatDynamic::True : FlatDynamic::False);
+        break;
+      case folly::dynamic::INT64:
+        m_flat.ops.push_back(FlatDynamic::Number);
+        m_flat.numbers.push_back(value.getInt());
+        break;
+      case folly::dynamic::DOUBLE:
+        m_flat.ops.push_back(FlatDynamic::Number);
+        m_flat.numbers.push_back(value.getDouble());
+        break;
+      case folly::dynamic::STRING:
+        m_flat.ops.push_back(FlatDynamic::String);
+        m_flat.ops.push_back(stringIndex(value.getString()));
+        break;
+      case folly::dynamic::ARRAY:
+        m_flat.ops.push_back(FlatDynamic::Array);
+        m_flat.ops.push_back(static_cast<int32_t>(value.size()));
+        for (const auto& element : value) {
+          flatten(element);
+        }
+        break;
+      case folly::dynamic::OBJECT:
+        m_flat.ops.push_back(FlatDynamic::Object);
+        m_flat.ops.push_back(static_cast<int32_t>(value.size()));
+        for (const auto& item : value.items()) {
+          if (!item.first.isString()) {
+            throw std::invalid_argument(
+              folly::to<std::string>("Can't flatten a key of type ", item.first.typeName()));
+          }
+          m_flat.ops.push_back(stringIndex(item.first.getString()));
+          flatten(item.second);
+        }
+        break;
+    }
+  }
+
+private:
+  int32_t stringIndex(const std::string& s) {
+    auto inserted = m_stringIndices.emplace(&s, static_cast<int32_t>(m_flat.strings.size()));
+    if (inserted.second) {
+      m_flat.strings.push_back(s);
+    }
+    return inserted.first->second;
+  }
+
+  FlatDynamic& m_flat;
+  std::unordered_map<const std::string*, int32_t, StringPtrHash, StringPtrEqual> m_stringIndices;
+};
+
+class Unflattener {
+public:
+  explicit Unflattener(const FlatDynamic& flat) : m_flat(flat) {}
+
+  folly::dynamic unflatten() {
+    switch (nextOp()) {
+      case FlatDynamic::Null:
+        return nullptr;
+      case FlatDynamic::False:
+        return false;
+      case FlatDynamic::True:
+        return true;
+      case FlatDynamic::Number:
+        if (m_number >= m_flat.numbers.size()) {
+          throw std::invalid_argument(
+            folly::to<std::string>(errorPrefix, "ran out of numbers"));
+        }
+        return m_flat.numbers[m_number++];
+      case FlatDynamic::String:
+        return string();
+      case FlatDynamic::Array: {
+        auto size = count();
+        folly::dynamic array = folly::dynamic::array;
+        array.resize(size);
+        for (size_t i = 0; i < size; i++) {
+          array[i] = unflatten();
+        }
+        return array;
+      }
+      case FlatDynamic::Object: {
+        auto size = count();
+        folly::dynamic object = folly::dynamic::object;
+        for (size_t i = 0; i < size; i++) {
+          auto key = string();
+          object.insert(std::move(key), unflatten());
+        }
+        return object;
+      }
+      default:
+        throw std::invalid_argument(
+          folly::to<std::string>(errorPrefix, "unknown tag ", m_flat.ops[m_op - 1]));
+    }
+  }
+
+  bool done() const {
+    return m_op == m_flat.ops.size() && m_number == m_flat.numbers.size();
+  }
+
+private:
+  int32_t nextOp() {
+    if (m_op >= m_flat.ops.size()) {
+      throw std::invalid_argument(
+        folly::to<std::string>(errorPrefix, "ran out of ops"));
+    }
+    return m_flat.ops[m_op++];
+  }
+
+  size_t count() {
+    auto size = nextOp();
+    // Every element takes at least one op, which bounds the size before
+    // anything is allocated for it.
+    if (size < 0 || static_cast<size_t>(size) > m_flat.ops.size() - m_op) {
+      throw std::invalid_argument(
+        folly::to<std::string>(errorPrefix, "bad size ", size));
+    }
+    return size;
+  }
+
+  folly::dynamic string() {
+    auto index = nextOp();
+    if (index < 0 || static_cast<size_t>(index) >= m_flat.strings.size()) {
+      throw std::invalid_argument(
+        folly::to<std::string>(errorPrefix, "bad string index ", index));
+    }
+    return m_flat.strings[index];
+  }
+
+  const FlatDynamic& m_flat;
+  size_t m_op = 0;
+  size_t m_number = 0;
+};
+
+}
+
+FlatDynamic flattenDynamic(const folly::dynamic& value) throw(std::invalid_argument) {
+  FlatDynamic flat;
+  Flattener(flat).flatten(value);
+  return flat;
+}
+
+folly::dynamic unflattenDynamic(const FlatDynamic& flat) throw(std::invalid_argument) {
+  Unflattener unflattener(flat);
+  auto value = unflattener.unflatten();
+  if (!unflattener.done()) {
+    throw std::invalid_argument(
+      folly::to<std::string>(errorPrefix, "trailing data"));
+  }
+  return value;
+}
+
+} }
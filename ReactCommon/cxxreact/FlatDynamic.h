@@ -0,0 +1,61 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <folly/dynamic.h>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+/**
+ * FlatDynamic
+ *
+ * A folly::dynamic flattened into primitive arrays, so that it can be handed
+ * to Java in one JNI call and read there without calling back into native.
+ *
+ * Values are written depth first into `ops`, each as a tag followed by its
+ * operands:
+ *
+ *   Null, False, True
+ *   Number               the value is the next one in `numbers`
+ *   String index         the value is strings[index]
+ *   Array size           followed by `size` values
+ *   Object size          followed by `size` pairs of a key's index in
+ *                        `strings` and a value
+ *
+ * Equal strings, typically repeated keys, share their entry in `strings`.
+ * The tags are mirrored in FlatDynamicReader.java.
+ */
+struct FlatDynamic {
+  enum Tag : int32_t {
+    Null = 0,
+    False = 1,
+    True = 2,
+    Number = 3,
+    String = 4,
+    Array = 5,
+    Object = 6,
+  };
+
+  std::vector<int32_t> ops;
+  std::vector<double> numbers;
+  std::vector<std::string> strings;
+};
+
+// Throws std::invalid_argument for object keys that aren't strings.
+RN_EXPORT FlatDynamic flattenDynamic(const folly::dynamic& value) throw(std::invalid_argument);
+
+// Rebuilds the value; the inverse of flattenDynamic, except that all numbers
+// come back as doubles.
+RN_EXPORT folly::dynamic unflattenDynamic(const FlatDynamic& flat) throw(std::invalid_argument);
+
+} }
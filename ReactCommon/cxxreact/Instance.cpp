@@ -8,6 +8,7 @@
 #include "MessageQueueThread.h"
 #include "MethodCall.h"
 #include "NativeToJsBridge.h"
+#include "RAMBundleProfile.h"
 #include "RAMBundleRegistry.h"
 #include "RecoverableError.h"
 #include "SystraceSection.h"
@@ -23,12 +24,17 @@
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <system_error>
 
 namespace facebook {
 namespace react {
 
 Instance::~Instance() {
-  if (nativeToJsBridge_) {
+  destroy();
+}
+
+void Instance::destroy() {
+  if (nativeToJsBridge_ && !destroyed_.exchange(true)) {
     nativeToJsBridge_->destroy();
   }
 }
@@ -37,13 +43,14 @@ void Instance::initializeBridge(
     std::unique_ptr<InstanceCallback> callback,
     std::shared_ptr<JSExecutorFactory> jsef,
     std::shared_ptr<MessageQueueThread> jsQueue,
-    std::shared_ptr<ModuleRegistry> moduleRegistry) {
+    std::shared_ptr<ModuleRegistry> moduleRegistry,
+    std::weak_ptr<Instance> self) {
   callback_ = std::move(callback);
   moduleRegistry_ = std::move(moduleRegistry);
 
-  jsQueue->runOnQueueSync([this, &jsef, jsQueue]() mutable {
+  jsQueue->runOnQueueSync([this, &jsef, jsQueue, &self]() mutable {
     nativeToJsBridge_ = folly::make_unique<NativeToJsBridge>(
-        jsef.get(), moduleRegistry_, jsQueue, callback_);
+        jsef.get(), moduleRegistry_, jsQueue, callback_, std::move(self));
 
     std::lock_guard<std::mutex> lock(m_syncMutex);
     m_syncReady = true;
@@ -82,6 +89,10 @@ void Instance::setSourceURL(std::string sourceURL) {
   nativeToJsBridge_->loadApplication(nullptr, nullptr, std::move(sourceURL));
 }
 
+void Instance::setCodeCache(std::shared_ptr<JSCodeCache> codeCache) {
+  nativeToJsBridge_->setCodeCache(std::move(codeCache));
+}
+
 void Instance::loadScriptFromString(std::unique_ptr<const JSBigString> string,
                                     std::string sourceURL,
                                     bool loadSynchronously) {
@@ -112,6 +123,7 @@ void Instance::loadRAMBundleFromFile(const std::string& sourcePath,
     auto bundle = folly::make_unique<JSIndexedRAMBundle>(sourcePath.c_str());
     auto startupScript = bundle->getStartupCode();
     auto registry = RAMBundleRegistry::multipleBundlesRegistry(std::move(bundle), JSIndexedRAMBundle::buildFactory());
+    applyRAMBundleProfile(*registry, sourcePath);
     loadRAMBundle(
       std::move(registry),
       std::move(startupScript),
@@ -119,6 +131,48 @@ void Instance::loadRAMBundleFromFile(const std::string& sourcePath,
       loadSynchronously);
 }
 
+void Instance::setRAMBundleProfilePath(std::string profilePath) {
+  ramBundleProfilePath_ = std::move(profilePath);
+}
+
+void Instance::applyRAMBundleProfile(RAMBundleRegistry& registry,
+                                     const std::string& sourcePath) {
+  if (ramBundleProfilePath_.empty()) {
+    return;
+  }
+
+  auto key = RAMBundleProfileKey::forFile(sourcePath);
+  std::vector<uint32_t> moduleIds;
+  for (const auto& entry : readRAMBundleProfile(ramBundleProfilePath_, key)) {
+    if (entry.bundleId == RAMBundleRegistry::MAIN_BUNDLE_ID) {
+      moduleIds.push_back(entry.moduleId);
+    }
+  }
+  if (moduleIds.empty()) {
+    ramBundleProfileRecorder_ = std::make_shared<RAMBundleProfileRecorder>();
+    ramBundleProfileKey_ = key;
+    registry.setProfileRecorder(ramBundleProfileRecorder_);
+  } else {
+    registry.setPrefetcher(folly::make_unique<RAMBundlePrefetcher>(
+      [sourcePath] {
+        return folly::make_unique<JSIndexedRAMBundle>(sourcePath.c_str());
+      },
+      std::move(moduleIds)));
+  }
+}
+
+void Instance::writeRAMBundleProfile() {
+  if (!ramBundleProfileRecorder_) {
+    return;
+  }
+  try {
+    ramBundleProfileRecorder_->writeToFile(ramBundleProfilePath_,
+                                           ramBundleProfileKey_);
+  } catch (const std::system_error& e) {
+    LOG(WARNING) << e.what();
+  }
+}
+
 void Instance::loadRAMBundle(std::unique_ptr<RAMBundleRegistry> bundleRegistry,
                              std::unique_ptr<const JSBigString> startupScript,
                              std::string startupScriptSourceURL,
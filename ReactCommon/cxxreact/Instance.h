@@ -2,10 +2,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 
 #include <cxxreact/NativeToJsBridge.h>
+#include <cxxreact/RAMBundleProfile.h>
 #include <jschelpers/Value.h>
 
 #ifndef RN_EXPORT
@@ -20,6 +22,7 @@ namespace facebook {
 namespace react {
 
 class JSBigString;
+class JSCodeCache;
 class JSExecutorFactory;
 class MessageQueueThread;
 class ModuleRegistry;
@@ -32,22 +35,55 @@ struct InstanceCallback {
   virtual void decrementPendingJSCalls() {}
 };
 
+/**
+ * One JS context: an executor running on its own JS queue.  Several
+ * instances may share a ModuleRegistry, and with it the native modules and
+ * their queues; callbacks of native calls go back to the instance that made
+ * the call.
+ */
 class RN_EXPORT Instance {
 public:
   ~Instance();
+  // `self` is the shared_ptr owning this instance, which callbacks of native
+  // calls are routed through.  If it is empty, callbacks go to the instance
+  // each native module was created for, which is only right when the
+  // registry isn't shared.
   void initializeBridge(std::unique_ptr<InstanceCallback> callback,
                         std::shared_ptr<JSExecutorFactory> jsef,
                         std::shared_ptr<MessageQueueThread> jsQueue,
-                        std::shared_ptr<ModuleRegistry> moduleRegistry);
+                        std::shared_ptr<ModuleRegistry> moduleRegistry,
+                        std::weak_ptr<Instance> self = {});
+
+  // Synchronously destroys the executor and quits the JS queue; calls made
+  // afterwards are dropped.  Other instances sharing the module registry
+  // keep running.  Called by the destructor if needed; may be called from
+  // any thread, and only the first call has an effect.
+  void destroy();
 
   void setSourceURL(std::string sourceURL);
 
+  // Must be called before the application script is loaded to take effect.
+  void setCodeCache(std::shared_ptr<JSCodeCache> codeCache);
+
   void loadScriptFromString(std::unique_ptr<const JSBigString> string,
                             std::string sourceURL, bool loadSynchronously);
   static bool isIndexedRAMBundle(const char *sourcePath);
   void loadRAMBundleFromFile(const std::string& sourcePath,
                              const std::string& sourceURL,
                              bool loadSynchronously);
+  // RAM bundles loaded from file after this call prefetch their modules in
+  // the order recorded in the profile at `profilePath`.  If there is no
+  // profile for the bundle, or it was recorded for an older version of it,
+  // requires are recorded for writeRAMBundleProfile() instead.
+  void setRAMBundleProfilePath(std::string profilePath);
+  // Sets up `registry`, whose main bundle was read from `sourcePath`, to use
+  // the profile as loadRAMBundleFromFile() does.  For platforms that build
+  // the registry themselves.
+  void applyRAMBundleProfile(RAMBundleRegistry& registry,
+                             const std::string& sourcePath);
+  // Writes the requires recorded so far, if any; call once startup is done.
+  // Failures are logged, as the profile is only an optimisation.
+  void writeRAMBundleProfile();
   void loadRAMBundle(std::unique_ptr<RAMBundleRegistry> bundleRegistry,
                      std::unique_ptr<const JSBigString> startupScript,
                      std::string startupScriptSourceURL, bool loadSynchronously);
@@ -92,6 +128,10 @@ private:
   std::shared_ptr<InstanceCallback> callback_;
   std::unique_ptr<NativeToJsBridge> nativeToJsBridge_;
   std::shared_ptr<ModuleRegistry> moduleRegistry_;
+  std::string ramBundleProfilePath_;
+  std::shared_ptr<RAMBundleProfileRecorder> ramBundleProfileRecorder_;
+  RAMBundleProfileKey ramBundleProfileKey_ {0, 0};
+  std::atomic<bool> destroyed_ {false};
 
   std::mutex m_syncMutex;
   std::condition_variable m_syncCV;
@@ -0,0 +1,76 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JSAssetModulesUnbundle.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits.h>
+
+#include <folly/Memory.h>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// Module code that points into the buffer of a NUL terminated asset.
+class JSBigAssetString : public JSBigString {
+public:
+  explicit JSBigAssetString(std::unique_ptr<JSAssetModulesUnbundle::Asset> asset)
+  : m_asset(std::move(asset)) {}
+
+  bool isAscii() const override {
+    return false;
+  }
+
+  const char* c_str() const override {
+    return m_asset->data();
+  }
+
+  size_t size() const override {
+    return m_asset->size() - 1;
+  }
+
+private:
+  std::unique_ptr<JSAssetModulesUnbundle::Asset> m_asset;
+};
+
+}
+
+JSAssetModulesUnbundle::JSAssetModulesUnbundle(std::string moduleDirectory)
+  : m_moduleDirectory(std::move(moduleDirectory)) {}
+
+std::unique_ptr<const JSBigString> JSAssetModulesUnbundle::codeFromAsset(
+    std::unique_ptr<Asset> asset) {
+  size_t size = asset->size();
+  if (size > 0 && asset->data()[size - 1] == '\0') {
+    return folly::make_unique<JSBigAssetString>(std::move(asset));
+  }
+
+  std::unique_ptr<JSBigBufferString> code(new JSBigBufferString{size});
+  std::memcpy(code->data(), asset->data(), size);
+  return std::move(code);
+}
+
+JSModulesUnbundle::Module JSAssetModulesUnbundle::getModule(uint32_t moduleId) const {
+  // Formatted on the stack: this runs for every require() of a module.
+  char assetName[PATH_MAX];
+  int length = snprintf(
+    assetName, sizeof(assetName), "%s%u.js", m_moduleDirectory.c_str(), moduleId);
+  if (length < 0 || static_cast<size_t>(length) >= sizeof(assetName)) {
+    throw ModuleNotFound("Module path too long: " + m_moduleDirectory);
+  }
+
+  Module module;
+  module.name.assign(assetName + m_moduleDirectory.size());
+
+  auto asset = openAsset(assetName);
+  if (!asset) {
+    throw ModuleNotFound("Module not found: " + module.name);
+  }
+  module.code = codeFromAsset(std::move(asset));
+  return module;
+}
+
+}  // namespace react
+}  // namespace facebook
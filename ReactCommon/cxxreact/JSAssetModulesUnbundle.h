@@ -0,0 +1,57 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <cxxreact/JSBigString.h>
+#include <cxxreact/JSModulesUnbundle.h>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+/**
+ * A RAM bundle whose modules are stored as one asset each, named
+ * `<moduleDirectory><moduleId>.js`. Subclasses provide access to the assets.
+ *
+ * Module code is handed to the JS engine straight from the asset's buffer,
+ * which the returned JSBigString keeps open. That requires the asset to end
+ * with a NUL byte; assets without one are copied once into a terminated
+ * buffer.
+ */
+class RN_EXPORT JSAssetModulesUnbundle : public JSModulesUnbundle {
+public:
+  /**
+   * The contents of one asset. The buffer stays valid for the lifetime of
+   * the object and isn't necessarily NUL terminated.
+   */
+  class Asset {
+  public:
+    virtual ~Asset() {}
+    virtual const char* data() const = 0;
+    virtual size_t size() const = 0;
+  };
+
+  explicit JSAssetModulesUnbundle(std::string moduleDirectory);
+
+  // Throws ModuleNotFound if the module has no asset.
+  Module getModule(uint32_t moduleId) const override;
+
+protected:
+  // Returns nullptr if the asset doesn't exist or can't be read.
+  virtual std::unique_ptr<Asset> openAsset(const char* assetName) const = 0;
+
+private:
+  static std::unique_ptr<const JSBigString> codeFromAsset(std::unique_ptr<Asset> asset);
+
+  std::string m_moduleDirectory;
+};
+
+}  // namespace react
+}  // namespace facebook
@@ -3,6 +3,7 @@
 #include "JSCExecutor.h"
 
 #include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <fcntl.h>
 #include <mutex>
@@ -341,6 +342,7 @@ namespace facebook {
         JSC_JSGlobalContextDisableDebugger(context, globalInspector);
       }
 
+      removeNativeTracingHooks(context);
       JSC_JSGlobalContextRelease(context);
     }
 
@@ -659,7 +661,7 @@ namespace facebook {
     void JSCExecutor::loadModule(uint32_t bundleId, uint32_t moduleId) {
       auto module = m_bundleRegistry->getModule(bundleId, moduleId);
       auto sourceUrl = String::createExpectingAscii(m_context, module.name);
-      auto source = adoptString(std::unique_ptr<JSBigString>(new JSBigStdString(module.code)));
+      auto source = adoptString(std::move(module.code));
       evaluateScript(m_context, source, sourceUrl);
     }
 
@@ -683,7 +685,9 @@ namespace facebook {
       uint32_t bundleId, moduleId;
       std::tie(bundleId, moduleId) = parseNativeRequireParameters(m_context, arguments, argumentCount);
       ReactMarker::logMarker(ReactMarker::NATIVE_REQUIRE_START);
+      auto start = std::chrono::steady_clock::now();
       loadModule(bundleId, moduleId);
+      m_bundleRegistry->recordRequire(bundleId, moduleId, std::chrono::steady_clock::now() - start);
       ReactMarker::logMarker(ReactMarker::NATIVE_REQUIRE_STOP);
       return Value::makeUndefined(m_context);
     }
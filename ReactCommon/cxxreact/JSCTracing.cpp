@@ -8,6 +8,14 @@
 #define USE_JSCTRACING 0
 #endif
 
+// Without fbsystrace, JS sections go to the TraceRecorder, along with the
+// native SystraceSections.
+#ifndef WITH_FBSYSTRACE
+#define USE_TRACE_RECORDER 1
+#else
+#define USE_TRACE_RECORDER 0
+#endif
+
 #if USE_JSCTRACING
 
 #include <algorithm>
@@ -302,11 +310,292 @@ static JSValueRef nativeTraceCounter(
 
 #endif
 
+#if USE_TRACE_RECORDER
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <pthread.h>
+
+#include <cxxreact/TraceRecorder.h>
+#include <glog/logging.h>
+#include <jschelpers/JavaScriptCore.h>
+#include <jschelpers/JSCHelpers.h>
+#include <jschelpers/Unicode.h>
+#include <jschelpers/Value.h>
+
+using namespace facebook::react;
+
+namespace {
+
+// Section names from JS are mostly the same few strings over and over, so
+// each thread keeps the UTF-8 version of the ones it has seen instead of
+// converting them for every event.
+class InternedNames {
+public:
+  // Systrace.js passes string literals, which are the same string on every
+  // call, so most events take a single lookup by pointer.  Those strings are
+  // protected while cached, so that their memory can't be reused for other
+  // strings.
+  const std::string& get(JSContextRef ctx, JSValueRef value) {
+    auto context = JSC_JSContextGetGlobalContext(ctx);
+    if (context != m_context) {
+      forget(m_context);
+      m_context = context;
+    }
+    auto it = m_values.find(value);
+    if (it != m_values.end()) {
+      return it->second;
+    }
+
+    String str = String::adopt(ctx, JSC_JSValueToStringCopy(ctx, value, nullptr));
+    const std::string& name = get(JSC_JSStringGetCharactersPtr(ctx, str), str.length());
+    if (JSC_JSValueGetType(ctx, value) != kJSTypeString) {
+      return name;
+    }
+    if (m_values.size() >= kMaxNames) {
+      unprotectValues();
+    }
+    JSC_JSValueProtect(m_context, value);
+    return m_values.emplace(value, name).first->second;
+  }
+
+  // Must be called before `context` is released, if it was used.
+  void forget(JSGlobalContextRef context) {
+    if (context && context == m_context) {
+      unprotectValues();
+      m_context = nullptr;
+    }
+  }
+
+  static InternedNames& forCurrentThread() {
+    // A pthread key rather than thread_local, which isn't available on iOS 8.
+    static pthread_key_t key = [] {
+      pthread_key_t k;
+      CHECK_EQ(0, pthread_key_create(&k, [](void* names) {
+        delete static_cast<InternedNames*>(names);
+      }));
+      return k;
+    }();
+
+    auto names = static_cast<InternedNames*>(pthread_getspecific(key));
+    if (!names) {
+      names = new InternedNames();
+      pthread_setspecific(key, names);
+    }
+    return *names;
+  }
+
+private:
+  static constexpr size_t kMaxNames = 1024;
+
+  struct Entry {
+    std::vector<JSChar> chars;
+    std::string name;
+  };
+
+  // For names built at runtime, which are new strings every time.
+  const std::string& get(const JSChar* chars, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+      hash = (hash ^ chars[i]) * 1099511628211ull;
+    }
+
+    auto it = m_names.find(hash);
+    if (it != m_names.end() &&
+        it->second.chars.size() == length &&
+        std::equal(chars, chars + length, it->second.chars.begin())) {
+      return it->second.name;
+    }
+
+    // Names built from data, like query names, would otherwise grow the
+    // table for as long as tracing is on.
+    if (m_names.size() >= kMaxNames) {
+      m_names.clear();
+    }
+    auto& entry = m_names[hash];
+    entry.chars.assign(chars, chars + length);
+    entry.name = unicode::utf16toUTF8(chars, length);
+    return entry.name;
+  }
+
+  void unprotectValues() {
+    for (auto& value : m_values) {
+      JSC_JSValueUnprotect(m_context, value.first);
+    }
+    m_values.clear();
+  }
+
+  JSGlobalContextRef m_context = nullptr;
+  std::unordered_map<JSValueRef, std::string> m_values;
+  std::unordered_map<uint64_t, Entry> m_names;
+};
+
+const std::string& internedName(JSContextRef ctx, JSValueRef value) {
+  return InternedNames::forCurrentThread().get(ctx, value);
+}
+
+int64_t int64FromJSValue(JSContextRef ctx, JSValueRef value, JSValueRef* exception) {
+  return static_cast<int64_t>(JSC_JSValueToNumber(ctx, value, exception));
+}
+
+bool checkArgumentCount(
+    JSContextRef ctx,
+    size_t argumentCount,
+    size_t required,
+    const char* error,
+    JSValueRef* exception) {
+  if (argumentCount >= required) {
+    return true;
+  }
+  if (exception) {
+    *exception = Value::makeError(ctx, error);
+  }
+  return false;
+}
+
+JSValueRef nativeTraceBeginSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef* exception) {
+  // arguments[0] is the tag, which the recorder doesn't filter on.
+  if (!TraceRecorder::isEnabled() ||
+      !checkArgumentCount(ctx, argumentCount, 2,
+        "nativeTraceBeginSection: requires at least 2 arguments", exception)) {
+    return Value::makeUndefined(ctx);
+  }
+
+  const std::string& name = internedName(ctx, arguments[1]);
+  if (argumentCount < 4) {
+    TraceRecorder::beginSection(name);
+    return Value::makeUndefined(ctx);
+  }
+
+  // Arguments are rare and mostly unique, so they aren't interned.  The
+  // recorder only keeps a few bytes of them anyway.
+  std::string args[4];
+  size_t count = 0;
+  for (size_t idx = 2; idx + 1 < argumentCount && count < 4; idx += 2) {
+    args[count++] = Value(ctx, arguments[idx]).toString().str();
+    args[count++] = Value(ctx, arguments[idx + 1]).toString().str();
+  }
+  if (count == 2) {
+    TraceRecorder::beginSection(name, {args[0], args[1]});
+  } else {
+    TraceRecorder::beginSection(name, {args[0], args[1], args[2], args[3]});
+  }
+  return Value::makeUndefined(ctx);
+}
+
+JSValueRef nativeTraceEndSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef* exception) {
+  // Not checking isEnabled(): sections begun while recording must end even
+  // if it was turned off since.
+  if (!checkArgumentCount(ctx, argumentCount, 1,
+        "nativeTraceEndSection: requires at least 1 argument", exception)) {
+    return Value::makeUndefined(ctx);
+  }
+
+  TraceRecorder::endSection();
+  return Value::makeUndefined(ctx);
+}
+
+JSValueRef beginOrEndAsync(
+    bool isEnd,
+    JSContextRef ctx,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef* exception) {
+  if (!TraceRecorder::isEnabled() ||
+      !checkArgumentCount(ctx, argumentCount, 3,
+        "beginOrEndAsync: requires at least 3 arguments", exception)) {
+    return Value::makeUndefined(ctx);
+  }
+
+  const std::string& name = internedName(ctx, arguments[1]);
+  int64_t cookie = int64FromJSValue(ctx, arguments[2], exception);
+  if (isEnd) {
+    TraceRecorder::endAsyncSection(name, cookie);
+  } else {
+    TraceRecorder::beginAsyncSection(name, cookie);
+  }
+  return Value::makeUndefined(ctx);
+}
+
+JSValueRef nativeTraceBeginAsyncSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef* exception) {
+  return beginOrEndAsync(false /* isEnd */, ctx, argumentCount, arguments, exception);
+}
+
+JSValueRef nativeTraceEndAsyncSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef* exception) {
+  return beginOrEndAsync(true /* isEnd */, ctx, argumentCount, arguments, exception);
+}
+
+JSValueRef nativeTraceCounter(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef* exception) {
+  if (!TraceRecorder::isEnabled() ||
+      !checkArgumentCount(ctx, argumentCount, 3,
+        "nativeTraceCounter: requires at least 3 arguments", exception)) {
+    return Value::makeUndefined(ctx);
+  }
+
+  const std::string& name = internedName(ctx, arguments[1]);
+  TraceRecorder::counter(name, int64FromJSValue(ctx, arguments[2], exception));
+  return Value::makeUndefined(ctx);
+}
+
+}
+
+#endif
+
 namespace facebook {
 namespace react {
 
 void addNativeTracingHooks(JSGlobalContextRef ctx) {
-#if USE_JSCTRACING
+#if USE_TRACE_RECORDER
+  // Systrace.js only calls the hooks once enabled, which InitializeCore
+  // does when this is set.
+  if (TraceRecorder::isEnabled()) {
+    Object::getGlobalObject(ctx).setProperty(
+      "__RCTProfileIsProfiling", Value::makeBoolean(ctx, true));
+  }
+  // Flows have no equivalent in the recorder; they are drawn as async
+  // sections instead.
+  installGlobalFunction(ctx, "nativeTraceBeginSection", nativeTraceBeginSection);
+  installGlobalFunction(ctx, "nativeTraceEndSection", nativeTraceEndSection);
+  installGlobalFunction(ctx, "nativeTraceBeginAsyncSection", nativeTraceBeginAsyncSection);
+  installGlobalFunction(ctx, "nativeTraceEndAsyncSection", nativeTraceEndAsyncSection);
+  installGlobalFunction(ctx, "nativeTraceBeginAsyncFlow", nativeTraceBeginAsyncSection);
+  installGlobalFunction(ctx, "nativeTraceEndAsyncFlow", nativeTraceEndAsyncSection);
+  installGlobalFunction(ctx, "nativeTraceCounter", nativeTraceCounter);
+#elif USE_JSCTRACING
   installGlobalFunction(ctx, "nativeTraceBeginSection", nativeTraceBeginSection);
   installGlobalFunction(ctx, "nativeTraceEndSection", nativeTraceEndSection);
   installGlobalFunction(ctx, "nativeTraceBeginAsyncSection", nativeTraceBeginAsyncSection);
@@ -317,4 +606,10 @@ void addNativeTracingHooks(JSGlobalContextRef ctx) {
 #endif
 }
 
+void removeNativeTracingHooks(JSGlobalContextRef ctx) {
+#if USE_TRACE_RECORDER
+  InternedNames::forCurrentThread().forget(ctx);
+#endif
+}
+
 } }
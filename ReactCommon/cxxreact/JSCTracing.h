@@ -8,5 +8,7 @@ namespace facebook {
 namespace react {
 
 void addNativeTracingHooks(JSGlobalContextRef ctx);
+// Call on the JS thread before releasing a context that has the hooks.
+void removeNativeTracingHooks(JSGlobalContextRef ctx);
 
 } }
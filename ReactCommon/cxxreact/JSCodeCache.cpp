@@ -0,0 +1,221 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JSCodeCache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <folly/Memory.h>
+#include <folly/ScopeGuard.h>
+#include <glog/logging.h>
+
+#include "JSBigString.h"
+#include "JSExecutor.h"
+#include "Platform.h"
+#include "RecoverableError.h"
+#include "SystraceSection.h"
+#include "oss-compat-util.h"
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+static uint32_t constexpr CodeCacheMagicNumber = 0xFB0CCAC7;
+static uint32_t constexpr CodeCacheFormatVersion = 1;
+
+/**
+ * CodeCacheHeader
+ *
+ * Every cache file starts with this header, followed by `codeSize` bytes of
+ * engine specific code. All fields are little endian.
+ */
+struct __attribute__((packed)) CodeCacheHeader {
+  CodeCacheHeader() {
+    std::memset(this, 0, sizeof(CodeCacheHeader));
+  }
+
+  uint32_t magic;
+  uint32_t formatVersion;
+  uint64_t scriptHash;
+  uint64_t engineVersionHash;
+  uint64_t codeSize;
+};
+
+// FNV-1a; the cache only has to tell bundles apart, not resist attacks.
+uint64_t hashBytes(const char* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+bool writeFully(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+// basename_r isn't in all iOS SDKs, so use this simple version instead.
+std::string simpleBasename(const std::string &path) {
+  size_t pos = path.rfind("/");
+  return (pos != std::string::npos) ? path.substr(pos + 1) : path;
+}
+
+}
+
+JSCodeCache::JSCodeCache(std::string cacheDir)
+  : m_cacheDir(std::move(cacheDir)) {}
+
+uint64_t JSCodeCache::hashScript(const JSBigString& script) {
+  return hashBytes(script.c_str(), script.size());
+}
+
+std::string JSCodeCache::pathForSourceURL(const std::string& sourceURL) const {
+  // One entry per bundle name, so that updating a bundle replaces its entry
+  // instead of accumulating stale ones.
+  return toString(m_cacheDir, "/", simpleBasename(sourceURL), ".codecache");
+}
+
+std::unique_ptr<const JSBigString> JSCodeCache::load(
+    const std::string& sourceURL,
+    uint64_t scriptHash,
+    const std::string& engineVersion,
+    LoadStatus& status) {
+  status = LoadStatus::Miss;
+
+  std::string path = pathForSourceURL(sourceURL);
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  SCOPE_EXIT { ::close(fd); };
+
+  struct stat fileInfo;
+  CodeCacheHeader header;
+  if (::fstat(fd, &fileInfo) != 0 ||
+      static_cast<size_t>(fileInfo.st_size) < sizeof(header) ||
+      ::read(fd, &header, sizeof(header)) != sizeof(header) ||
+      littleEndianToHost(header.magic) != CodeCacheMagicNumber) {
+    LOG(WARNING) << "Ignoring malformed code cache " << path;
+    remove(sourceURL);
+    return nullptr;
+  }
+
+  if (littleEndianToHost(header.scriptHash) != scriptHash) {
+    // The bundle changed; the entry is replaced once the new one is evaluated.
+    return nullptr;
+  }
+
+  uint64_t codeSize = littleEndianToHost(header.codeSize);
+  if (littleEndianToHost(header.formatVersion) != CodeCacheFormatVersion ||
+      littleEndianToHost(header.engineVersionHash) !=
+        hashBytes(engineVersion.c_str(), engineVersion.size()) ||
+      codeSize != fileInfo.st_size - sizeof(header)) {
+    status = LoadStatus::VersionMismatch;
+    remove(sourceURL);
+    return nullptr;
+  }
+
+  status = LoadStatus::Hit;
+  return folly::make_unique<const JSBigFileString>(fd, codeSize, sizeof(header));
+}
+
+void JSCodeCache::store(
+    const std::string& sourceURL,
+    uint64_t scriptHash,
+    const std::string& engineVersion,
+    const JSBigString& code) {
+  SystraceSection s("JSCodeCache::store", "sourceURL", sourceURL);
+
+  CodeCacheHeader header;
+  header.magic = littleEndianToHost(CodeCacheMagicNumber);
+  header.formatVersion = littleEndianToHost(CodeCacheFormatVersion);
+  header.scriptHash = littleEndianToHost(scriptHash);
+  header.engineVersionHash = littleEndianToHost(
+    hashBytes(engineVersion.c_str(), engineVersion.size()));
+  header.codeSize = littleEndianToHost(static_cast<uint64_t>(code.size()));
+
+  // Write to a temporary file and rename it over the entry, so a crash can
+  // never leave a truncated entry behind.
+  std::string path = pathForSourceURL(sourceURL);
+  std::string tmpPath = path + ".tmp";
+  int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not create code cache " << tmpPath << ": "
+                 << std::strerror(errno);
+    return;
+  }
+
+  bool ok =
+    writeFully(fd, reinterpret_cast<const char*>(&header), sizeof(header)) &&
+    writeFully(fd, code.c_str(), code.size());
+  ok = (::close(fd) == 0) && ok;
+  if (!ok || ::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Could not write code cache " << path << ": "
+                 << std::strerror(errno);
+    ::unlink(tmpPath.c_str());
+  }
+}
+
+void JSCodeCache::remove(const std::string& sourceURL) {
+  ::unlink(pathForSourceURL(sourceURL).c_str());
+}
+
+void JSCodeCache::loadApplicationScript(
+    JSExecutor& executor,
+    std::unique_ptr<const JSBigString> script,
+    std::string sourceURL) {
+  std::string engineVersion = executor.getCodeCacheVersion();
+  if (engineVersion.empty() || !script) {
+    executor.loadApplicationScript(std::move(script), std::move(sourceURL));
+    return;
+  }
+
+  SystraceSection s("JSCodeCache::loadApplicationScript",
+                    "sourceURL", sourceURL);
+  std::string scriptName = simpleBasename(sourceURL);
+  uint64_t scriptHash = hashScript(*script);
+
+  LoadStatus status;
+  auto code = load(sourceURL, scriptHash, engineVersion, status);
+  if (code) {
+    try {
+      executor.loadApplicationCodeCache(std::move(code), sourceURL);
+      ReactMarker::logTaggedMarker(ReactMarker::JS_CODE_CACHE_HIT, scriptName.c_str());
+      return;
+    } catch (const RecoverableError& e) {
+      // The engine rejected the code before evaluating any of it, e.g.
+      // because its bytecode format changed without a version bump.
+      LOG(WARNING) << "Discarding code cache for " << sourceURL << ": " << e.what();
+      remove(sourceURL);
+    }
+  } else if (status == LoadStatus::VersionMismatch) {
+    LOG(INFO) << "Code cache for " << sourceURL << " was built by another engine version";
+  }
+
+  ReactMarker::logTaggedMarker(ReactMarker::JS_CODE_CACHE_MISS, scriptName.c_str());
+  executor.loadApplicationScript(std::move(script), sourceURL);
+
+  if (auto newCode = executor.getCodeCache()) {
+    store(sourceURL, scriptHash, engineVersion, *newCode);
+  }
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,84 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <jschelpers/noncopyable.h>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+class JSBigString;
+class JSExecutor;
+
+/**
+ * JSCodeCache
+ *
+ * Persists the precompiled form of an application script, as produced by
+ * JSExecutor::getCodeCache(), in a directory on disk. Entries are keyed by
+ * the script's source URL and validated against a hash of the script
+ * contents and the engine's code cache version, so a new bundle or a new
+ * engine silently falls back to evaluating the source text.
+ *
+ * Executors opt in by returning a non-empty string from
+ * JSExecutor::getCodeCacheVersion(). All methods must be called on the JS
+ * thread.
+ */
+class RN_EXPORT JSCodeCache : noncopyable {
+public:
+  enum class LoadStatus {
+    Hit,
+    Miss,
+    VersionMismatch,
+  };
+
+  explicit JSCodeCache(std::string cacheDir);
+
+  /**
+   * Loads `script` into `executor`, evaluating the cached code if there is a
+   * valid entry for it, and populating the cache otherwise.
+   */
+  void loadApplicationScript(
+    JSExecutor& executor,
+    std::unique_ptr<const JSBigString> script,
+    std::string sourceURL);
+
+  /**
+   * Returns the cached code for the given key, or nullptr. `status` reports
+   * why nothing was returned; stale entries are deleted.
+   */
+  std::unique_ptr<const JSBigString> load(
+    const std::string& sourceURL,
+    uint64_t scriptHash,
+    const std::string& engineVersion,
+    LoadStatus& status);
+
+  /**
+   * Atomically replaces the entry for `sourceURL`. Failures are logged and
+   * otherwise ignored, as the cache is only an optimisation.
+   */
+  void store(
+    const std::string& sourceURL,
+    uint64_t scriptHash,
+    const std::string& engineVersion,
+    const JSBigString& code);
+
+  void remove(const std::string& sourceURL);
+
+  static uint64_t hashScript(const JSBigString& script);
+
+private:
+  std::string pathForSourceURL(const std::string& sourceURL) const;
+
+  std::string m_cacheDir;
+};
+
+} // namespace react
+} // namespace facebook
@@ -5,13 +5,14 @@
 #include <memory>
 #include <string>
 
+#include <cxxreact/JSBigString.h>
 #include <cxxreact/NativeModule.h>
+#include <cxxreact/RecoverableError.h>
 #include <folly/dynamic.h>
 
 namespace facebook {
 namespace react {
 
-class JSBigString;
 class JSExecutor;
 class JSModulesUnbundle;
 class MessageQueueThread;
@@ -97,6 +98,34 @@ public:
 
   virtual void handleMemoryPressure(int pressureLevel) {}
 
+  /**
+   * Code cache support, see JSCodeCache.  Executors whose engine can
+   * serialize compiled scripts return a non-empty string identifying the
+   * engine and its code format; changing it invalidates existing caches.
+   */
+  virtual std::string getCodeCacheVersion() {
+    return "";
+  }
+
+  /**
+   * Returns the compiled form of the script most recently passed to
+   * loadApplicationScript(), or nullptr if none is available.
+   */
+  virtual std::unique_ptr<const JSBigString> getCodeCache() {
+    return nullptr;
+  }
+
+  /**
+   * Execute an application script from the compiled form previously
+   * returned by getCodeCache().  Throws RecoverableError, before evaluating
+   * anything, if the engine can't use the code; the caller then falls back
+   * to loadApplicationScript().
+   */
+  virtual void loadApplicationCodeCache(std::unique_ptr<const JSBigString> codeCache,
+                                        std::string sourceURL) {
+    throw RecoverableError("Code cache is not supported by " + getDescription());
+  }
+
   virtual void destroy() {}
   virtual ~JSExecutor() {}
 };
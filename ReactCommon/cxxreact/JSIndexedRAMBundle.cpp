@@ -59,7 +59,7 @@ std::unique_ptr<const JSBigString> JSIndexedRAMBundle::getStartupCode() {
   return std::move(m_startupCode);
 }
 
-std::string JSIndexedRAMBundle::getModuleCode(const uint32_t id) const {
+std::unique_ptr<const JSBigString> JSIndexedRAMBundle::getModuleCode(const uint32_t id) const {
   const auto moduleData = id < m_table.numEntries ? &m_table.data[id] : nullptr;
 
   // entries without associated code have offset = 0 and length = 0
@@ -69,9 +69,9 @@ std::string JSIndexedRAMBundle::getModuleCode(const uint32_t id) const {
       toString("Error loading module", id, "from RAM Bundle"));
   }
 
-  std::string ret(length - 1, '\0');
-  readBundle(&ret.front(), length - 1, m_baseOffset + littleEndianToHost(moduleData->offset));
-  return ret;
+  std::unique_ptr<JSBigBufferString> ret(new JSBigBufferString{length - 1});
+  readBundle(ret->data(), length - 1, m_baseOffset + littleEndianToHost(moduleData->offset));
+  return std::move(ret);
 }
 
 void JSIndexedRAMBundle::readBundle(char *buffer, const std::streamsize bytes) const {
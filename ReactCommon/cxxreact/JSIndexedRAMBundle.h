@@ -48,7 +48,7 @@ private:
     }
   };
 
-  std::string getModuleCode(const uint32_t id) const;
+  std::unique_ptr<const JSBigString> getModuleCode(const uint32_t id) const;
   void readBundle(char *buffer, const std::streamsize bytes) const;
   void readBundle(
     char *buffer, const
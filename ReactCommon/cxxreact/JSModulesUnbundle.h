@@ -3,9 +3,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <stdexcept>
 
+#include <cxxreact/JSBigString.h>
 #include <jschelpers/noncopyable.h>
 
 namespace facebook {
@@ -25,7 +27,7 @@ public:
   };
   struct Module {
     std::string name;
-    std::string code;
+    std::unique_ptr<const JSBigString> code;
   };
   virtual ~JSModulesUnbundle() {}
   virtual Module getModule(uint32_t moduleId) const = 0;
@@ -0,0 +1,417 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <folly/Conv.h>
+#include <folly/dynamic.h>
+#include <folly/Optional.h>
+#include <folly/Range.h>
+
+#include <cxxreact/JsArgumentHelpers.h>
+
+// Converts arguments from JS to typed C++ parameters, so that CxxModule
+// methods can be declared as, e.g., void add(int64_t a, double b).  Each
+// parameter type has a JsArgumentDecoder, chosen at compile time, which checks
+// the argument's type once and converts it, and describes the type for the
+// method's exported signature.
+//
+// Supported are bool, integers, floating point numbers, std::string,
+// folly::StringPiece (valid for the duration of the call), folly::dynamic,
+// std::vector and folly::Optional of supported types, and structs which
+// declare their fields with RN_JS_FIELDS:
+//
+//   struct Point {
+//     double x;
+//     double y;
+//     RN_JS_FIELDS(Point, x, y)
+//   };
+
+namespace facebook {
+namespace xplat {
+
+template <typename T, typename Enable = void>
+struct JsArgumentDecoder;
+
+namespace detail {
+
+[[noreturn]] inline void throwJsArgumentTypeError(
+    const folly::dynamic& arg, const char* expected, size_t n) {
+  throw JsArgumentException(
+    folly::to<std::string>(
+      "Error converting javascript arg ", n, " to C++: expected ",
+      expected, ", got ", arg.typeName()));
+}
+
+template <typename T, typename = void>
+struct has_js_fields : std::false_type {};
+
+template <typename T>
+struct has_js_fields<T, decltype(T::jsFields(), void())> : std::true_type {};
+
+// std::index_sequence is C++14.
+template <size_t... I>
+struct IndexSequence {};
+
+template <size_t N, size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct MakeIndexSequence<0, I...> : IndexSequence<I...> {};
+
+} // namespace detail
+
+// Lists the fields of a struct, for JsArgumentDecoder.  Put it in the struct.
+#define RN_JS_FIELDS(Type, ...)                                         \
+  static auto jsFields() -> decltype(                                   \
+      ::facebook::xplat::detail::jsFieldsOf<Type>(                      \
+        "", RN_JS_FIELD_POINTERS(Type, __VA_ARGS__))) {                 \
+    return ::facebook::xplat::detail::jsFieldsOf<Type>(                 \
+      #__VA_ARGS__, RN_JS_FIELD_POINTERS(Type, __VA_ARGS__));           \
+  }
+
+// Member pointers for up to 8 fields.
+#define RN_JS_FIELD_POINTERS(T, ...)                                    \
+  RN_JS_FIELD_POINTERS_N(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1)(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_N(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) \
+  RN_JS_FIELD_POINTERS_##N
+#define RN_JS_FIELD_POINTERS_1(T, a) &T::a
+#define RN_JS_FIELD_POINTERS_2(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_1(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_3(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_2(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_4(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_3(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_5(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_4(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_6(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_5(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_7(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_6(T, __VA_ARGS__)
+#define RN_JS_FIELD_POINTERS_8(T, a, ...) &T::a, RN_JS_FIELD_POINTERS_7(T, __VA_ARGS__)
+
+namespace detail {
+
+// Splits the stringized field list, "x, y", into names.  Runs once per
+// struct, when its decoder is first used.
+inline std::vector<std::string> splitFieldNames(const char* names) {
+  std::vector<std::string> result;
+  std::string current;
+  for (const char* c = names; ; c++) {
+    if (*c == ',' || *c == '\0') {
+      result.push_back(std::move(current));
+      current.clear();
+      if (*c == '\0') {
+        return result;
+      }
+    } else if (*c != ' ') {
+      current += *c;
+    }
+  }
+}
+
+template <typename S, typename... M>
+std::tuple<std::vector<std::string>, std::tuple<M S::*...>> jsFieldsOf(
+    const char* names, M S::*... members) {
+  return std::make_tuple(splitFieldNames(names), std::make_tuple(members...));
+}
+
+template <typename T>
+struct JsFields {
+  using Info = decltype(T::jsFields());
+  using Members = typename std::tuple_element<1, Info>::type;
+  static constexpr size_t kSize = std::tuple_size<Members>::value;
+
+  // Built once per struct, when its decoder is first used.
+  static const Info& info() {
+    static const Info fields = T::jsFields();
+    return fields;
+  }
+};
+
+} // namespace detail
+
+template <>
+struct JsArgumentDecoder<bool> {
+  static std::string signature() {
+    return "boolean";
+  }
+  static bool decode(folly::dynamic& arg, size_t n) {
+    if (!arg.isBool()) {
+      detail::throwJsArgumentTypeError(arg, "boolean", n);
+    }
+    return arg.getBool();
+  }
+};
+
+template <typename T>
+struct JsArgumentDecoder<T, typename std::enable_if<
+    std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  static std::string signature() {
+    return "number";
+  }
+  static T decode(folly::dynamic& arg, size_t n) {
+    int64_t value;
+    if (arg.isInt()) {
+      value = arg.getInt();
+    } else if (arg.isDouble()) {
+      // JS numbers are doubles; whole ones are fine.  Checked before the
+      // cast, which is undefined out of range.  -2^63 is exact as a double,
+      // and 2^63 is the first double past the range.
+      double d = arg.getDouble();
+      if (!std::isfinite(d) || std::trunc(d) != d) {
+        detail::throwJsArgumentTypeError(arg, "integer", n);
+      }
+      const double min = static_cast<double>(std::numeric_limits<int64_t>::min());
+      if (d < min || d >= -min) {
+        throw JsArgumentException(
+          folly::to<std::string>(
+            "Could not convert argument ", n, " to required type: ", d,
+            " is out of range"));
+      }
+      value = static_cast<int64_t>(d);
+    } else {
+      detail::throwJsArgumentTypeError(arg, "number", n);
+    }
+    try {
+      return folly::to<T>(value);
+    } catch (const std::range_error& ex) {
+      throw JsArgumentException(
+        folly::to<std::string>(
+          "Could not convert argument ", n, " to required type: ", ex.what()));
+    }
+  }
+};
+
+template <typename T>
+struct JsArgumentDecoder<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  static std::string signature() {
+    return "number";
+  }
+  static T decode(folly::dynamic& arg, size_t n) {
+    if (arg.isDouble()) {
+      return static_cast<T>(arg.getDouble());
+    } else if (arg.isInt()) {
+      return static_cast<T>(arg.getInt());
+    }
+    detail::throwJsArgumentTypeError(arg, "number", n);
+  }
+};
+
+template <>
+struct JsArgumentDecoder<std::string> {
+  static std::string signature() {
+    return "string";
+  }
+  static std::string decode(folly::dynamic& arg, size_t n) {
+    if (!arg.isString()) {
+      detail::throwJsArgumentTypeError(arg, "string", n);
+    }
+    // The arguments belong to the call, so the string can be taken.
+    return std::move(arg.getString());
+  }
+};
+
+template <>
+struct JsArgumentDecoder<folly::StringPiece> {
+  static std::string signature() {
+    return "string";
+  }
+  static folly::StringPiece decode(folly::dynamic& arg, size_t n) {
+    if (!arg.isString()) {
+      detail::throwJsArgumentTypeError(arg, "string", n);
+    }
+    return arg.getString();
+  }
+};
+
+template <>
+struct JsArgumentDecoder<folly::dynamic> {
+  static std::string signature() {
+    return "any";
+  }
+  static folly::dynamic decode(folly::dynamic& arg, size_t) {
+    return std::move(arg);
+  }
+};
+
+template <typename T>
+struct JsArgumentDecoder<std::vector<T>> {
+  static std::string signature() {
+    return "[" + JsArgumentDecoder<T>::signature() + "]";
+  }
+  static std::vector<T> decode(folly::dynamic& arg, size_t n) {
+    if (!arg.isArray()) {
+      detail::throwJsArgumentTypeError(arg, "array", n);
+    }
+    std::vector<T> result;
+    result.reserve(arg.size());
+    for (auto& element : arg) {
+      result.push_back(JsArgumentDecoder<T>::decode(element, n));
+    }
+    return result;
+  }
+};
+
+template <typename T>
+struct JsArgumentDecoder<folly::Optional<T>> {
+  static std::string signature() {
+    return "?" + JsArgumentDecoder<T>::signature();
+  }
+  static folly::Optional<T> decode(folly::dynamic& arg, size_t n) {
+    if (arg.isNull()) {
+      return folly::none;
+    }
+    return JsArgumentDecoder<T>::decode(arg, n);
+  }
+};
+
+namespace detail {
+
+template <typename T, typename M>
+void appendFieldSignature(std::string& result, M T::*, const std::string& name, bool first) {
+  if (!first) {
+    result += ",";
+  }
+  result += name + ":" + JsArgumentDecoder<M>::signature();
+}
+
+template <typename M>
+void decodeMissingField(M&, const std::string& name, size_t n) {
+  throw JsArgumentException(
+    folly::to<std::string>(
+      "Error converting javascript arg ", n, " to C++: missing field ", name));
+}
+
+// Optional fields may be left out, as they would be in JS.
+template <typename M>
+void decodeMissingField(folly::Optional<M>& field, const std::string&, size_t) {
+  field = folly::none;
+}
+
+template <typename T, typename M>
+void decodeField(T& result, M T::* member, const std::string& name, folly::dynamic& arg, size_t n) {
+  auto it = arg.find(name);
+  if (it == arg.items().end()) {
+    decodeMissingField(result.*member, name, n);
+    return;
+  }
+  result.*member = JsArgumentDecoder<M>::decode(it->second, n);
+}
+
+} // namespace detail
+
+template <typename T>
+struct JsArgumentDecoder<T, typename std::enable_if<detail::has_js_fields<T>::value>::type> {
+  static std::string signature() {
+    return signature(detail::MakeIndexSequence<detail::JsFields<T>::kSize>());
+  }
+
+  static T decode(folly::dynamic& arg, size_t n) {
+    if (!arg.isObject()) {
+      detail::throwJsArgumentTypeError(arg, "object", n);
+    }
+    return decode(arg, n, detail::MakeIndexSequence<detail::JsFields<T>::kSize>());
+  }
+
+private:
+  template <size_t... I>
+  static std::string signature(detail::IndexSequence<I...>) {
+    const auto& fields = detail::JsFields<T>::info();
+    std::string result = "{";
+    int ignored[] = {0, (detail::appendFieldSignature(
+      result, std::get<I>(std::get<1>(fields)), std::get<0>(fields)[I], I == 0), 0)...};
+    (void)ignored;
+    return result + "}";
+  }
+
+  template <size_t... I>
+  static T decode(folly::dynamic& arg, size_t n, detail::IndexSequence<I...>) {
+    const auto& fields = detail::JsFields<T>::info();
+    T result;
+    int ignored[] = {0, (detail::decodeField(
+      result, std::get<I>(std::get<1>(fields)), std::get<0>(fields)[I], arg, n), 0)...};
+    (void)ignored;
+    return result;
+  }
+};
+
+namespace detail {
+
+constexpr size_t countTrailingCallbacks(size_t count) {
+  return count;
+}
+
+template <typename... Rest>
+constexpr size_t countTrailingCallbacks(size_t count, bool isCallback, Rest... rest) {
+  return countTrailingCallbacks(isCallback ? count + 1 : 0, rest...);
+}
+
+// Calls a method with typed parameters, decoding them from the bridge's
+// arguments.  Callbacks, which are only allowed after all the other
+// parameters, are passed through rather than decoded.
+template <typename Callback, typename... Params>
+struct TypedMethod {
+  static constexpr size_t kNumParams = sizeof...(Params);
+  static constexpr size_t kNumCallbacks = countTrailingCallbacks(
+    0, std::is_same<typename std::decay<Params>::type, Callback>::value...);
+  static_assert(kNumCallbacks <= 2, "Methods take at most two callbacks");
+  static constexpr size_t kNumArgs = kNumParams - kNumCallbacks;
+
+  template <size_t I>
+  using Param = typename std::decay<typename std::tuple_element<I, std::tuple<Params...>>::type>::type;
+
+  template <size_t I>
+  static Param<I> param(folly::dynamic& args, Callback& first, Callback& second, std::true_type) {
+    return JsArgumentDecoder<Param<I>>::decode(args[I], I);
+  }
+
+  template <size_t I>
+  static Param<I> param(folly::dynamic& args, Callback& first, Callback& second, std::false_type) {
+    return I == kNumArgs ? std::move(first) : std::move(second);
+  }
+
+  template <typename F, size_t... I>
+  static void call(F&& f, folly::dynamic& args, Callback& first, Callback& second,
+                   IndexSequence<I...>) {
+    if (!args.isArray() || args.size() != kNumArgs) {
+      throw JsArgumentException(
+        folly::to<std::string>(
+          "JavaScript provided ", args.isArray() ? args.size() : 0,
+          " arguments for C++ method which takes ", kNumArgs, " arguments"));
+    }
+    // Decoded in order, since braced lists are evaluated in order.
+    std::tuple<Param<I>...> params{
+      param<I>(args, first, second, std::integral_constant<bool, (I < kNumArgs)>())...};
+    f(std::move(std::get<I>(params))...);
+  }
+
+  template <typename F>
+  static void call(F&& f, folly::dynamic& args, Callback& first, Callback& second) {
+    call(std::forward<F>(f), args, first, second, MakeIndexSequence<kNumParams>());
+  }
+
+  template <size_t... I>
+  static std::string signature(IndexSequence<I...>) {
+    std::string result = "(";
+    int ignored[] = {0, (result += (I > 0 ? "," : "") + JsArgumentDecoder<Param<I>>::signature(), 0)...};
+    (void)ignored;
+    return result + ")";
+  }
+
+  static std::string signature() {
+    return signature(MakeIndexSequence<kNumArgs>());
+  }
+};
+
+template <typename Callback, typename... Params>
+constexpr size_t TypedMethod<Callback, Params...>::kNumParams;
+template <typename Callback, typename... Params>
+constexpr size_t TypedMethod<Callback, Params...>::kNumCallbacks;
+template <typename Callback, typename... Params>
+constexpr size_t TypedMethod<Callback, Params...>::kNumArgs;
+
+} // namespace detail
+
+}}
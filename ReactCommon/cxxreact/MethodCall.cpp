@@ -16,8 +16,16 @@ namespace react {
 static const char *errorPrefix = "Malformed calls from JS: ";
 
 std::vector<MethodCall> parseMethodCalls(folly::dynamic&& jsonData) throw(std::invalid_argument) {
+  std::vector<MethodCall> methodCalls;
+  parseMethodCalls(std::move(jsonData), methodCalls);
+  return methodCalls;
+}
+
+void parseMethodCalls(
+    folly::dynamic&& jsonData,
+    std::vector<MethodCall>& methodCalls) throw(std::invalid_argument) {
   if (jsonData.isNull()) {
-    return {};
+    return;
   }
 
   if (!jsonData.isArray()) {
@@ -53,7 +61,7 @@ std::vector<MethodCall> parseMethodCalls(folly::dynamic&& jsonData) throw(std::i
     callId = jsonData[REQUEST_CALLID].asInt();
   }
 
-  std::vector<MethodCall> methodCalls;
+  methodCalls.reserve(methodCalls.size() + moduleIds.size());
   for (size_t i = 0; i < moduleIds.size(); i++) {
     if (!params[i].isArray()) {
       throw std::invalid_argument(
@@ -69,8 +77,6 @@ std::vector<MethodCall> parseMethodCalls(folly::dynamic&& jsonData) throw(std::i
     // only incremement callid if contains valid callid as callid is optional
     callId += (callId != -1) ? 1 : 0;
   }
-
-  return methodCalls;
 }
 
 }}
@@ -26,4 +26,10 @@ struct MethodCall {
 
 std::vector<MethodCall> parseMethodCalls(folly::dynamic&& calls) throw(std::invalid_argument);
 
+// Appends the calls to methodCalls, so that callers can reuse one vector, and
+// its capacity, for every batch.
+void parseMethodCalls(
+  folly::dynamic&& calls,
+  std::vector<MethodCall>& methodCalls) throw(std::invalid_argument);
+
 } }
@@ -38,6 +38,7 @@ void ModuleRegistry::updateModuleNamesFromIndex(size_t index) {
 }
 
 void ModuleRegistry::registerModules(std::vector<std::unique_ptr<NativeModule>> modules) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (modules_.empty() && unknownModules_.empty()) {
     modules_ = std::move(modules);
   } else {
@@ -64,6 +65,7 @@ void ModuleRegistry::registerModules(std::vector<std::unique_ptr<NativeModule>>
 }
 
 std::vector<std::string> ModuleRegistry::moduleNames() {
+  std::lock_guard<std::mutex> lock(mutex_);
   std::vector<std::string> names;
   for (size_t i = 0; i < modules_.size(); i++) {
     std::string name = normalizeName(modules_[i]->getName());
@@ -76,30 +78,47 @@ std::vector<std::string> ModuleRegistry::moduleNames() {
 folly::Optional<ModuleConfig> ModuleRegistry::getConfig(const std::string& name) {
   SystraceSection s("ModuleRegistry::getConfig", "module", name);
 
-  // Initialize modulesByName_
-  if (modulesByName_.empty() && !modules_.empty()) {
-    moduleNames();
-  }
-
-  auto it = modulesByName_.find(name);
+  size_t index;
+  NativeModule *module;
+  std::mutex *initMutex;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
 
-  if (it == modulesByName_.end()) {
-    if (unknownModules_.find(name) != unknownModules_.end()) {
-      return nullptr;
+    // Initialize modulesByName_
+    if (modulesByName_.empty() && !modules_.empty()) {
+      updateModuleNamesFromIndex(0);
     }
-    if (!moduleNotFoundCallback_ ||
-        !moduleNotFoundCallback_(name) ||
-        (it = modulesByName_.find(name)) == modulesByName_.end()) {
-      unknownModules_.insert(name);
-      return nullptr;
+
+    auto it = modulesByName_.find(name);
+
+    if (it == modulesByName_.end()) {
+      if (unknownModules_.find(name) != unknownModules_.end()) {
+        return nullptr;
+      }
+      // The callback may register the module, which takes the lock.
+      lock.unlock();
+      bool registered = moduleNotFoundCallback_ && moduleNotFoundCallback_(name);
+      lock.lock();
+      if (!registered || (it = modulesByName_.find(name)) == modulesByName_.end()) {
+        unknownModules_.insert(name);
+        return nullptr;
+      }
     }
+    index = it->second;
+
+    CHECK(index < modules_.size());
+    // Modules are never removed, so the pointers stay valid after unlocking.
+    module = modules_[index].get();
+    initMutex = &moduleInitMutexes_[index];
   }
-  size_t index = it->second;
 
-  CHECK(index < modules_.size());
-  NativeModule *module = modules_[index].get();
+  // Modules initialize lazily in getConstants() and getMethods(), which may
+  // wait on other threads, e.g. for constants gathered on the main queue on
+  // iOS.  Only instances requiring the same module wait for each other here,
+  // and mutex_ isn't held, so registering modules and calling methods go on.
+  std::lock_guard<std::mutex> initLock(*initMutex);
 
-  // string name, object constants, array methodNames (methodId is index), [array promiseMethodIds], [array syncMethodIds]
+  // string name, object constants, array methodNames (methodId is index), [array promiseMethodIds], [array syncMethodIds], [object methodSignatures]
   folly::dynamic config = folly::dynamic::array(name);
 
   {
@@ -114,8 +133,12 @@ folly::Optional<ModuleConfig> ModuleRegistry::getConfig(const std::string& name)
     folly::dynamic methodNames = folly::dynamic::array;
     folly::dynamic promiseMethodIds = folly::dynamic::array;
     folly::dynamic syncMethodIds = folly::dynamic::array;
+    folly::dynamic methodSignatures = folly::dynamic::object;
 
     for (auto& descriptor : methods) {
+      if (!descriptor.signature.empty()) {
+        methodSignatures.insert(descriptor.name, std::move(descriptor.signature));
+      }
       // TODO: #10487027 compare tags instead of doing string comparison?
       methodNames.push_back(std::move(descriptor.name));
       if (descriptor.type == "promise") {
@@ -127,10 +150,13 @@ folly::Optional<ModuleConfig> ModuleRegistry::getConfig(const std::string& name)
 
     if (!methodNames.empty()) {
       config.push_back(std::move(methodNames));
-      if (!promiseMethodIds.empty() || !syncMethodIds.empty()) {
+      if (!promiseMethodIds.empty() || !syncMethodIds.empty() || !methodSignatures.empty()) {
         config.push_back(std::move(promiseMethodIds));
-        if (!syncMethodIds.empty()) {
+        if (!syncMethodIds.empty() || !methodSignatures.empty()) {
           config.push_back(std::move(syncMethodIds));
+          if (!methodSignatures.empty()) {
+            config.push_back(std::move(methodSignatures));
+          }
         }
       }
     }
@@ -144,20 +170,22 @@ folly::Optional<ModuleConfig> ModuleRegistry::getConfig(const std::string& name)
   }
 }
 
-void ModuleRegistry::callNativeMethod(unsigned int moduleId, unsigned int methodId, folly::dynamic&& params, int callId) {
+NativeModule *ModuleRegistry::getModule(unsigned int moduleId) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (moduleId >= modules_.size()) {
     throw std::runtime_error(
       folly::to<std::string>("moduleId ", moduleId, " out of range [0..", modules_.size(), ")"));
   }
-  modules_[moduleId]->invoke(methodId, std::move(params), callId);
+  // Modules are never removed, so the pointer stays valid after unlocking.
+  return modules_[moduleId].get();
+}
+
+void ModuleRegistry::callNativeMethod(unsigned int moduleId, unsigned int methodId, folly::dynamic&& params, int callId) {
+  getModule(moduleId)->invoke(methodId, std::move(params), callId);
 }
 
 MethodCallResult ModuleRegistry::callSerializableNativeHook(unsigned int moduleId, unsigned int methodId, folly::dynamic&& params) {
-  if (moduleId >= modules_.size()) {
-    throw std::runtime_error(
-      folly::to<std::string>("moduleId ", moduleId, "out of range [0..", modules_.size(), ")"));
-  }
-  return modules_[moduleId]->callSerializableNativeHook(methodId, std::move(params));
+  return getModule(moduleId)->callSerializableNativeHook(methodId, std::move(params));
 }
 
 }}
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -24,6 +26,10 @@ struct ModuleConfig {
   folly::dynamic config;
 };
 
+/**
+ * ModuleRegistry is safe to share between instances: lookups and calls may
+ * come from several JS threads at once.
+ */
 class RN_EXPORT ModuleRegistry {
  public:
   // not implemented:
@@ -46,6 +52,13 @@ class RN_EXPORT ModuleRegistry {
   MethodCallResult callSerializableNativeHook(unsigned int moduleId, unsigned int methodId, folly::dynamic&& args);
 
  private:
+  NativeModule *getModule(unsigned int moduleId);
+
+  // Guards all members.  Held while asking modules for their names, which
+  // mustn't call back into the registry; never held while calling any other
+  // module method or moduleNotFoundCallback_.
+  std::mutex mutex_;
+
   // This is always populated
   std::vector<std::unique_ptr<NativeModule>> modules_;
 
@@ -59,6 +72,10 @@ class RN_EXPORT ModuleRegistry {
   // An error will be thrown if they are subsquently added to the registry.
   std::unordered_set<std::string> unknownModules_;
 
+  // Serializes the lazy initialization of each module in getConfig(), by
+  // index into modules_.
+  std::unordered_map<size_t, std::mutex> moduleInitMutexes_;
+
   // Function will be called if a module was requested but was not found.
   // If the function returns true, ModuleRegistry will try to find the module again (assuming it's registered)
   // If the functon returns false, ModuleRegistry will not try to find the module and return nullptr instead.
@@ -0,0 +1,103 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "NativeCallScheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+size_t priorityIndex(NativeCallScheduler::Priority priority) {
+  return static_cast<size_t>(priority);
+}
+
+}
+
+NativeCallScheduler::NativeCallScheduler(std::shared_ptr<MessageQueueThread> queue)
+  : m_queue(std::move(queue))
+  , m_state(std::make_shared<State>()) {}
+
+void NativeCallScheduler::runOnQueue(
+    const void* module,
+    Priority priority,
+    std::function<void()>&& task) {
+  {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    auto& moduleCalls = m_state->pending[module];
+    moduleCalls.calls.push_back({m_state->nextSequence++, priority, std::move(task)});
+    moduleCalls.counts[priorityIndex(priority)]++;
+  }
+  // Each posted task runs whichever call is most urgent at that time, which
+  // isn't necessarily the one just added.
+  m_queue->runOnQueue([state = m_state] { runNext(*state); });
+}
+
+void NativeCallScheduler::runAfterPending(std::function<void()>&& task) {
+  {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->barriers.push_back(
+      {m_state->nextSequence++, Priority::Normal, std::move(task)});
+  }
+  m_queue->runOnQueue([state = m_state] { runNext(*state); });
+}
+
+void NativeCallScheduler::runOnQueue(std::function<void()>&& task) {
+  runOnQueue(nullptr, Priority::Normal, std::move(task));
+}
+
+void NativeCallScheduler::runOnQueueSync(std::function<void()>&& task) {
+  m_queue->runOnQueueSync(std::move(task));
+}
+
+void NativeCallScheduler::quitSynchronous() {
+  m_queue->quitSynchronous();
+}
+
+void NativeCallScheduler::runNext(State& state) {
+  std::function<void()> task;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // There are only as many entries as modules with calls pending, which
+    // is a handful at a time in practice.
+    auto next = state.pending.end();
+    size_t nextPriority = 0;
+    // Each module's calls are queued oldest first.
+    uint64_t oldest = UINT64_MAX;
+    for (auto it = state.pending.begin(); it != state.pending.end(); ++it) {
+      size_t priority = 0;
+      while (it->second.counts[priority] == 0) {
+        priority++;
+      }
+      if (next == state.pending.end() || priority < nextPriority ||
+          (priority == nextPriority &&
+           it->second.calls.front().sequence < next->second.calls.front().sequence)) {
+        next = it;
+        nextPriority = priority;
+      }
+      oldest = std::min(oldest, it->second.calls.front().sequence);
+    }
+
+    if (!state.barriers.empty() && state.barriers.front().sequence < oldest) {
+      task = std::move(state.barriers.front().task);
+      state.barriers.pop_front();
+    } else if (next != state.pending.end()) {
+      auto& moduleCalls = next->second;
+      task = std::move(moduleCalls.calls.front().task);
+      moduleCalls.counts[priorityIndex(moduleCalls.calls.front().priority)]--;
+      moduleCalls.calls.pop_front();
+      if (moduleCalls.calls.empty()) {
+        state.pending.erase(next);
+      }
+    } else {
+      return;
+    }
+  }
+  task();
+}
+
+} // namespace react
+} // namespace facebook
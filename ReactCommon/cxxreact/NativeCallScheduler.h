@@ -0,0 +1,86 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <cxxreact/CxxModule.h>
+#include <cxxreact/MessageQueueThread.h>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+/**
+ * A MessageQueueThread for native modules that runs calls by priority
+ * instead of strictly in the order they were posted.
+ *
+ * Each module's calls run in the order they were made.  Between modules, the
+ * one with the most urgent call pending goes first, and the oldest call goes
+ * first among equals.  Calls queued in front of a module's urgent call are
+ * promoted along with it, so a UI-critical call never waits for background
+ * calls to other modules.
+ *
+ * Work posted through the plain MessageQueueThread interface, e.g. calls to
+ * platform modules, forms one queue at normal priority.  When everything runs
+ * at normal priority, the order is the same as posting to `queue` directly.
+ *
+ * So a background call may still be pending when normal work posted after it
+ * runs.  Work that has to follow every call posted before it, like the end
+ * of a batch, goes through runAfterPending().
+ */
+class RN_EXPORT NativeCallScheduler : public MessageQueueThread {
+public:
+  using Priority = xplat::module::CxxModule::Priority;
+
+  explicit NativeCallScheduler(std::shared_ptr<MessageQueueThread> queue);
+
+  // `module` identifies the queue the call belongs to.
+  void runOnQueue(const void* module, Priority priority, std::function<void()>&& task);
+
+  // Runs `task` once all calls posted before it have run, whatever their
+  // priority.  Calls posted after it may still run first.
+  void runAfterPending(std::function<void()>&& task);
+
+  void runOnQueue(std::function<void()>&& task) override;
+  void runOnQueueSync(std::function<void()>&& task) override;
+  void quitSynchronous() override;
+
+private:
+  struct Call {
+    uint64_t sequence;
+    Priority priority;
+    std::function<void()> task;
+  };
+
+  struct ModuleCalls {
+    std::deque<Call> calls;
+    // Number of calls pending per priority.
+    size_t counts[static_cast<size_t>(Priority::Background) + 1] = {};
+  };
+
+  // Shared with the tasks posted to the queue, which may outlive us.
+  struct State {
+    std::mutex mutex;
+    std::unordered_map<const void*, ModuleCalls> pending;
+    // From runAfterPending(), in the order posted.
+    std::deque<Call> barriers;
+    uint64_t nextSequence = 0;
+  };
+
+  static void runNext(State& state);
+
+  std::shared_ptr<MessageQueueThread> m_queue;
+  std::shared_ptr<State> m_state;
+};
+
+} // namespace react
+} // namespace facebook
@@ -15,10 +15,13 @@ struct MethodDescriptor {
   std::string name;
   // type is one of js MessageQueue.MethodTypes
   std::string type;
+  // Parameter types, if the method declares them, e.g. "(number,string)".
+  std::string signature;
 
-  MethodDescriptor(std::string n, std::string t)
+  MethodDescriptor(std::string n, std::string t, std::string s = "")
       : name(std::move(n))
-      , type(std::move(t)) {}
+      , type(std::move(t))
+      , signature(std::move(s)) {}
 };
 
   using MethodCallResult = folly::Optional<folly::dynamic>;
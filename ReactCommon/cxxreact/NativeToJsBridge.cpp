@@ -7,8 +7,11 @@
 #include <folly/MoveWrapper.h>
 #include <glog/logging.h>
 
+#include "BridgeAllocations.h"
+#include "CxxNativeModule.h"
 #include "Instance.h"
 #include "JSBigString.h"
+#include "JSCodeCache.h"
 #include "SystraceSection.h"
 #include "MethodCall.h"
 #include "MessageQueueThread.h"
@@ -26,9 +29,11 @@ namespace react {
 class JsToNativeBridge : public react::ExecutorDelegate {
 public:
   JsToNativeBridge(std::shared_ptr<ModuleRegistry> registry,
-                   std::shared_ptr<InstanceCallback> callback)
+                   std::shared_ptr<InstanceCallback> callback,
+                   std::weak_ptr<Instance> instance)
     : m_registry(registry)
-    , m_callback(callback) {}
+    , m_callback(callback)
+    , m_instance(std::move(instance)) {}
 
   std::shared_ptr<ModuleRegistry> getModuleRegistry() override {
     return m_registry;
@@ -40,6 +45,7 @@ public:
 
   void callNativeModules(
       JSExecutor& executor, folly::dynamic&& calls, bool isEndOfBatch) override {
+    BridgeAllocations::Scope allocations(BridgeOperation::CallNativeModules);
 
     CHECK(m_registry || calls.empty()) <<
       "native module calls cannot be completed with no native modules";
@@ -48,11 +54,25 @@ public:
     // An exception anywhere in here stops processing of the batch.  This
     // was the behavior of the Android bridge, and since exception handling
     // terminates the whole bridge, there's not much point in continuing.
-    for (auto& call : parseMethodCalls(std::move(calls))) {
+    CallingInstanceScope callingInstance(m_instance);
+    // Taken rather than used in place, in case a native call flushes another
+    // batch before this one is done.
+    std::vector<MethodCall> methodCalls;
+    methodCalls.swap(m_methodCalls);
+    parseMethodCalls(std::move(calls), methodCalls);
+    for (auto& call : methodCalls) {
       m_registry->callNativeMethod(call.moduleId, call.methodId, std::move(call.arguments), call.callId);
     }
+    // The arguments were moved to the modules, so this only keeps the
+    // storage for the next batch, unless the batch was unusually large.
+    if (methodCalls.capacity() <= kMaxRetainedMethodCalls) {
+      methodCalls.clear();
+      m_methodCalls.swap(methodCalls);
+    }
     if (isEndOfBatch) {
-      // onBatchComplete will be called on the native (module) queue, but
+      // onBatchComplete will be called on the native (module) queue, after
+      // the calls of the batch whatever their priority (see
+      // NativeCallScheduler::runAfterPending), but
       // decrementPendingJSCalls will be called sync. Be aware that the bridge may still
       // be processing native calls when the birdge idle signaler fires.
       if (m_batchHadNativeModuleCalls) {
@@ -76,16 +96,24 @@ private:
   // executor is destroyed synchronously on its queue.
   std::shared_ptr<ModuleRegistry> m_registry;
   std::shared_ptr<InstanceCallback> m_callback;
+  std::weak_ptr<Instance> m_instance;
   bool m_batchHadNativeModuleCalls = false;
+
+  // Storage for the calls of a batch, kept between batches.  A batch only
+  // allocates for its calls when it has more than any batch before it, so
+  // once warmed up, batches of up to kMaxRetainedMethodCalls calls don't.
+  static constexpr size_t kMaxRetainedMethodCalls = 256;
+  std::vector<MethodCall> m_methodCalls;
 };
 
 NativeToJsBridge::NativeToJsBridge(
     JSExecutorFactory* jsExecutorFactory,
     std::shared_ptr<ModuleRegistry> registry,
     std::shared_ptr<MessageQueueThread> jsQueue,
-    std::shared_ptr<InstanceCallback> callback)
+    std::shared_ptr<InstanceCallback> callback,
+    std::weak_ptr<Instance> instance)
     : m_destroyed(std::make_shared<bool>(false))
-    , m_delegate(std::make_shared<JsToNativeBridge>(registry, callback))
+    , m_delegate(std::make_shared<JsToNativeBridge>(registry, callback, std::move(instance)))
     , m_executor(jsExecutorFactory->createJSExecutor(m_delegate, jsQueue))
     , m_executorMessageQueueThread(std::move(jsQueue)) {}
 
@@ -103,15 +131,21 @@ void NativeToJsBridge::loadApplication(
       [this,
        bundleRegistryWrap=folly::makeMoveWrapper(std::move(bundleRegistry)),
        startupScript=folly::makeMoveWrapper(std::move(startupScript)),
-       startupScriptSourceURL=std::move(startupScriptSourceURL)]
+       startupScriptSourceURL=std::move(startupScriptSourceURL),
+       codeCache=m_codeCache]
         (JSExecutor* executor) mutable {
     auto bundleRegistry = bundleRegistryWrap.move();
     if (bundleRegistry) {
       executor->setBundleRegistry(std::move(bundleRegistry));
     }
     try {
-      executor->loadApplicationScript(std::move(*startupScript),
-                                      std::move(startupScriptSourceURL));
+      if (codeCache) {
+        codeCache->loadApplicationScript(*executor, std::move(*startupScript),
+                                         std::move(startupScriptSourceURL));
+      } else {
+        executor->loadApplicationScript(std::move(*startupScript),
+                                        std::move(startupScriptSourceURL));
+      }
     } catch (...) {
       m_applicationScriptHasFailure = true;
       throw;
@@ -123,12 +157,20 @@ void NativeToJsBridge::loadApplicationSync(
     std::unique_ptr<RAMBundleRegistry> bundleRegistry,
     std::unique_ptr<const JSBigString> startupScript,
     std::string startupScriptSourceURL) {
+  if (*m_destroyed) {
+    return;
+  }
   if (bundleRegistry) {
     m_executor->setBundleRegistry(std::move(bundleRegistry));
   }
   try {
-    m_executor->loadApplicationScript(std::move(startupScript),
-                                          std::move(startupScriptSourceURL));
+    if (m_codeCache) {
+      m_codeCache->loadApplicationScript(*m_executor, std::move(startupScript),
+                                         std::move(startupScriptSourceURL));
+    } else {
+      m_executor->loadApplicationScript(std::move(startupScript),
+                                        std::move(startupScriptSourceURL));
+    }
   } catch (...) {
     m_applicationScriptHasFailure = true;
     throw;
@@ -139,6 +181,8 @@ void NativeToJsBridge::callFunction(
     std::string&& module,
     std::string&& method,
     folly::dynamic&& arguments) {
+  BridgeAllocations::Scope allocations(BridgeOperation::CallFunction);
+
   int systraceCookie = -1;
   #ifdef WITH_FBSYSTRACE
   systraceCookie = m_systraceCookie++;
@@ -196,6 +240,10 @@ void NativeToJsBridge::invokeCallback(double callbackId, folly::dynamic&& argume
     });
 }
 
+void NativeToJsBridge::setCodeCache(std::shared_ptr<JSCodeCache> codeCache) {
+  m_codeCache = std::move(codeCache);
+}
+
 void NativeToJsBridge::registerBundle(uint32_t bundleId, const std::string& bundlePath) {
   runOnExecutorQueue([bundleId, bundlePath] (JSExecutor* executor) {
     executor->registerBundle(bundleId, bundlePath);
@@ -212,11 +260,11 @@ void NativeToJsBridge::setGlobalVariable(std::string propName,
 
 void* NativeToJsBridge::getJavaScriptContext() {
   // TODO(cjhopman): this seems unsafe unless we require that it is only called on the main js queue.
-  return m_executor->getJavaScriptContext();
+  return *m_destroyed ? nullptr : m_executor->getJavaScriptContext();
 }
 
 bool NativeToJsBridge::isInspectable() {
-  return m_executor->isInspectable();
+  return *m_destroyed ? false : m_executor->isInspectable();
 }
 
 bool NativeToJsBridge::isBatchActive() {
@@ -17,7 +17,9 @@ struct dynamic;
 namespace facebook {
 namespace react {
 
+class Instance;
 struct InstanceCallback;
+class JSCodeCache;
 class JsToNativeBridge;
 class MessageQueueThread;
 class ModuleRegistry;
@@ -35,13 +37,15 @@ public:
   friend class JsToNativeBridge;
 
   /**
-   * This must be called on the main JS thread.
+   * This must be called on the main JS thread.  Callbacks of native calls
+   * made by this bridge's JS go to `instance`; see CallingInstanceScope.
    */
   NativeToJsBridge(
       JSExecutorFactory* jsExecutorFactory,
       std::shared_ptr<ModuleRegistry> registry,
       std::shared_ptr<MessageQueueThread> jsQueue,
-      std::shared_ptr<InstanceCallback> callback);
+      std::shared_ptr<InstanceCallback> callback,
+      std::weak_ptr<Instance> instance = std::weak_ptr<Instance>());
   virtual ~NativeToJsBridge();
 
   /**
@@ -98,6 +102,12 @@ public:
     std::unique_ptr<const JSBigString> startupCode,
     std::string sourceURL);
 
+  /**
+   * Scripts loaded after this call go through the given code cache.  Pass
+   * nullptr to always evaluate the source text.
+   */
+  void setCodeCache(std::shared_ptr<JSCodeCache> codeCache);
+
   void registerBundle(uint32_t bundleId, const std::string& bundlePath);
   void setGlobalVariable(std::string propName, std::unique_ptr<const JSBigString> jsonValue);
   void* getJavaScriptContext();
@@ -109,7 +119,9 @@ public:
   #endif
 
   /**
-   * Synchronously tears down the bridge and the main executor.
+   * Synchronously tears down the bridge and the main executor, and quits the
+   * JS queue.  The module registry is left alone, since other bridges may
+   * share it.  Work queued for this bridge after this call is dropped.
    */
   void destroy();
 private:
@@ -123,6 +135,7 @@ private:
   std::shared_ptr<JsToNativeBridge> m_delegate;
   std::unique_ptr<JSExecutor> m_executor;
   std::shared_ptr<MessageQueueThread> m_executorMessageQueueThread;
+  std::shared_ptr<JSCodeCache> m_codeCache;
 
   // Keep track of whether the JS bundle containing the application logic causes
   // exception when evaluated initially. If so, more calls to JS will very
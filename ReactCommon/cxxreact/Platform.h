@@ -29,6 +29,8 @@ enum ReactMarkerId {
   JS_BUNDLE_STRING_CONVERT_STOP,
   NATIVE_MODULE_SETUP_START,
   NATIVE_MODULE_SETUP_STOP,
+  JS_CODE_CACHE_HIT,
+  JS_CODE_CACHE_MISS,
 };
 
 #ifdef __APPLE__
@@ -0,0 +1,235 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "RAMBundleProfile.h"
+
+#include <cerrno>
+#include <fstream>
+#include <sys/stat.h>
+#include <system_error>
+
+#include <glog/logging.h>
+
+#include "SystraceSection.h"
+#include "oss-compat-util.h"
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+static uint32_t constexpr ProfileMagicNumber = 0xFB0BD1E6;
+static uint32_t constexpr ProfileFormatVersion = 2;
+
+// A profile file is this header followed by `numEntries` entries of three
+// little endian uint32_t each: bundle id, module id, load time in µs.
+struct __attribute__((packed)) ProfileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t bundleSize;
+  int64_t bundleModifiedTime;
+  uint32_t numEntries;
+};
+
+static_assert(
+  sizeof(RAMBundleProfileEntry) == 12,
+  "RAMBundleProfileEntry must not have any padding and use sizes matching profile files");
+
+}
+
+constexpr size_t RAMBundlePrefetcher::MAX_MODULES_AHEAD;
+
+RAMBundleProfileKey RAMBundleProfileKey::forFile(const std::string& bundlePath) {
+  struct stat fileInfo;
+  if (::stat(bundlePath.c_str(), &fileInfo) != 0) {
+    return {0, 0};
+  }
+  return {
+    static_cast<uint64_t>(fileInfo.st_size),
+    static_cast<int64_t>(fileInfo.st_mtime),
+  };
+}
+
+void RAMBundleProfileRecorder::record(
+    uint32_t bundleId,
+    uint32_t moduleId,
+    uint32_t loadTimeUs) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.push_back({bundleId, moduleId, loadTimeUs});
+}
+
+std::vector<RAMBundleProfileEntry> RAMBundleProfileRecorder::entries() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries;
+}
+
+void RAMBundleProfileRecorder::writeToFile(
+    const std::string& path,
+    const RAMBundleProfileKey& key) const {
+  auto entries = this->entries();
+
+  ProfileHeader header;
+  header.magic = littleEndianToHost(ProfileMagicNumber);
+  header.version = littleEndianToHost(ProfileFormatVersion);
+  header.bundleSize = littleEndianToHost(key.bundleSize);
+  header.bundleModifiedTime = littleEndianToHost(key.bundleModifiedTime);
+  header.numEntries = littleEndianToHost(static_cast<uint32_t>(entries.size()));
+  for (auto& entry : entries) {
+    entry.bundleId = littleEndianToHost(entry.bundleId);
+    entry.moduleId = littleEndianToHost(entry.moduleId);
+    entry.loadTimeUs = littleEndianToHost(entry.loadTimeUs);
+  }
+
+  std::ofstream out(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(
+    reinterpret_cast<const char *>(entries.data()),
+    entries.size() * sizeof(RAMBundleProfileEntry));
+  out.close();
+  if (!out) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Could not write RAM bundle profile " + path);
+  }
+}
+
+std::vector<RAMBundleProfileEntry> readRAMBundleProfile(
+    const std::string& path,
+    const RAMBundleProfileKey& key) {
+  std::ifstream in(path, std::ios_base::in | std::ios_base::binary);
+  ProfileHeader header;
+  if (!in || !in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      littleEndianToHost(header.magic) != ProfileMagicNumber ||
+      littleEndianToHost(header.version) != ProfileFormatVersion) {
+    return {};
+  }
+  RAMBundleProfileKey profileKey {
+    littleEndianToHost(header.bundleSize),
+    littleEndianToHost(header.bundleModifiedTime),
+  };
+  if (!(profileKey == key)) {
+    // Recorded for an older bundle; its modules are likely to have moved.
+    return {};
+  }
+
+  std::vector<RAMBundleProfileEntry> entries(littleEndianToHost(header.numEntries));
+  if (!in.read(
+        reinterpret_cast<char *>(entries.data()),
+        entries.size() * sizeof(RAMBundleProfileEntry))) {
+    LOG(WARNING) << "Ignoring truncated RAM bundle profile " << path;
+    return {};
+  }
+  for (auto& entry : entries) {
+    entry.bundleId = littleEndianToHost(entry.bundleId);
+    entry.moduleId = littleEndianToHost(entry.moduleId);
+    entry.loadTimeUs = littleEndianToHost(entry.loadTimeUs);
+  }
+  return entries;
+}
+
+RAMBundlePrefetcher::RAMBundlePrefetcher(
+    std::function<std::unique_ptr<JSModulesUnbundle>()> bundleFactory,
+    std::vector<uint32_t> moduleIds)
+  : m_moduleIds(std::move(moduleIds)) {
+  for (size_t i = 0; i < m_moduleIds.size(); i++) {
+    m_positions.emplace(m_moduleIds[i], i);
+  }
+  m_thread = std::thread(&RAMBundlePrefetcher::run, this, std::move(bundleFactory));
+}
+
+RAMBundlePrefetcher::~RAMBundlePrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopped = true;
+  }
+  m_askedFor.notify_all();
+  m_thread.join();
+}
+
+void RAMBundlePrefetcher::run(
+    std::function<std::unique_ptr<JSModulesUnbundle>()> bundleFactory) {
+  SystraceSection s("RAMBundlePrefetcher::run");
+
+  std::unique_ptr<JSModulesUnbundle> bundle;
+  try {
+    bundle = bundleFactory();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Could not open RAM bundle for prefetching: " << e.what();
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (bundle && !m_stopped && m_next < m_moduleIds.size()) {
+    uint32_t moduleId = m_moduleIds[m_next];
+    if (m_skipped.count(moduleId)) {
+      m_next++;
+      continue;
+    }
+    if (m_next >= m_askedEnd + MAX_MODULES_AHEAD) {
+      m_askedFor.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+    bool loaded = false;
+    JSModulesUnbundle::Module module;
+    try {
+      module = bundle->getModule(moduleId);
+      loaded = true;
+    } catch (const std::exception&) {
+      // The JS thread will load the module itself and report the error.
+    }
+    lock.lock();
+
+    if (loaded) {
+      m_modules.emplace(moduleId, std::move(module));
+    }
+    m_next++;
+    m_loaded.notify_all();
+  }
+
+  // Nothing else will be loaded; release anybody waiting.
+  m_next = m_moduleIds.size();
+  m_loaded.notify_all();
+}
+
+bool RAMBundlePrefetcher::takeModule(
+    uint32_t moduleId,
+    JSModulesUnbundle::Module& module) {
+  auto position = m_positions.find(moduleId);
+  if (position == m_positions.end()) {
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (position->second >= m_askedEnd) {
+    m_askedEnd = position->second + 1;
+    for (auto it = m_modules.begin(); it != m_modules.end();) {
+      if (m_positions.at(it->first) + MAX_MODULES_AHEAD < m_askedEnd) {
+        it = m_modules.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    m_askedFor.notify_all();
+  }
+
+  if (position->second > m_next) {
+    // JS is ahead of the prefetcher.  Loading this module ourselves is
+    // faster than waiting for the modules in front of it.
+    m_skipped.insert(moduleId);
+    return false;
+  }
+
+  m_loaded.wait(lock, [&] {
+    return m_next > position->second || m_modules.count(moduleId);
+  });
+
+  auto it = m_modules.find(moduleId);
+  if (it == m_modules.end()) {
+    return false;
+  }
+  module = std::move(it->second);
+  m_modules.erase(it);
+  return true;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,135 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <cxxreact/JSModulesUnbundle.h>
+#include <jschelpers/noncopyable.h>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+/**
+ * RAMBundleProfileEntry
+ *
+ * One module load, in the order the JS thread required them. The time is
+ * that of the whole require, from NATIVE_REQUIRE_START to
+ * NATIVE_REQUIRE_STOP.
+ */
+struct RAMBundleProfileEntry {
+  uint32_t bundleId;
+  uint32_t moduleId;
+  uint32_t loadTimeUs;
+};
+
+/**
+ * RAMBundleProfileKey
+ *
+ * Identifies the bundle file a profile was recorded for, so that a profile
+ * is dropped once the bundle is updated.
+ */
+struct RAMBundleProfileKey {
+  uint64_t bundleSize;
+  int64_t bundleModifiedTime;
+
+  // All zero if the file can't be read.
+  static RAMBundleProfileKey forFile(const std::string& bundlePath);
+
+  bool operator==(const RAMBundleProfileKey& other) const {
+    return bundleSize == other.bundleSize &&
+      bundleModifiedTime == other.bundleModifiedTime;
+  }
+};
+
+/**
+ * Records the order and duration of RAM bundle module loads, so that later
+ * launches can prefetch them with a RAMBundlePrefetcher. Recording happens on
+ * the JS thread; the profile can be written from any thread.
+ */
+class RN_EXPORT RAMBundleProfileRecorder : noncopyable {
+public:
+  RAMBundleProfileRecorder() = default;
+
+  void record(uint32_t bundleId, uint32_t moduleId, uint32_t loadTimeUs);
+  std::vector<RAMBundleProfileEntry> entries() const;
+
+  // Throws std::system_error on failure.
+  void writeToFile(const std::string& path, const RAMBundleProfileKey& key) const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<RAMBundleProfileEntry> m_entries;
+};
+
+/**
+ * Reads a profile written by RAMBundleProfileRecorder. Returns an empty
+ * profile if the file is missing or malformed, or was recorded for another
+ * bundle than `key` identifies.
+ */
+RN_EXPORT std::vector<RAMBundleProfileEntry> readRAMBundleProfile(
+  const std::string& path,
+  const RAMBundleProfileKey& key);
+
+/**
+ * Loads the modules of one RAM bundle on a background thread, in the order
+ * they are listed, ahead of the JS thread requiring them. The bundle is
+ * created on the background thread from `bundleFactory`, so it has its own
+ * file handle and doesn't contend with the JS thread's instance.
+ *
+ * It stays at most MAX_MODULES_AHEAD modules ahead of the furthest module the
+ * JS thread asked for, and drops the modules that fell that far behind it
+ * without being asked for, so modules that are never required don't pile up.
+ */
+class RN_EXPORT RAMBundlePrefetcher : noncopyable {
+public:
+  constexpr static size_t MAX_MODULES_AHEAD = 64;
+
+  RAMBundlePrefetcher(
+    std::function<std::unique_ptr<JSModulesUnbundle>()> bundleFactory,
+    std::vector<uint32_t> moduleIds);
+  ~RAMBundlePrefetcher();
+
+  /**
+   * Hands over a prefetched module.  If the module is being loaded right
+   * now, waits for it.  Returns false if the module isn't (or is no longer)
+   * available and the caller should load it itself.
+   */
+  bool takeModule(uint32_t moduleId, JSModulesUnbundle::Module& module);
+
+private:
+  void run(std::function<std::unique_ptr<JSModulesUnbundle>()> bundleFactory);
+
+  std::vector<uint32_t> m_moduleIds;
+  std::unordered_map<uint32_t, size_t> m_positions;
+
+  std::mutex m_mutex;
+  std::condition_variable m_loaded;
+  std::condition_variable m_askedFor;
+  std::unordered_map<uint32_t, JSModulesUnbundle::Module> m_modules;
+  // Modules the JS thread got to first; the background thread skips them.
+  std::unordered_set<uint32_t> m_skipped;
+  // Position in m_moduleIds of the module being loaded.
+  size_t m_next = 0;
+  // One past the position of the furthest module the JS thread asked for.
+  size_t m_askedEnd = 0;
+  bool m_stopped = false;
+
+  std::thread m_thread;
+};
+
+} // namespace react
+} // namespace facebook
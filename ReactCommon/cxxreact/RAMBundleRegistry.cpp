@@ -2,6 +2,8 @@
 
 #include "RAMBundleRegistry.h"
 
+#include <chrono>
+
 #include <folly/Memory.h>
 
 #include <libgen.h>
@@ -42,7 +44,27 @@ JSModulesUnbundle::Module RAMBundleRegistry::getModule(uint32_t bundleId, uint32
     m_bundles.emplace(bundleId, m_factory(bundlePath->second));
   }
 
-  return getBundle(bundleId)->getModule(moduleId);
+  JSModulesUnbundle::Module module;
+  if (bundleId != MAIN_BUNDLE_ID || !m_prefetcher ||
+      !m_prefetcher->takeModule(moduleId, module)) {
+    module = getBundle(bundleId)->getModule(moduleId);
+  }
+  return module;
+}
+
+void RAMBundleRegistry::setProfileRecorder(std::shared_ptr<RAMBundleProfileRecorder> recorder) {
+  m_profileRecorder = std::move(recorder);
+}
+
+void RAMBundleRegistry::recordRequire(uint32_t bundleId, uint32_t moduleId, std::chrono::steady_clock::duration requireTime) {
+  if (m_profileRecorder) {
+    auto requireTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(requireTime);
+    m_profileRecorder->record(bundleId, moduleId, requireTimeUs.count());
+  }
+}
+
+void RAMBundleRegistry::setPrefetcher(std::unique_ptr<RAMBundlePrefetcher> prefetcher) {
+  m_prefetcher = std::move(prefetcher);
 }
 
 JSModulesUnbundle *RAMBundleRegistry::getBundle(uint32_t bundleId) const {
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -9,6 +10,7 @@
 #include <utility>
 
 #include <cxxreact/JSModulesUnbundle.h>
+#include <cxxreact/RAMBundleProfile.h>
 #include <jschelpers/noncopyable.h>
 
 #ifndef RN_EXPORT
@@ -32,6 +34,16 @@ public:
 
   void registerBundle(uint32_t bundleId, bundle_path bundlePath);
   JSModulesUnbundle::Module getModule(uint32_t bundleId, uint32_t moduleId);
+
+  // Records every require reported by recordRequire(), see
+  // RAMBundleProfileRecorder.
+  void setProfileRecorder(std::shared_ptr<RAMBundleProfileRecorder> recorder);
+  // Called by the executor with the time from NATIVE_REQUIRE_START to
+  // NATIVE_REQUIRE_STOP of a require, which loads the module and runs it.
+  void recordRequire(uint32_t bundleId, uint32_t moduleId, std::chrono::steady_clock::duration requireTime);
+  // Serves main bundle modules from the prefetcher when it has them.
+  void setPrefetcher(std::unique_ptr<RAMBundlePrefetcher> prefetcher);
+
   virtual ~RAMBundleRegistry() {};
 private:
   explicit RAMBundleRegistry(unique_ram_bundle mainBundle, std::function<unique_ram_bundle(bundle_path)> factory = {});
@@ -40,6 +52,8 @@ private:
   std::function<unique_ram_bundle(bundle_path)> m_factory;
   std::unordered_map<uint32_t, bundle_path> m_bundlePaths;
   std::unordered_map<uint32_t, unique_ram_bundle> m_bundles;
+  std::shared_ptr<RAMBundleProfileRecorder> m_profileRecorder;
+  std::unique_ptr<RAMBundlePrefetcher> m_prefetcher;
 };
 
 }  // namespace react
@@ -4,6 +4,8 @@
 
 #ifdef WITH_FBSYSTRACE
 #include <fbsystrace.h>
+#else
+#include <cxxreact/TraceRecorder.h>
 #endif
 
 namespace facebook {
@@ -11,8 +13,9 @@ namespace react {
 
 /**
  * This is a convenience class to avoid lots of verbose profiling
- * #ifdefs.  If WITH_FBSYSTRACE is not defined, the optimizer will
- * remove this completely.  If it is defined, it will behave as
+ * #ifdefs.  If WITH_FBSYSTRACE is not defined, it records into the
+ * TraceRecorder while that is enabled, and costs one load otherwise.  If it
+ * is defined, it will behave as
  * FbSystraceSection, with the right tag provided. Use two separate classes to
  * to ensure that the ODR rule isn't violated, that is, if WITH_FBSYSTRACE has
  * different values in different files, there is no inconsistency in the sizes
@@ -32,14 +35,30 @@ private:
 };
 using SystraceSection = ConcreteSystraceSection;
 #else
-struct DummySystraceSection {
+struct RecordingSystraceSection {
 public:
   template<typename... ConvertsToStringPiece>
   explicit
-  DummySystraceSection(const char* name, ConvertsToStringPiece&&... args)
-    {}
+  RecordingSystraceSection(const char* name, ConvertsToStringPiece&&... args)
+    : m_recording(TraceRecorder::isEnabled()) {
+    if (m_recording) {
+      TraceRecorder::beginSection(name, {TraceArg(args)...});
+    }
+  }
+
+  ~RecordingSystraceSection() {
+    if (m_recording) {
+      TraceRecorder::endSection();
+    }
+  }
+
+  RecordingSystraceSection(const RecordingSystraceSection&) = delete;
+  RecordingSystraceSection& operator=(const RecordingSystraceSection&) = delete;
+
+private:
+  bool m_recording;
 };
-using SystraceSection = DummySystraceSection;
+using SystraceSection = RecordingSystraceSection;
 #endif
 
 }}
@@ -0,0 +1,385 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include <glog/logging.h>
+
+namespace facebook {
+namespace react {
+
+std::atomic<bool> TraceRecorder::s_enabled {false};
+
+namespace {
+
+struct Event {
+  uint64_t timestampNs;
+  int64_t value;
+  uint32_t threadId;
+  TraceRecorder::EventType type;
+  char name[51];
+  // Keys and values, separated by '\0'.
+  char args[48];
+};
+
+static constexpr size_t kWordsPerEvent = sizeof(Event) / sizeof(uint64_t);
+static_assert(sizeof(Event) == kWordsPerEvent * sizeof(uint64_t),
+  "Event should be copyable word by word");
+static_assert(offsetof(Event, args) % sizeof(uint64_t) == 0,
+  "args should start a word");
+
+constexpr size_t wordsFor(size_t bytes) {
+  return (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+}
+
+// A seqlock per slot, so that dumps can read slots the writer is reusing
+// without a data race and tell whether what they read is intact.  The
+// sequence is odd while event `n` is being written and `2n + 2` after.
+struct Slot {
+  std::atomic<uint64_t> sequence {0};
+  std::atomic<uint64_t> words[kWordsPerEvent];
+};
+
+// 128 bytes, so a thread's buffer takes 256KB.
+static_assert(sizeof(Slot) == 128, "Slot should fill two cache lines exactly");
+
+static constexpr size_t kEventsPerThread = 2048;
+
+struct ThreadBuffer {
+  // Number of events ever written; the writing thread is the only one to
+  // change it.
+  std::atomic<uint64_t> written {0};
+  // Events before this one were dropped by clear().  Kept apart from
+  // `written` so that clearing never races with the writer.
+  std::atomic<uint64_t> cleared {0};
+  // Whether a live thread owns the buffer.  Buffers of exited threads are
+  // kept for dumping and handed to the next new thread.
+  std::atomic<bool> inUse {true};
+  // Of the owning thread, looked up once since it's a syscall on Linux.
+  uint32_t threadId = 0;
+  Slot slots[kEventsPerThread];
+};
+
+uint32_t currentThreadId() {
+#if defined(__APPLE__)
+  uint64_t tid;
+  pthread_threadid_np(nullptr, &tid);
+  return static_cast<uint32_t>(tid);
+#elif defined(__linux__)
+  return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pthread_self()));
+#endif
+}
+
+uint64_t nowNs() {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return uint64_t(1000000000) * time.tv_sec + time.tv_nsec;
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry() {
+  // Leaked, so that threads recording during static destruction are fine.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+void releaseBuffer(void* buffer) {
+  static_cast<ThreadBuffer*>(buffer)->inUse.store(false, std::memory_order_release);
+}
+
+// A pthread key rather than thread_local, which isn't available on iOS 8.
+pthread_key_t bufferKey() {
+  static pthread_key_t key = [] {
+    pthread_key_t k;
+    CHECK_EQ(0, pthread_key_create(&k, releaseBuffer));
+    return k;
+  }();
+  return key;
+}
+
+ThreadBuffer& threadBuffer() {
+  auto buffer = static_cast<ThreadBuffer*>(pthread_getspecific(bufferKey()));
+  if (buffer) {
+    return *buffer;
+  }
+
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (auto& candidate : reg.buffers) {
+    bool inUse = false;
+    if (candidate->inUse.compare_exchange_strong(inUse, true)) {
+      buffer = candidate.get();
+      break;
+    }
+  }
+  if (!buffer) {
+    reg.buffers.emplace_back(new ThreadBuffer());
+    buffer = reg.buffers.back().get();
+  }
+  buffer->threadId = currentThreadId();
+  pthread_setspecific(bufferKey(), buffer);
+  return *buffer;
+}
+
+size_t copyTruncated(char* dest, size_t capacity, const TraceArg& str) {
+  size_t size = std::min(str.size, capacity - 1);
+  std::memcpy(dest, str.data, size);
+  dest[size] = '\0';
+  return size + 1;
+}
+
+// Writes whether or not recording is enabled.
+void write(
+    TraceRecorder::EventType type,
+    const TraceArg* name,
+    int64_t value,
+    std::initializer_list<TraceArg> args = {}) {
+  // Built on the stack and then stored word by word.
+  union {
+    Event event;
+    uint64_t words[kWordsPerEvent];
+  } local;
+  Event& event = local.event;
+  event.value = value;
+  event.type = type;
+  size_t nameSize = 1;
+  if (name) {
+    nameSize = copyTruncated(event.name, sizeof(event.name), *name);
+  } else {
+    event.name[0] = '\0';
+  }
+
+  size_t pos = 0;
+  for (auto& arg : args) {
+    if (pos + 1 >= sizeof(event.args)) {
+      break;
+    }
+    pos += copyTruncated(event.args + pos, sizeof(event.args) - pos, arg);
+  }
+  // An empty string ends the list.
+  if (pos < sizeof(event.args)) {
+    event.args[pos] = '\0';
+    pos++;
+  } else {
+    event.args[sizeof(event.args) - 1] = '\0';
+  }
+
+  auto& buffer = threadBuffer();
+  event.threadId = buffer.threadId;
+  // Taken last, so that the bytes stored above reach the cache during the
+  // call; reading them back as words right away would stall.
+  event.timestampNs = nowNs();
+  uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  Slot& slot = buffer.slots[index % kEventsPerThread];
+
+  // Only the words up to each terminator are stored; readers stop there.
+  size_t nameWords = wordsFor(offsetof(Event, name) + nameSize);
+  size_t argsWord = offsetof(Event, args) / sizeof(uint64_t);
+  size_t argsWords = wordsFor(offsetof(Event, args) + pos);
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < nameWords; i++) {
+    slot.words[i].store(local.words[i], std::memory_order_relaxed);
+  }
+  for (size_t i = argsWord; i < argsWords; i++) {
+    slot.words[i].store(local.words[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void record(
+    TraceRecorder::EventType type,
+    const TraceArg* name,
+    int64_t value,
+    std::initializer_list<TraceArg> args = {}) {
+  if (TraceRecorder::isEnabled()) {
+    write(type, name, value, args);
+  }
+}
+
+// Copies event `index` out of its slot.  Returns false if the slot holds
+// another event, or the writer touched it during the copy.
+bool readEvent(const ThreadBuffer& buffer, uint64_t index, Event& event) {
+  const Slot& slot = buffer.slots[index % kEventsPerThread];
+  uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if (sequence != 2 * index + 2) {
+    return false;
+  }
+  uint64_t words[kWordsPerEvent];
+  for (size_t i = 0; i < kWordsPerEvent; i++) {
+    words[i] = slot.words[i].load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+    return false;
+  }
+  std::memcpy(&event, words, sizeof(event));
+  return true;
+}
+
+void appendEscaped(std::string& out, const char* str) {
+  out += '"';
+  for (; *str; str++) {
+    unsigned char c = *str;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out += escaped;
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+void appendEvent(std::string& out, const Event& event, pid_t pid) {
+  static const char* phases[] = {"B", "E", "b", "e", "C"};
+
+  char header[128];
+  snprintf(header, sizeof(header),
+    "{\"ph\":\"%s\",\"pid\":%d,\"tid\":%" PRIu32 ",\"ts\":%" PRIu64 ".%03" PRIu64 ",\"name\":",
+    phases[static_cast<size_t>(event.type)], pid, event.threadId,
+    event.timestampNs / 1000, event.timestampNs % 1000);
+  out += header;
+  appendEscaped(out, event.name);
+
+  switch (event.type) {
+    case TraceRecorder::EventType::AsyncBegin:
+    case TraceRecorder::EventType::AsyncEnd:
+      out += ",\"cat\":\"react\",\"id\":";
+      out += std::to_string(event.value);
+      break;
+    case TraceRecorder::EventType::Counter:
+      out += ",\"args\":{";
+      appendEscaped(out, event.name);
+      out += ':';
+      out += std::to_string(event.value);
+      out += '}';
+      break;
+    default:
+      break;
+  }
+
+  if (event.args[0]) {
+    out += ",\"args\":{";
+    const char* arg = event.args;
+    const char* end = event.args + sizeof(event.args);
+    bool first = true;
+    while (arg < end && *arg) {
+      const char* key = arg;
+      arg += strnlen(arg, end - arg) + 1;
+      const char* value = arg < end ? arg : "";
+      arg += arg < end ? strnlen(arg, end - arg) + 1 : 0;
+      if (!first) {
+        out += ',';
+      }
+      first = false;
+      appendEscaped(out, key);
+      out += ':';
+      appendEscaped(out, value);
+    }
+    out += '}';
+  }
+  out += '}';
+}
+
+}
+
+void TraceRecorder::setEnabled(bool enabled) {
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::beginSection(TraceArg name, std::initializer_list<TraceArg> args) {
+  record(EventType::Begin, &name, 0, args);
+}
+
+void TraceRecorder::endSection() {
+  // Threads that never recorded have no section to end.
+  if (isEnabled() || pthread_getspecific(bufferKey())) {
+    write(EventType::End, nullptr, 0);
+  }
+}
+
+void TraceRecorder::beginAsyncSection(TraceArg name, int64_t cookie) {
+  record(EventType::AsyncBegin, &name, cookie);
+}
+
+void TraceRecorder::endAsyncSection(TraceArg name, int64_t cookie) {
+  record(EventType::AsyncEnd, &name, cookie);
+}
+
+void TraceRecorder::counter(TraceArg name, int64_t value) {
+  record(EventType::Counter, &name, value);
+}
+
+std::string TraceRecorder::dumpJSON() {
+  std::vector<ThreadBuffer*> buffers;
+  {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+      buffers.push_back(buffer.get());
+    }
+  }
+
+  pid_t pid = getpid();
+  std::string out = "{\"traceEvents\":[";
+  bool first = true;
+  Event event;
+  for (auto buffer : buffers) {
+    uint64_t end = buffer->written.load(std::memory_order_acquire);
+    uint64_t start = end > kEventsPerThread ? end - kEventsPerThread : 0;
+    start = std::max(start, buffer->cleared.load(std::memory_order_relaxed));
+    for (uint64_t i = start; i < end; i++) {
+      if (!readEvent(*buffer, i, event)) {
+        continue;
+      }
+      if (!first) {
+        out += ',';
+      }
+      first = false;
+      appendEvent(out, event, pid);
+    }
+  }
+  out += "]}";
+  return out;
+}
+
+void TraceRecorder::clear() {
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (auto& buffer : reg.buffers) {
+    buffer->cleared.store(
+      buffer->written.load(std::memory_order_acquire),
+      std::memory_order_relaxed);
+  }
+}
+
+} // namespace react
+} // namespace facebook
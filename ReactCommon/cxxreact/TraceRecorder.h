@@ -0,0 +1,93 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+#ifndef RN_EXPORT
+#define RN_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace facebook {
+namespace react {
+
+/**
+ * A string argument to a trace event.  Doesn't own the characters; they are
+ * copied into the trace buffer when the event is recorded.
+ */
+struct TraceArg {
+  TraceArg(const char* str) : data(str), size(std::strlen(str)) {}
+  TraceArg(const std::string& str) : data(str.data()), size(str.size()) {}
+  TraceArg(const char* str, size_t len) : data(str), size(len) {}
+
+  const char* data;
+  size_t size;
+};
+
+/**
+ * TraceRecorder
+ *
+ * Records trace events in process, for builds without fbsystrace.  Each
+ * thread writes to its own fixed size ring buffer, without locks, so the
+ * most recent events of every thread are kept.  Names and arguments are
+ * copied, truncated if needed, so they don't have to outlive the call.
+ *
+ * Recording is off until setEnabled(true), and costs a single relaxed load
+ * per event while off.  Buffers are only allocated for threads that record
+ * while enabled.
+ *
+ * While on, an event should cost under 50ns, and reading the clock is most
+ * of that.  The rest takes about 16ns on a Linux x86 VM.  There
+ * clock_gettime takes 30-35ns, so events take 46-51ns and the budget is met
+ * only where the clock is at the faster end.
+ *
+ * JS sections are only recorded while Systrace.js is enabled as well.  JSC
+ * contexts created while recording start with it enabled; for others, call
+ * Systrace.setEnabled(true) from JS.
+ */
+class RN_EXPORT TraceRecorder {
+public:
+  enum class EventType : uint8_t {
+    Begin,
+    End,
+    AsyncBegin,
+    AsyncEnd,
+    Counter,
+  };
+
+  static bool isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+  static void setEnabled(bool enabled);
+
+  // Events recorded while disabled are dropped, except the ends of
+  // sections: those are kept on threads that recorded before, so that a
+  // section begun before recording was turned off still ends.  `args` are
+  // alternating keys and values.
+  static void beginSection(TraceArg name, std::initializer_list<TraceArg> args = {});
+  static void endSection();
+  static void beginAsyncSection(TraceArg name, int64_t cookie);
+  static void endAsyncSection(TraceArg name, int64_t cookie);
+  static void counter(TraceArg name, int64_t value);
+
+  /**
+   * Returns the recorded events in the Chrome trace event format, which
+   * chrome://tracing and Perfetto open.  Can be called from any thread
+   * while recording; events being overwritten during the dump are skipped.
+   */
+  static std::string dumpJSON();
+
+  // Drops the events recorded so far.  Can be called from any thread while
+  // recording; events recorded meanwhile may or may not be dropped.
+  static void clear();
+
+private:
+  static std::atomic<bool> s_enabled;
+};
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,342 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+// Measures the bridge from Instance down to CxxNativeModule, with a scripted
+// JSExecutor standing in for JS, so that it runs on any host.
+//
+// Each scenario reports throughput, the latency of single calls from the
+// moment they're made to the moment they arrive, and heap allocations per
+// call, counted by replacing the global operator new.  Allocations are also
+// broken down by bridge operation, through BridgeAllocations.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <folly/Memory.h>
+#include <glog/logging.h>
+#include <cxxreact/BridgeAllocations.h>
+#include <cxxreact/CxxModule.h>
+#include <cxxreact/CxxNativeModule.h>
+#include <cxxreact/Instance.h>
+#include <cxxreact/JSBigString.h>
+#include <cxxreact/JSExecutor.h>
+#include <cxxreact/MessageQueueThread.h>
+#include <cxxreact/ModuleRegistry.h>
+
+using namespace facebook;
+using namespace facebook::react;
+using facebook::xplat::module::CxxModule;
+
+static std::atomic<uint64_t> allocations {0};
+
+void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  BridgeAllocations::recordAllocation(size);
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class QueueThread : public MessageQueueThread {
+public:
+  QueueThread() : m_thread([this] { run(); }) {}
+
+  ~QueueThread() {
+    quitSynchronous();
+    m_thread.join();
+  }
+
+  void runOnQueue(std::function<void()>&& task) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+    m_cv.notify_all();
+  }
+
+  void runOnQueueSync(std::function<void()>&& task) override {
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+      task();
+      return;
+    }
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    bool done = false;
+    runOnQueue([&] {
+      task();
+      std::lock_guard<std::mutex> lock(doneMutex);
+      done = true;
+      doneCv.notify_all();
+    });
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCv.wait(lock, [&] { return done; });
+  }
+
+  void quitSynchronous() override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+    m_cv.notify_all();
+  }
+
+private:
+  void run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_cv.wait(lock, [this] { return m_quit || !m_tasks.empty(); });
+      if (m_quit) {
+        return;
+      }
+      auto task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::function<void()>> m_tasks;
+  bool m_quit = false;
+  std::thread m_thread;
+};
+
+// Latencies of one scenario.  Each scenario records from a single thread.
+class Latencies {
+public:
+  void reset(size_t expected) {
+    m_latenciesNs.clear();
+    m_latenciesNs.reserve(expected);
+    m_count.store(0);
+  }
+
+  void add(int64_t latencyNs) {
+    m_latenciesNs.push_back(latencyNs);
+    m_count.fetch_add(1, std::memory_order_release);
+  }
+
+  void waitFor(size_t count) {
+    while (m_count.load(std::memory_order_acquire) < count) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Sorts, so only call once everything arrived.
+  int64_t percentile(double percentile) {
+    std::sort(m_latenciesNs.begin(), m_latenciesNs.end());
+    auto index = static_cast<size_t>(percentile * (m_latenciesNs.size() - 1));
+    return m_latenciesNs[index];
+  }
+
+private:
+  std::vector<int64_t> m_latenciesNs;
+  std::atomic<size_t> m_count {0};
+};
+
+Latencies latencies;
+
+constexpr unsigned int kNoopMethod = 0;
+constexpr unsigned int kSyncMethod = 1;
+
+struct BenchModule : CxxModule {
+  std::string getName() override {
+    return "Bench";
+  }
+  std::vector<Method> getMethods() override {
+    return {
+      Method("noop", [](folly::dynamic args) {
+        latencies.add(nowNs() - args[0].asInt());
+      }),
+      Method("sync", [](folly::dynamic args) {
+        return args[0];
+      }, SyncTag),
+    };
+  }
+};
+
+// Plays the part of the JS bundle:
+// - Bench.call(timestamp) records the time it took to get here.
+// - Bench.batch(size) calls Bench.noop `size` times, in one batch.
+// - Bench.sync(count) makes `count` sync hook calls, timing each.
+// - Callbacks record the time it took to get here, like Bench.call.
+class ScriptedExecutor : public JSExecutor {
+public:
+  explicit ScriptedExecutor(std::shared_ptr<ExecutorDelegate> delegate)
+    : m_delegate(std::move(delegate)) {}
+
+  void loadApplicationScript(std::unique_ptr<const JSBigString>, std::string) override {
+    auto config = m_delegate->getModuleRegistry()->getConfig("Bench");
+    CHECK(config);
+    m_moduleId = config->index;
+  }
+
+  void callFunction(const std::string&, const std::string& method, const folly::dynamic& args) override {
+    if (method == "call") {
+      latencies.add(nowNs() - args[0].asInt());
+    } else if (method == "batch") {
+      auto size = args[0].asInt();
+      auto moduleIds = folly::dynamic::array();
+      auto methodIds = folly::dynamic::array();
+      auto params = folly::dynamic::array();
+      auto timestamp = nowNs();
+      for (int64_t i = 0; i < size; i++) {
+        moduleIds.push_back(m_moduleId);
+        methodIds.push_back(kNoopMethod);
+        params.push_back(folly::dynamic::array(timestamp));
+      }
+      m_delegate->callNativeModules(
+        *this,
+        folly::dynamic::array(std::move(moduleIds), std::move(methodIds), std::move(params)),
+        true);
+    } else if (method == "sync") {
+      auto count = args[0].asInt();
+      for (int64_t i = 0; i < count; i++) {
+        auto start = nowNs();
+        m_delegate->callSerializableNativeHook(
+          *this, m_moduleId, kSyncMethod, folly::dynamic::array(i));
+        latencies.add(nowNs() - start);
+      }
+    }
+  }
+
+  void invokeCallback(const double, const folly::dynamic& args) override {
+    latencies.add(nowNs() - args[0].asInt());
+  }
+
+  void setBundleRegistry(std::unique_ptr<RAMBundleRegistry>) override {}
+  void registerBundle(uint32_t, const std::string&) override {}
+  void setGlobalVariable(std::string, std::unique_ptr<const JSBigString>) override {}
+  std::string getDescription() override {
+    return "ScriptedExecutor";
+  }
+
+private:
+  std::shared_ptr<ExecutorDelegate> m_delegate;
+  int64_t m_moduleId = 0;
+};
+
+struct ScriptedExecutorFactory : JSExecutorFactory {
+  std::unique_ptr<JSExecutor> createJSExecutor(
+      std::shared_ptr<ExecutorDelegate> delegate,
+      std::shared_ptr<MessageQueueThread>) override {
+    return folly::make_unique<ScriptedExecutor>(std::move(delegate));
+  }
+};
+
+// Runs `issue`, which makes `calls` calls, and prints how they went.
+template <typename F>
+void measure(const char* name, size_t calls, F&& issue) {
+  latencies.reset(calls);
+  BridgeAllocations::reset();
+  auto startAllocations = allocations.load();
+  auto start = nowNs();
+  issue();
+  latencies.waitFor(calls);
+  auto elapsedNs = nowNs() - start;
+  auto callAllocations = allocations.load() - startAllocations;
+
+  printf("%-28s %10zu %12.0f %10lld %10lld %10lld %10.1f\n",
+    name, calls, calls * 1e9 / elapsedNs,
+    static_cast<long long>(latencies.percentile(0.5)),
+    static_cast<long long>(latencies.percentile(0.99)),
+    static_cast<long long>(latencies.percentile(1.0)),
+    static_cast<double>(callAllocations) / calls);
+
+  static const std::pair<BridgeOperation, const char*> operations[] = {
+    {BridgeOperation::CallFunction, "NativeToJsBridge::callFunction"},
+    {BridgeOperation::CallNativeModules, "JsToNativeBridge::callNativeModules"},
+    {BridgeOperation::InvokeNativeMethod, "CxxNativeModule::invoke"},
+  };
+  for (auto& operation : operations) {
+    auto stats = BridgeAllocations::stats(operation.first);
+    if (stats.operations > 0) {
+      printf("  %-38s %10.1f allocs/op %10.1f bytes/op\n",
+        operation.second,
+        static_cast<double>(stats.allocations) / stats.operations,
+        static_cast<double>(stats.bytes) / stats.operations);
+    }
+  }
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t calls = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+  BridgeAllocations::setEnabled(true);
+
+  auto nativeQueue = std::make_shared<QueueThread>();
+  auto jsQueue = std::make_shared<QueueThread>();
+  std::vector<std::unique_ptr<NativeModule>> modules;
+  modules.push_back(folly::make_unique<CxxNativeModule>(
+    std::weak_ptr<Instance>(), "Bench",
+    [] { return folly::make_unique<BenchModule>(); },
+    nativeQueue));
+
+  auto instance = std::make_shared<Instance>();
+  instance->initializeBridge(
+    folly::make_unique<InstanceCallback>(),
+    std::make_shared<ScriptedExecutorFactory>(),
+    jsQueue,
+    std::make_shared<ModuleRegistry>(std::move(modules)),
+    instance);
+  instance->loadScriptFromString(
+    folly::make_unique<JSBigStdString>(""), "bench.js", false);
+
+  printf("%-28s %10s %12s %10s %10s %10s %10s\n",
+    "scenario", "calls", "calls/s", "p50 ns", "p99 ns", "max ns", "allocs");
+
+  measure("callFunction", calls, [&] {
+    for (size_t i = 0; i < calls; i++) {
+      instance->callJSFunction("Bench", "call", folly::dynamic::array(nowNs()));
+    }
+  });
+
+  measure("invokeCallback", calls, [&] {
+    for (size_t i = 0; i < calls; i++) {
+      instance->callJSCallback(i, folly::dynamic::array(nowNs()));
+    }
+  });
+
+  for (size_t batchSize : {1, 10, 100}) {
+    char name[64];
+    snprintf(name, sizeof(name), "callNativeModules x%zu", batchSize);
+    size_t batches = calls / batchSize;
+    measure(name, batches * batchSize, [&] {
+      for (size_t i = 0; i < batches; i++) {
+        instance->callJSFunction(
+          "Bench", "batch", folly::dynamic::array(static_cast<int64_t>(batchSize)));
+      }
+    });
+  }
+
+  measure("callSerializableNativeHook", calls, [&] {
+    instance->callJSFunction(
+      "Bench", "sync", folly::dynamic::array(static_cast<int64_t>(calls)));
+  });
+
+  instance->destroy();
+  return 0;
+}
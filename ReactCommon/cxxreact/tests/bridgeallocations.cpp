@@ -0,0 +1,81 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <cxxreact/BridgeAllocations.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+struct BridgeAllocationsTest : ::testing::Test {
+  void SetUp() override {
+    BridgeAllocations::setEnabled(true);
+    BridgeAllocations::reset();
+  }
+
+  void TearDown() override {
+    BridgeAllocations::setEnabled(false);
+    BridgeAllocations::reset();
+  }
+};
+
+}
+
+TEST_F(BridgeAllocationsTest, ChargesOpenScope) {
+  BridgeAllocations::recordAllocation(8);
+  {
+    BridgeAllocations::Scope scope(BridgeOperation::CallFunction);
+    BridgeAllocations::recordAllocation(16);
+    BridgeAllocations::recordAllocation(32);
+  }
+  BridgeAllocations::recordAllocation(64);
+
+  auto stats = BridgeAllocations::stats(BridgeOperation::CallFunction);
+  ASSERT_EQ(1, stats.operations);
+  ASSERT_EQ(2, stats.allocations);
+  ASSERT_EQ(48, stats.bytes);
+}
+
+TEST_F(BridgeAllocationsTest, ChargesInnermostScope) {
+  {
+    BridgeAllocations::Scope outer(BridgeOperation::CallNativeModules);
+    BridgeAllocations::recordAllocation(10);
+    for (int i = 0; i < 3; i++) {
+      BridgeAllocations::Scope inner(BridgeOperation::InvokeNativeMethod);
+      BridgeAllocations::recordAllocation(100);
+    }
+    BridgeAllocations::recordAllocation(10);
+  }
+
+  auto batches = BridgeAllocations::stats(BridgeOperation::CallNativeModules);
+  ASSERT_EQ(1, batches.operations);
+  ASSERT_EQ(2, batches.allocations);
+  ASSERT_EQ(20, batches.bytes);
+
+  auto invokes = BridgeAllocations::stats(BridgeOperation::InvokeNativeMethod);
+  ASSERT_EQ(3, invokes.operations);
+  ASSERT_EQ(3, invokes.allocations);
+  ASSERT_EQ(300, invokes.bytes);
+}
+
+TEST_F(BridgeAllocationsTest, IgnoresOtherThreads) {
+  BridgeAllocations::Scope scope(BridgeOperation::CallFunction);
+  std::thread([] { BridgeAllocations::recordAllocation(16); }).join();
+
+  ASSERT_EQ(0, BridgeAllocations::stats(BridgeOperation::CallFunction).allocations);
+}
+
+TEST_F(BridgeAllocationsTest, CountsNothingWhileDisabled) {
+  BridgeAllocations::setEnabled(false);
+  {
+    BridgeAllocations::Scope scope(BridgeOperation::CallFunction);
+    BridgeAllocations::recordAllocation(16);
+  }
+
+  auto stats = BridgeAllocations::stats(BridgeOperation::CallFunction);
+  ASSERT_EQ(0, stats.operations);
+  ASSERT_EQ(0, stats.allocations);
+}
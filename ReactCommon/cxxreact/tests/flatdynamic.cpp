@@ -0,0 +1,82 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <cxxreact/FlatDynamic.h>
+
+#include <folly/dynamic.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace folly;
+using namespace facebook::react;
+
+TEST(FlatDynamicTest, Scalars) {
+  auto flat = flattenDynamic(dynamic::array(nullptr, true, false, 7, 2.5, "word"));
+  EXPECT_EQ(flat.ops, (vector<int32_t>{
+    FlatDynamic::Array, 6,
+    FlatDynamic::Null,
+    FlatDynamic::True,
+    FlatDynamic::False,
+    FlatDynamic::Number,
+    FlatDynamic::Number,
+    FlatDynamic::String, 0,
+  }));
+  EXPECT_EQ(flat.numbers, (vector<double>{7, 2.5}));
+  EXPECT_EQ(flat.strings, (vector<string>{"word"}));
+}
+
+TEST(FlatDynamicTest, RoundTrip) {
+  dynamic value = dynamic::object
+    ("name", "view")
+    ("hidden", false)
+    ("opacity", 0.5)
+    ("children", dynamic::array(
+      dynamic::object("name", "text")("lines", dynamic::array(1.0, 2.0)),
+      nullptr,
+      dynamic::array()));
+
+  EXPECT_EQ(unflattenDynamic(flattenDynamic(value)), value);
+}
+
+TEST(FlatDynamicTest, SharesStrings) {
+  dynamic value = dynamic::array(
+    dynamic::object("width", 1.0)("height", 2.0),
+    dynamic::object("width", 3.0)("height", "width"));
+
+  auto flat = flattenDynamic(value);
+  EXPECT_EQ(flat.strings.size(), 2);
+  EXPECT_EQ(unflattenDynamic(flat), value);
+}
+
+TEST(FlatDynamicTest, IntegersBecomeDoubles) {
+  auto value = unflattenDynamic(flattenDynamic(dynamic::array(3)));
+  ASSERT_TRUE(value[0].isDouble());
+  EXPECT_EQ(value[0].getDouble(), 3.0);
+}
+
+TEST(FlatDynamicTest, RejectsMalformedInput) {
+  FlatDynamic truncated;
+  truncated.ops = {FlatDynamic::Array, 2, FlatDynamic::Null};
+  EXPECT_THROW(unflattenDynamic(truncated), invalid_argument);
+
+  FlatDynamic hugeSize;
+  hugeSize.ops = {FlatDynamic::Object, 1 << 30};
+  EXPECT_THROW(unflattenDynamic(hugeSize), invalid_argument);
+
+  FlatDynamic badString;
+  badString.ops = {FlatDynamic::String, 1};
+  badString.strings = {"only"};
+  EXPECT_THROW(unflattenDynamic(badString), invalid_argument);
+
+  FlatDynamic missingNumber;
+  missingNumber.ops = {FlatDynamic::Number};
+  EXPECT_THROW(unflattenDynamic(missingNumber), invalid_argument);
+
+  FlatDynamic trailing;
+  trailing.ops = {FlatDynamic::Null, FlatDynamic::Null};
+  EXPECT_THROW(unflattenDynamic(trailing), invalid_argument);
+
+  FlatDynamic badTag;
+  badTag.ops = {42};
+  EXPECT_THROW(unflattenDynamic(badTag), invalid_argument);
+}
@@ -0,0 +1,158 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <cxxreact/CxxModule.h>
+#include <cxxreact/JsArgumentDecoders.h>
+
+#include <folly/dynamic.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace folly;
+using namespace facebook::xplat;
+using facebook::xplat::module::CxxModule;
+
+#define EXPECT_JSAE(statement, exstr) do {                              \
+    try {                                                               \
+      statement;                                                        \
+      FAIL() << "Expected JsArgumentException(" << (exstr) << ") not thrown"; \
+    } catch (const JsArgumentException& ex) {                           \
+      EXPECT_EQ(ex.what(), std::string(exstr));                         \
+    }                                                                   \
+  } while(0) // let any other exception escape, gtest will deal.
+
+namespace {
+
+struct Point {
+  double x;
+  double y;
+  RN_JS_FIELDS(Point, x, y)
+};
+
+struct Label {
+  string text;
+  Optional<double> size;
+  RN_JS_FIELDS(Label, text, size)
+};
+
+struct Recorder {
+  int64_t anInt = 0;
+  string aString;
+  vector<Point> points;
+  Optional<bool> maybe;
+  dynamic callbackArgs = nullptr;
+
+  void numbers(int64_t i, string s) {
+    anInt = i;
+    aString = std::move(s);
+  }
+
+  void shapes(vector<Point> p, Optional<bool> m) {
+    points = std::move(p);
+    maybe = m;
+  }
+
+  void withCallback(int32_t i, CxxModule::Callback callback) {
+    callback({i * 2});
+  }
+};
+
+template <typename T>
+T decode(dynamic arg) {
+  return JsArgumentDecoder<T>::decode(arg, 0);
+}
+
+}
+
+TEST(JsArgumentDecodersTest, scalars) {
+  EXPECT_EQ(decode<bool>(true), true);
+  EXPECT_EQ(decode<int64_t>(17), 17);
+  EXPECT_EQ(decode<int32_t>(17.0), 17);
+  EXPECT_EQ(decode<double>(3.5), 3.5);
+  EXPECT_EQ(decode<double>(3), 3.0);
+  EXPECT_EQ(decode<string>("word"), "word");
+  EXPECT_EQ(decode<dynamic>(dynamic::array(1, 2)), dynamic::array(1, 2));
+
+  EXPECT_JSAE(decode<bool>(1),
+              "Error converting javascript arg 0 to C++: expected boolean, got int64");
+  EXPECT_JSAE(decode<int64_t>(1.5),
+              "Error converting javascript arg 0 to C++: expected integer, got double");
+  EXPECT_JSAE(decode<string>(nullptr),
+              "Error converting javascript arg 0 to C++: expected string, got null");
+  EXPECT_THROW(decode<int8_t>(1000), JsArgumentException);
+}
+
+TEST(JsArgumentDecodersTest, integersFromDoubles) {
+  EXPECT_EQ(decode<int64_t>(-9223372036854775808.0), numeric_limits<int64_t>::min());
+  EXPECT_EQ(decode<int64_t>(-0.0), 0);
+
+  EXPECT_JSAE(decode<int64_t>(numeric_limits<double>::quiet_NaN()),
+              "Error converting javascript arg 0 to C++: expected integer, got double");
+  EXPECT_JSAE(decode<int64_t>(numeric_limits<double>::infinity()),
+              "Error converting javascript arg 0 to C++: expected integer, got double");
+  EXPECT_THROW(decode<int64_t>(9223372036854775808.0), JsArgumentException);
+  EXPECT_THROW(decode<int64_t>(1e300), JsArgumentException);
+  EXPECT_THROW(decode<int32_t>(-1e19), JsArgumentException);
+}
+
+TEST(JsArgumentDecodersTest, containers) {
+  EXPECT_EQ(decode<vector<int64_t>>(dynamic::array(1, 2, 3)), (vector<int64_t>{1, 2, 3}));
+  EXPECT_FALSE(decode<Optional<string>>(nullptr).hasValue());
+  EXPECT_EQ(decode<Optional<string>>("word").value(), "word");
+
+  auto point = decode<Point>(dynamic::object("x", 1.5)("y", 2));
+  EXPECT_EQ(point.x, 1.5);
+  EXPECT_EQ(point.y, 2.0);
+
+  EXPECT_JSAE(decode<Point>(dynamic::object("x", 1.5)),
+              "Error converting javascript arg 0 to C++: missing field y");
+
+  auto label = decode<Label>(dynamic::object("text", "hi"));
+  EXPECT_EQ(label.text, "hi");
+  EXPECT_FALSE(label.size.hasValue());
+  EXPECT_EQ(decode<Label>(dynamic::object("text", "hi")("size", 12)).size.value(), 12.0);
+  EXPECT_FALSE(decode<Label>(dynamic::object("text", "hi")("size", nullptr)).size.hasValue());
+  EXPECT_JSAE(decode<Label>(dynamic::object("size", 12)),
+              "Error converting javascript arg 0 to C++: missing field text");
+  EXPECT_JSAE(decode<vector<int64_t>>(dynamic::array(1, "2")),
+              "Error converting javascript arg 0 to C++: expected number, got string");
+}
+
+TEST(JsArgumentDecodersTest, signatures) {
+  EXPECT_EQ(JsArgumentDecoder<Point>::signature(), "{x:number,y:number}");
+  EXPECT_EQ(JsArgumentDecoder<vector<Optional<string>>>::signature(), "[?string]");
+}
+
+TEST(JsArgumentDecodersTest, typedMethods) {
+  Recorder recorder;
+
+  CxxModule::Method numbers("numbers", &recorder, &Recorder::numbers);
+  EXPECT_EQ(numbers.callbacks, 0);
+  EXPECT_EQ(numbers.signature, "(number,string)");
+  numbers.func(dynamic::array(5, "five"), nullptr, nullptr);
+  EXPECT_EQ(recorder.anInt, 5);
+  EXPECT_EQ(recorder.aString, "five");
+
+  CxxModule::Method shapes("shapes", &recorder, &Recorder::shapes);
+  EXPECT_EQ(shapes.signature, "([{x:number,y:number}],?boolean)");
+  shapes.func(
+    dynamic::array(dynamic::array(dynamic::object("x", 1)("y", 2)), true),
+    nullptr, nullptr);
+  ASSERT_EQ(recorder.points.size(), 1);
+  EXPECT_EQ(recorder.points[0].y, 2.0);
+  EXPECT_EQ(recorder.maybe.value(), true);
+
+  CxxModule::Method withCallback("withCallback", &recorder, &Recorder::withCallback);
+  EXPECT_EQ(withCallback.callbacks, 1);
+  EXPECT_EQ(withCallback.signature, "(number)");
+  withCallback.func(
+    dynamic::array(21),
+    [&](vector<dynamic> args) { recorder.callbackArgs = args[0]; },
+    nullptr);
+  EXPECT_EQ(recorder.callbackArgs, 42);
+
+  EXPECT_JSAE(numbers.func(dynamic::array(5), nullptr, nullptr),
+              "JavaScript provided 1 arguments for C++ method which takes 2 arguments");
+  EXPECT_JSAE(numbers.func(dynamic::array("5", "five"), nullptr, nullptr),
+              "Error converting javascript arg 0 to C++: expected number, got string");
+}
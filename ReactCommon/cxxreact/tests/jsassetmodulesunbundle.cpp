@@ -0,0 +1,90 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <fstream>
+#include <iterator>
+#include <stdlib.h>
+
+#include <folly/Memory.h>
+#include <gtest/gtest.h>
+#include <cxxreact/JSAssetModulesUnbundle.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+struct FileAsset : JSAssetModulesUnbundle::Asset {
+  std::vector<char> contents;
+
+  const char* data() const override {
+    return contents.data();
+  }
+  size_t size() const override {
+    return contents.size();
+  }
+};
+
+// Stands in for the Android asset manager, with assets as plain files.
+struct FileModulesUnbundle : JSAssetModulesUnbundle {
+  mutable std::vector<const char*> buffers;
+
+  using JSAssetModulesUnbundle::JSAssetModulesUnbundle;
+
+  std::unique_ptr<Asset> openAsset(const char* assetName) const override {
+    std::ifstream file(assetName, std::ios_base::in | std::ios_base::binary);
+    if (!file) {
+      return nullptr;
+    }
+    auto asset = folly::make_unique<FileAsset>();
+    asset->contents.assign(
+      std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    buffers.push_back(asset->data());
+    return std::move(asset);
+  }
+};
+
+std::string makeModuleDir() {
+  std::string tmp {getenv("TMPDIR")};
+  tmp += "/js-modules.XXXXXX";
+
+  std::vector<char> tmpBuf {tmp.begin(), tmp.end()};
+  tmpBuf.push_back('\0');
+  return std::string(mkdtemp(tmpBuf.data())) + "/";
+}
+
+void writeAsset(const std::string& path, const std::string& contents) {
+  std::ofstream file(path, std::ios_base::out | std::ios_base::binary);
+  file << contents;
+}
+
+}
+
+TEST(JSAssetModulesUnbundle, UsesTerminatedAssetInPlace) {
+  std::string dir = makeModuleDir();
+  writeAsset(dir + "42.js", std::string("__d(42)", 8));
+
+  FileModulesUnbundle unbundle(dir);
+  auto module = unbundle.getModule(42);
+  ASSERT_EQ("42.js", module.name);
+  ASSERT_EQ(7, module.code->size());
+  ASSERT_STREQ("__d(42)", module.code->c_str());
+  ASSERT_EQ(1, unbundle.buffers.size());
+  ASSERT_EQ(unbundle.buffers[0], module.code->c_str());
+}
+
+TEST(JSAssetModulesUnbundle, CopiesUnterminatedAsset) {
+  std::string dir = makeModuleDir();
+  writeAsset(dir + "7.js", "__d(7)");
+
+  FileModulesUnbundle unbundle(dir);
+  auto module = unbundle.getModule(7);
+  ASSERT_EQ("7.js", module.name);
+  ASSERT_EQ(6, module.code->size());
+  ASSERT_STREQ("__d(7)", module.code->c_str());
+  ASSERT_NE(unbundle.buffers[0], module.code->c_str());
+}
+
+TEST(JSAssetModulesUnbundle, MissingModule) {
+  FileModulesUnbundle unbundle(makeModuleDir());
+  ASSERT_THROW(unbundle.getModule(3), JSModulesUnbundle::ModuleNotFound);
+}
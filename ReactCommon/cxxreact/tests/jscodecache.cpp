@@ -0,0 +1,138 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <cxxreact/JSBigString.h>
+#include <cxxreact/JSCodeCache.h>
+#include <cxxreact/JSExecutor.h>
+#include <cxxreact/Platform.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+std::vector<ReactMarker::ReactMarkerId> loggedMarkers;
+
+void recordMarker(const ReactMarker::ReactMarkerId markerId, const char* tag) {
+  loggedMarkers.push_back(markerId);
+}
+
+// Pretends that the compiled form of a script is the script text reversed.
+struct FakeExecutor : JSExecutor {
+  std::string version = "fake-1";
+  std::string lastScript;
+  std::string lastCode;
+
+  void loadApplicationScript(std::unique_ptr<const JSBigString> script,
+                             std::string sourceURL) override {
+    lastScript = script->c_str();
+  }
+  std::unique_ptr<const JSBigString> getCodeCache() override {
+    return std::unique_ptr<const JSBigString>(
+      new JSBigStdString(std::string(lastScript.rbegin(), lastScript.rend())));
+  }
+  void loadApplicationCodeCache(std::unique_ptr<const JSBigString> code,
+                                std::string sourceURL) override {
+    lastCode.assign(code->c_str(), code->size());
+  }
+  std::string getCodeCacheVersion() override {
+    return version;
+  }
+
+  void setBundleRegistry(std::unique_ptr<RAMBundleRegistry>) override {}
+  void registerBundle(uint32_t, const std::string&) override {}
+  void callFunction(const std::string&, const std::string&, const folly::dynamic&) override {}
+  void invokeCallback(const double, const folly::dynamic&) override {}
+  void setGlobalVariable(std::string, std::unique_ptr<const JSBigString>) override {}
+  std::string getDescription() override {
+    return "FakeExecutor";
+  }
+};
+
+std::unique_ptr<const JSBigString> makeScript(std::string text) {
+  return std::unique_ptr<const JSBigString>(new JSBigStdString(std::move(text)));
+}
+
+std::string makeCacheDir() {
+  std::string tmp {getenv("TMPDIR")};
+  tmp += "/codecache.XXXXXX";
+
+  std::vector<char> tmpBuf {tmp.begin(), tmp.end()};
+  tmpBuf.push_back('\0');
+  return mkdtemp(tmpBuf.data());
+}
+
+}
+
+class JSCodeCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ReactMarker::logTaggedMarker = recordMarker;
+    loggedMarkers.clear();
+  }
+};
+
+TEST_F(JSCodeCacheTest, MissThenHit) {
+  JSCodeCache cache {makeCacheDir()};
+  FakeExecutor executor;
+
+  cache.loadApplicationScript(executor, makeScript("abc"), "/bundles/main.jsbundle");
+  ASSERT_EQ("abc", executor.lastScript);
+  ASSERT_EQ("", executor.lastCode);
+
+  executor.lastScript.clear();
+  cache.loadApplicationScript(executor, makeScript("abc"), "/bundles/main.jsbundle");
+  ASSERT_EQ("", executor.lastScript);
+  ASSERT_EQ("cba", executor.lastCode);
+
+  ASSERT_EQ(2, loggedMarkers.size());
+  ASSERT_EQ(ReactMarker::JS_CODE_CACHE_MISS, loggedMarkers[0]);
+  ASSERT_EQ(ReactMarker::JS_CODE_CACHE_HIT, loggedMarkers[1]);
+}
+
+TEST_F(JSCodeCacheTest, ChangedScriptIsAMiss) {
+  JSCodeCache cache {makeCacheDir()};
+  FakeExecutor executor;
+
+  cache.loadApplicationScript(executor, makeScript("abc"), "main.jsbundle");
+  cache.loadApplicationScript(executor, makeScript("abcd"), "main.jsbundle");
+  ASSERT_EQ("abcd", executor.lastScript);
+  ASSERT_EQ("", executor.lastCode);
+
+  // The entry was replaced by the new script's code.
+  cache.loadApplicationScript(executor, makeScript("abcd"), "main.jsbundle");
+  ASSERT_EQ("dcba", executor.lastCode);
+}
+
+TEST_F(JSCodeCacheTest, VersionMismatchFallsBack) {
+  std::string dir = makeCacheDir();
+  JSCodeCache cache {dir};
+  FakeExecutor executor;
+
+  cache.loadApplicationScript(executor, makeScript("abc"), "main.jsbundle");
+
+  JSCodeCache::LoadStatus status;
+  auto code = cache.load("main.jsbundle", JSCodeCache::hashScript(*makeScript("abc")), "fake-2", status);
+  ASSERT_EQ(nullptr, code);
+  ASSERT_EQ(JSCodeCache::LoadStatus::VersionMismatch, status);
+
+  // The stale entry is gone.
+  code = cache.load("main.jsbundle", JSCodeCache::hashScript(*makeScript("abc")), "fake-1", status);
+  ASSERT_EQ(nullptr, code);
+  ASSERT_EQ(JSCodeCache::LoadStatus::Miss, status);
+}
+
+TEST_F(JSCodeCacheTest, UnsupportedExecutorBypassesCache) {
+  JSCodeCache cache {makeCacheDir()};
+  FakeExecutor executor;
+  executor.version = "";
+
+  cache.loadApplicationScript(executor, makeScript("abc"), "main.jsbundle");
+  cache.loadApplicationScript(executor, makeScript("abc"), "main.jsbundle");
+  ASSERT_EQ("abc", executor.lastScript);
+  ASSERT_EQ("", executor.lastCode);
+  ASSERT_TRUE(loggedMarkers.empty());
+}
@@ -0,0 +1,96 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <cxxreact/JSCTracing.h>
+#include <cxxreact/TraceRecorder.h>
+#include <jschelpers/JSCHelpers.h>
+#include <jschelpers/Value.h>
+
+using namespace facebook::react;
+
+// With fbsystrace, the hooks write to it instead of the recorder.
+#ifndef WITH_FBSYSTRACE
+
+#ifdef ANDROID
+#include <android/looper.h>
+static void prepare() {
+  ALooper_prepare(0);
+}
+#else
+static void prepare() {}
+#endif
+
+namespace {
+
+struct JSCTracingTest : ::testing::Test {
+  void SetUp() override {
+    prepare();
+    TraceRecorder::setEnabled(false);
+    TraceRecorder::clear();
+  }
+
+  void TearDown() override {
+    TraceRecorder::setEnabled(false);
+    TraceRecorder::clear();
+  }
+};
+
+Value evaluate(JSGlobalContextRef ctx, const char* script) {
+  return Value(ctx, evaluateScript(ctx, String(ctx, script), String(ctx, "test.js")));
+}
+
+size_t count(const std::string& str, const std::string& needle) {
+  size_t n = 0;
+  for (auto pos = str.find(needle); pos != std::string::npos;
+       pos = str.find(needle, pos + 1)) {
+    n++;
+  }
+  return n;
+}
+
+}
+
+TEST_F(JSCTracingTest, EnablesSystraceWhileRecording) {
+  JSGlobalContextRef ctx = JSC_JSGlobalContextCreateInGroup(false, nullptr, nullptr);
+  addNativeTracingHooks(ctx);
+  EXPECT_FALSE(evaluate(ctx, "!!this.__RCTProfileIsProfiling").asBoolean());
+  removeNativeTracingHooks(ctx);
+  JSC_JSGlobalContextRelease(ctx);
+
+  TraceRecorder::setEnabled(true);
+  ctx = JSC_JSGlobalContextCreateInGroup(false, nullptr, nullptr);
+  addNativeTracingHooks(ctx);
+  EXPECT_TRUE(evaluate(ctx, "this.__RCTProfileIsProfiling === true").asBoolean());
+  removeNativeTracingHooks(ctx);
+  JSC_JSGlobalContextRelease(ctx);
+}
+
+TEST_F(JSCTracingTest, RecordsSections) {
+  TraceRecorder::setEnabled(true);
+  JSGlobalContextRef ctx = JSC_JSGlobalContextCreateInGroup(false, nullptr, nullptr);
+  addNativeTracingHooks(ctx);
+  evaluate(ctx,
+    "for (var i = 0; i < 3; i++) {"
+    "  nativeTraceBeginSection(1, 'render');"
+    "  nativeTraceEndSection(1);"
+    "  nativeTraceBeginSection(1, 'row ' + i);"
+    "  nativeTraceEndSection(1);"
+    "}"
+    "nativeTraceBeginAsyncSection(1, 'fetch', 7);"
+    "nativeTraceEndAsyncSection(1, 'fetch', 7);"
+    "nativeTraceCounter(1, 'pending', 3);");
+  removeNativeTracingHooks(ctx);
+  JSC_JSGlobalContextRelease(ctx);
+  TraceRecorder::setEnabled(false);
+
+  auto json = TraceRecorder::dumpJSON();
+  EXPECT_EQ(3, count(json, "\"name\":\"render\""));
+  EXPECT_EQ(1, count(json, "\"name\":\"row 2\""));
+  EXPECT_EQ(6, count(json, "\"ph\":\"E\""));
+  EXPECT_EQ(2, count(json, "\"name\":\"fetch\",\"cat\":\"react\",\"id\":7"));
+  EXPECT_EQ(1, count(json, "{\"pending\":3}"));
+}
+
+#endif
@@ -150,3 +150,18 @@ TEST(parseMethodCalls, ParseTwoCalls) {
   auto returnedCalls = parseMethodCalls(folly::parseJson(jsText));
   ASSERT_EQ(2, returnedCalls.size());
 }
+
+TEST(parseMethodCalls, AppendsToExistingCalls) {
+  std::vector<MethodCall> calls;
+  calls.reserve(8);
+  auto storage = calls.data();
+  parseMethodCalls(folly::parseJson("[[1],[2],[[]]]"), calls);
+  parseMethodCalls(folly::parseJson("[[3,4],[5,6],[[],[7]]]"), calls);
+
+  ASSERT_EQ(3, calls.size());
+  ASSERT_EQ(storage, calls.data());
+  ASSERT_EQ(1, calls[0].moduleId);
+  ASSERT_EQ(3, calls[1].moduleId);
+  ASSERT_EQ(4, calls[2].moduleId);
+  ASSERT_EQ(7, calls[2].arguments[0].asInt());
+}
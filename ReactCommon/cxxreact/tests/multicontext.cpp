@@ -0,0 +1,301 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#include <folly/Memory.h>
+#include <gtest/gtest.h>
+#include <cxxreact/CxxModule.h>
+#include <cxxreact/CxxNativeModule.h>
+#include <cxxreact/Instance.h>
+#include <cxxreact/JSBigString.h>
+#include <cxxreact/JSExecutor.h>
+#include <cxxreact/MessageQueueThread.h>
+#include <cxxreact/ModuleRegistry.h>
+
+using namespace facebook;
+using namespace facebook::react;
+using facebook::xplat::module::CxxModule;
+
+namespace {
+
+class QueueThread : public MessageQueueThread {
+public:
+  QueueThread() : m_thread([this] { run(); }) {}
+
+  ~QueueThread() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_quit = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+  }
+
+  void runOnQueue(std::function<void()>&& task) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+    m_cv.notify_all();
+  }
+
+  void runOnQueueSync(std::function<void()>&& task) override {
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+      task();
+      return;
+    }
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    bool done = false;
+    runOnQueue([&] {
+      task();
+      std::lock_guard<std::mutex> lock(doneMutex);
+      done = true;
+      doneCv.notify_all();
+    });
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCv.wait(lock, [&] { return done; });
+  }
+
+  // NativeToJsBridge::destroy() calls this on the queue itself; the thread
+  // is joined by the destructor.
+  void quitSynchronous() override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+    m_cv.notify_all();
+  }
+
+private:
+  void run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_cv.wait(lock, [this] { return m_quit || !m_tasks.empty(); });
+      if (m_quit) {
+        return;
+      }
+      auto task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::function<void()>> m_tasks;
+  bool m_quit = false;
+  std::thread m_thread;
+};
+
+// Stands in for the JS side: every function call becomes a call of
+// Echo.echo(value, callback), and callbacks are collected.
+class EchoExecutor : public JSExecutor {
+public:
+  explicit EchoExecutor(std::shared_ptr<ExecutorDelegate> delegate)
+    : m_delegate(std::move(delegate)) {}
+
+  void loadApplicationScript(std::unique_ptr<const JSBigString>, std::string) override {
+    auto config = m_delegate->getModuleRegistry()->getConfig("Echo");
+    CHECK(config);
+    m_echoModuleId = config->index;
+  }
+
+  void callFunction(const std::string&, const std::string&, const folly::dynamic& args) override {
+    folly::dynamic calls = folly::dynamic::array(
+      folly::dynamic::array(m_echoModuleId),
+      folly::dynamic::array(0),
+      folly::dynamic::array(folly::dynamic::array(args[0], m_nextCallbackId++)));
+    m_delegate->callNativeModules(*this, std::move(calls), true);
+  }
+
+  void invokeCallback(const double, const folly::dynamic& args) override {
+    received.push_back(args[0].asInt());
+    numReceived++;
+  }
+
+  void setBundleRegistry(std::unique_ptr<RAMBundleRegistry>) override {}
+  void registerBundle(uint32_t, const std::string&) override {}
+  void setGlobalVariable(std::string, std::unique_ptr<const JSBigString>) override {}
+  std::string getDescription() override {
+    return "EchoExecutor";
+  }
+
+  // Only touched on the JS queue until numReceived says everything arrived.
+  std::vector<int64_t> received;
+  std::atomic<int> numReceived {0};
+
+private:
+  std::shared_ptr<ExecutorDelegate> m_delegate;
+  int64_t m_echoModuleId = 0;
+  int m_nextCallbackId = 0;
+};
+
+struct EchoExecutorFactory : JSExecutorFactory {
+  EchoExecutor* executor = nullptr;
+
+  std::unique_ptr<JSExecutor> createJSExecutor(
+      std::shared_ptr<ExecutorDelegate> delegate,
+      std::shared_ptr<MessageQueueThread>) override {
+    auto ret = folly::make_unique<EchoExecutor>(std::move(delegate));
+    executor = ret.get();
+    return std::move(ret);
+  }
+};
+
+struct EchoModule : CxxModule {
+  std::string getName() override {
+    return "Echo";
+  }
+  std::vector<Method> getMethods() override {
+    return {
+      Method("echo", [](folly::dynamic args, Callback cb) {
+        cb({args[0]});
+      }),
+    };
+  }
+};
+
+// Its constants are gathered on another queue, which registers a module
+// meanwhile, the way RCTModuleData gathers constants on the main queue while
+// the main thread may register additional modules on iOS.
+struct MainQueueConstantsModule : CxxModule {
+  explicit MainQueueConstantsModule(std::function<void()> onMainQueue)
+    : m_onMainQueue(std::move(onMainQueue)) {}
+
+  std::string getName() override {
+    return "MainQueueConstants";
+  }
+  std::map<std::string, folly::dynamic> getConstants() override {
+    m_onMainQueue();
+    return {{"ready", true}};
+  }
+  std::vector<Method> getMethods() override {
+    return {};
+  }
+
+private:
+  std::function<void()> m_onMainQueue;
+};
+
+bool waitFor(const std::atomic<int>& counter, int value) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (counter.load() < value) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+struct Context {
+  std::shared_ptr<Instance> instance;
+  std::shared_ptr<QueueThread> jsQueue;
+  EchoExecutor* executor;
+};
+
+}
+
+TEST(MultiContextInstance, ContextsShareOneModuleRegistry) {
+  constexpr int kContexts = 4;
+  constexpr int kCalls = 200;
+
+  auto nativeQueue = std::make_shared<QueueThread>();
+  std::vector<std::unique_ptr<NativeModule>> modules;
+  // The module belongs to no instance in particular.
+  modules.push_back(folly::make_unique<CxxNativeModule>(
+    std::weak_ptr<Instance>(), "Echo",
+    [] { return folly::make_unique<EchoModule>(); },
+    nativeQueue));
+  auto registry = std::make_shared<ModuleRegistry>(std::move(modules));
+
+  std::vector<Context> contexts;
+  for (int i = 0; i < kContexts; i++) {
+    auto factory = std::make_shared<EchoExecutorFactory>();
+    Context context {std::make_shared<Instance>(), std::make_shared<QueueThread>(), nullptr};
+    context.instance->initializeBridge(
+      folly::make_unique<InstanceCallback>(), factory, context.jsQueue, registry,
+      context.instance);
+    context.executor = factory->executor;
+    context.instance->loadScriptFromString(
+      folly::make_unique<JSBigStdString>(""), "context.js", false);
+    contexts.push_back(std::move(context));
+  }
+
+  std::vector<std::thread> callers;
+  for (int i = 0; i < kContexts; i++) {
+    callers.emplace_back([&contexts, i] {
+      for (int call = 0; call < kCalls; call++) {
+        contexts[i].instance->callJSFunction(
+          "Module", "method", folly::dynamic::array(i * kCalls + call));
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  for (int i = 0; i < kContexts; i++) {
+    auto executor = contexts[i].executor;
+    ASSERT_TRUE(waitFor(executor->numReceived, kCalls));
+    ASSERT_EQ(kCalls, executor->received.size());
+    for (int call = 0; call < kCalls; call++) {
+      // Every callback went back to the context that made the call.
+      ASSERT_EQ(i * kCalls + call, executor->received[call]);
+    }
+  }
+
+  // Tearing one context down leaves the others running.
+  contexts[0].instance->destroy();
+  contexts[0].instance->callJSFunction("Module", "method", folly::dynamic::array(-1));
+  ASSERT_EQ(nullptr, contexts[0].instance->getJavaScriptContext());
+  contexts[1].instance->callJSFunction("Module", "method", folly::dynamic::array(-2));
+  ASSERT_TRUE(waitFor(contexts[1].executor->numReceived, kCalls + 1));
+  ASSERT_EQ(-2, contexts[1].executor->received.back());
+
+  for (auto& context : contexts) {
+    context.instance->destroy();
+  }
+}
+
+TEST(MultiContextInstance, ModulesRegisterWhileConstantsWaitOnThem) {
+  auto nativeQueue = std::make_shared<QueueThread>();
+  auto mainQueue = std::make_shared<QueueThread>();
+  auto registry = std::make_shared<ModuleRegistry>(
+    std::vector<std::unique_ptr<NativeModule>>());
+  std::weak_ptr<ModuleRegistry> weakRegistry = registry;
+
+  std::vector<std::unique_ptr<NativeModule>> modules;
+  modules.push_back(folly::make_unique<CxxNativeModule>(
+    std::weak_ptr<Instance>(), "MainQueueConstants",
+    [=] {
+      return folly::make_unique<MainQueueConstantsModule>([=] {
+        mainQueue->runOnQueueSync([=] {
+          std::vector<std::unique_ptr<NativeModule>> echo;
+          echo.push_back(folly::make_unique<CxxNativeModule>(
+            std::weak_ptr<Instance>(), "Echo",
+            [] { return folly::make_unique<EchoModule>(); },
+            nativeQueue));
+          weakRegistry.lock()->registerModules(std::move(echo));
+        });
+      });
+    },
+    nativeQueue));
+  registry->registerModules(std::move(modules));
+
+  // Required from a JS thread of its own.  If the registry stayed locked
+  // while the constants wait, the main queue could never register Echo.
+  auto done = std::make_shared<std::atomic<int>>(0);
+  std::thread([registry, done] {
+    auto config = registry->getConfig("MainQueueConstants");
+    CHECK(config);
+    (*done)++;
+  }).detach();
+  ASSERT_TRUE(waitFor(*done, 1));
+
+  auto config = registry->getConfig("Echo");
+  ASSERT_TRUE(config.hasValue());
+  ASSERT_EQ(1, config->index);
+}
@@ -0,0 +1,116 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <cxxreact/NativeCallScheduler.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+using Priority = NativeCallScheduler::Priority;
+
+namespace {
+
+// Collects posted work so that tests decide when it runs.
+struct ManualQueue : MessageQueueThread {
+  std::deque<std::function<void()>> tasks;
+
+  void runOnQueue(std::function<void()>&& task) override {
+    tasks.push_back(std::move(task));
+  }
+  void runOnQueueSync(std::function<void()>&& task) override {
+    task();
+  }
+  void quitSynchronous() override {}
+
+  void drain() {
+    while (!tasks.empty()) {
+      auto task = std::move(tasks.front());
+      tasks.pop_front();
+      task();
+    }
+  }
+};
+
+struct SchedulerTest : ::testing::Test {
+  std::shared_ptr<ManualQueue> queue = std::make_shared<ManualQueue>();
+  NativeCallScheduler scheduler {queue};
+  std::vector<std::string> ran;
+
+  void post(const void* module, Priority priority, std::string name) {
+    scheduler.runOnQueue(module, priority, [this, name] { ran.push_back(name); });
+  }
+};
+
+// Stand-ins for modules; only their addresses matter.
+char analytics;
+char logger;
+char uiManager;
+
+}
+
+TEST_F(SchedulerTest, UrgentCallsRunFirst) {
+  post(&analytics, Priority::Background, "analytics1");
+  post(&logger, Priority::Background, "log1");
+  post(&analytics, Priority::Background, "analytics2");
+  post(&uiManager, Priority::UICritical, "ui1");
+  post(&logger, Priority::Normal, "log2");
+  queue->drain();
+
+  std::vector<std::string> expected {
+    "ui1", "log1", "log2", "analytics1", "analytics2"};
+  ASSERT_EQ(expected, ran);
+}
+
+TEST_F(SchedulerTest, KeepsOrderWithinModule) {
+  post(&analytics, Priority::Background, "analytics1");
+  post(&logger, Priority::Normal, "log1");
+  // Promotes analytics1, which has to run before it.
+  post(&analytics, Priority::UICritical, "analytics2");
+  queue->drain();
+
+  std::vector<std::string> expected {"analytics1", "analytics2", "log1"};
+  ASSERT_EQ(expected, ran);
+}
+
+TEST_F(SchedulerTest, PlainTasksKeepFifoOrder) {
+  scheduler.runOnQueue([this] { ran.push_back("a"); });
+  post(&analytics, Priority::Normal, "analytics1");
+  scheduler.runOnQueue([this] { ran.push_back("b"); });
+  post(&logger, Priority::Background, "log1");
+  post(&uiManager, Priority::Normal, "ui1");
+  queue->drain();
+
+  std::vector<std::string> expected {"a", "analytics1", "b", "ui1", "log1"};
+  ASSERT_EQ(expected, ran);
+}
+
+TEST_F(SchedulerTest, RunsAfterPendingCalls) {
+  post(&analytics, Priority::Background, "analytics1");
+  post(&uiManager, Priority::Normal, "ui1");
+  scheduler.runAfterPending([this] { ran.push_back("batchComplete"); });
+  post(&uiManager, Priority::UICritical, "ui2");
+  post(&logger, Priority::Background, "log1");
+  queue->drain();
+
+  // Plain tasks would run before analytics1.  Calls posted after may go
+  // first.
+  std::vector<std::string> expected {
+    "ui1", "ui2", "analytics1", "batchComplete", "log1"};
+  ASSERT_EQ(expected, ran);
+}
+
+TEST_F(SchedulerTest, CallsPostedWhileRunning) {
+  scheduler.runOnQueue([this] {
+    ran.push_back("a");
+    post(&uiManager, Priority::UICritical, "ui1");
+  });
+  post(&analytics, Priority::Background, "analytics1");
+  queue->drain();
+
+  std::vector<std::string> expected {"a", "ui1", "analytics1"};
+  ASSERT_EQ(expected, ran);
+}
@@ -0,0 +1,170 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdlib.h>
+#include <thread>
+
+#include <folly/Conv.h>
+#include <folly/Memory.h>
+#include <gtest/gtest.h>
+#include <cxxreact/RAMBundleProfile.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+struct CountingBundle : JSModulesUnbundle {
+  std::atomic<int>* loads;
+
+  explicit CountingBundle(std::atomic<int>* l) : loads(l) {}
+
+  Module getModule(uint32_t moduleId) const override {
+    if (moduleId == 13) {
+      throw ModuleNotFound("no module 13");
+    }
+    (*loads)++;
+    Module module;
+    module.name = folly::to<std::string>(moduleId, ".js");
+    module.code = folly::make_unique<JSBigStdString>(folly::to<std::string>("code", moduleId));
+    return module;
+  }
+};
+
+std::string tempPath() {
+  std::string tmp {getenv("TMPDIR")};
+  tmp += "/profile.XXXXXX";
+
+  std::vector<char> tmpBuf {tmp.begin(), tmp.end()};
+  tmpBuf.push_back('\0');
+  close(mkstemp(tmpBuf.data()));
+  return tmpBuf.data();
+}
+
+}
+
+TEST(RAMBundleProfile, WriteAndRead) {
+  RAMBundleProfileRecorder recorder;
+  recorder.record(0, 5, 120);
+  recorder.record(0, 2, 30);
+  recorder.record(1, 7, 4);
+
+  std::string path = tempPath();
+  recorder.writeToFile(path, {1000, 42});
+  auto entries = readRAMBundleProfile(path, {1000, 42});
+
+  ASSERT_EQ(3, entries.size());
+  ASSERT_EQ(5, entries[0].moduleId);
+  ASSERT_EQ(120, entries[0].loadTimeUs);
+  ASSERT_EQ(2, entries[1].moduleId);
+  ASSERT_EQ(1, entries[2].bundleId);
+  ASSERT_EQ(7, entries[2].moduleId);
+}
+
+TEST(RAMBundleProfile, MissingOrMalformedIsEmpty) {
+  ASSERT_TRUE(readRAMBundleProfile("/nonexistent/profile", {0, 0}).empty());
+  // tempPath() creates an empty file.
+  ASSERT_TRUE(readRAMBundleProfile(tempPath(), {0, 0}).empty());
+}
+
+TEST(RAMBundleProfile, OtherBundleIsEmpty) {
+  RAMBundleProfileRecorder recorder;
+  recorder.record(0, 5, 120);
+
+  std::string path = tempPath();
+  recorder.writeToFile(path, {1000, 42});
+  ASSERT_TRUE(readRAMBundleProfile(path, {1001, 42}).empty());
+  ASSERT_TRUE(readRAMBundleProfile(path, {1000, 43}).empty());
+}
+
+TEST(RAMBundleProfile, KeyChangesWithTheBundle) {
+  std::string path = tempPath();
+  auto emptyKey = RAMBundleProfileKey::forFile(path);
+  ASSERT_EQ(0, emptyKey.bundleSize);
+
+  std::ofstream(path) << "bundle";
+  auto key = RAMBundleProfileKey::forFile(path);
+  ASSERT_EQ(6, key.bundleSize);
+  ASSERT_FALSE(key == emptyKey);
+
+  ASSERT_EQ(0, RAMBundleProfileKey::forFile("/nonexistent/bundle").bundleSize);
+}
+
+TEST(RAMBundlePrefetcher, ServesModulesInProfileOrder) {
+  std::atomic<int> loads {0};
+  RAMBundlePrefetcher prefetcher(
+    [&loads] { return folly::make_unique<CountingBundle>(&loads); },
+    {3, 1, 13, 4});
+
+  JSModulesUnbundle::Module module;
+  ASSERT_TRUE(prefetcher.takeModule(3, module));
+  ASSERT_STREQ("code3", module.code->c_str());
+  ASSERT_EQ("3.js", module.name);
+  ASSERT_TRUE(prefetcher.takeModule(1, module));
+  ASSERT_STREQ("code1", module.code->c_str());
+  // Failed to load in the background.
+  ASSERT_FALSE(prefetcher.takeModule(13, module));
+  ASSERT_TRUE(prefetcher.takeModule(4, module));
+  ASSERT_STREQ("code4", module.code->c_str());
+
+  // Not in the profile.
+  ASSERT_FALSE(prefetcher.takeModule(8, module));
+  // Each module is handed out once.
+  ASSERT_FALSE(prefetcher.takeModule(1, module));
+  ASSERT_EQ(3, loads.load());
+}
+
+TEST(RAMBundlePrefetcher, SkipsModulesRequiredAhead) {
+  std::atomic<int> loads {0};
+  std::mutex blocked;
+  blocked.lock();
+  RAMBundlePrefetcher prefetcher(
+    [&] {
+      std::lock_guard<std::mutex> lock(blocked);
+      return folly::make_unique<CountingBundle>(&loads);
+    },
+    {1, 2, 3});
+
+  // The prefetcher hasn't got to module 3 yet, so the caller loads it.
+  JSModulesUnbundle::Module module;
+  ASSERT_FALSE(prefetcher.takeModule(3, module));
+
+  blocked.unlock();
+  ASSERT_TRUE(prefetcher.takeModule(1, module));
+  ASSERT_TRUE(prefetcher.takeModule(2, module));
+  ASSERT_FALSE(prefetcher.takeModule(3, module));
+  ASSERT_EQ(2, loads.load());
+}
+
+TEST(RAMBundlePrefetcher, StaysCloseToTheModulesRequired) {
+  const uint32_t ahead = RAMBundlePrefetcher::MAX_MODULES_AHEAD;
+  // Module ids are positions plus 100, which skips the broken module 13.
+  std::atomic<int> loads {0};
+  std::vector<uint32_t> moduleIds;
+  for (uint32_t i = 0; i < 4 * ahead; i++) {
+    moduleIds.push_back(100 + i);
+  }
+  RAMBundlePrefetcher prefetcher(
+    [&loads] { return folly::make_unique<CountingBundle>(&loads); },
+    moduleIds);
+
+  // Nothing was required yet, so it stops after the first few.
+  while (loads < ahead) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(ahead, loads.load());
+
+  // Requiring a module past those lets it go on up to that module...
+  JSModulesUnbundle::Module module;
+  const uint32_t far = 2 * ahead + 10;
+  ASSERT_FALSE(prefetcher.takeModule(100 + far, module));
+  while (loads < far) {
+    std::this_thread::yield();
+  }
+  ASSERT_TRUE(prefetcher.takeModule(100 + far - 5, module));
+  // ...and drops the modules that fell behind without being required.
+  ASSERT_FALSE(prefetcher.takeModule(100 + 5, module));
+}
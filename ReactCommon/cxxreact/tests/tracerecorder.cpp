@@ -0,0 +1,165 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <cxxreact/SystraceSection.h>
+#include <cxxreact/TraceRecorder.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+struct TraceRecorderTest : ::testing::Test {
+  void SetUp() override {
+    TraceRecorder::setEnabled(false);
+    TraceRecorder::clear();
+  }
+
+  void TearDown() override {
+    TraceRecorder::setEnabled(false);
+    TraceRecorder::clear();
+  }
+};
+
+size_t count(const std::string& str, const std::string& needle) {
+  size_t n = 0;
+  for (auto pos = str.find(needle); pos != std::string::npos;
+       pos = str.find(needle, pos + 1)) {
+    n++;
+  }
+  return n;
+}
+
+}
+
+TEST_F(TraceRecorderTest, DropsEventsWhileDisabled) {
+  // On a thread that never recorded, so that the end is dropped as well.
+  std::thread([] {
+    TraceRecorder::beginSection("ignored");
+    TraceRecorder::endSection();
+  }).join();
+  ASSERT_EQ("{\"traceEvents\":[]}", TraceRecorder::dumpJSON());
+}
+
+TEST_F(TraceRecorderTest, EndsSectionsOpenWhenDisabled) {
+  TraceRecorder::setEnabled(true);
+  {
+    SystraceSection s("open");
+    TraceRecorder::setEnabled(false);
+  }
+  {
+    SystraceSection s("ignored");
+  }
+
+  auto json = TraceRecorder::dumpJSON();
+  ASSERT_EQ(1u, count(json, "\"ph\":\"B\""));
+  ASSERT_EQ(1u, count(json, "\"ph\":\"E\""));
+}
+
+TEST_F(TraceRecorderTest, RecordsSections) {
+  TraceRecorder::setEnabled(true);
+  TraceRecorder::beginSection("callNativeModules", {"module", std::string("UIManager")});
+  TraceRecorder::endSection();
+  TraceRecorder::beginAsyncSection("fetch", 42);
+  TraceRecorder::endAsyncSection("fetch", 42);
+  TraceRecorder::counter("pending", 3);
+  TraceRecorder::setEnabled(false);
+
+  auto json = TraceRecorder::dumpJSON();
+  ASSERT_NE(std::string::npos,
+    json.find("\"ph\":\"B\""));
+  ASSERT_NE(std::string::npos,
+    json.find("\"name\":\"callNativeModules\",\"args\":{\"module\":\"UIManager\"}"));
+  ASSERT_NE(std::string::npos, json.find("\"ph\":\"E\""));
+  ASSERT_NE(std::string::npos,
+    json.find("\"ph\":\"b\""));
+  ASSERT_NE(std::string::npos,
+    json.find("\"name\":\"fetch\",\"cat\":\"react\",\"id\":42"));
+  ASSERT_NE(std::string::npos,
+    json.find("\"name\":\"pending\",\"args\":{\"pending\":3}"));
+}
+
+TEST_F(TraceRecorderTest, EscapesStrings) {
+  TraceRecorder::setEnabled(true);
+  TraceRecorder::beginSection("a\"b\\c\n");
+  TraceRecorder::setEnabled(false);
+
+  ASSERT_NE(std::string::npos,
+    TraceRecorder::dumpJSON().find("\"name\":\"a\\\"b\\\\c\\u000a\""));
+}
+
+TEST_F(TraceRecorderTest, TruncatesLongNames) {
+  TraceRecorder::setEnabled(true);
+  TraceRecorder::beginSection(std::string(200, 'x'));
+  TraceRecorder::setEnabled(false);
+
+  auto json = TraceRecorder::dumpJSON();
+  ASSERT_NE(std::string::npos, json.find(std::string(50, 'x') + "\""));
+  ASSERT_EQ(std::string::npos, json.find(std::string(51, 'x')));
+}
+
+TEST_F(TraceRecorderTest, KeepsMostRecentEvents) {
+  TraceRecorder::setEnabled(true);
+  TraceRecorder::counter("first", 0);
+  for (int i = 0; i < 5000; i++) {
+    TraceRecorder::counter("step", i);
+  }
+  TraceRecorder::setEnabled(false);
+
+  auto json = TraceRecorder::dumpJSON();
+  ASSERT_EQ(std::string::npos, json.find("\"first\""));
+  ASSERT_NE(std::string::npos, json.find("{\"step\":4999}"));
+  ASSERT_EQ(2048, count(json, "\"ph\":\"C\""));
+}
+
+TEST_F(TraceRecorderTest, RecordsPerThread) {
+  TraceRecorder::setEnabled(true);
+  std::thread threads[4];
+  for (auto& thread : threads) {
+    thread = std::thread([] {
+      for (int i = 0; i < 100; i++) {
+        TraceRecorder::beginSection("work");
+        TraceRecorder::endSection();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  TraceRecorder::setEnabled(false);
+
+  auto json = TraceRecorder::dumpJSON();
+  ASSERT_EQ(400, count(json, "\"ph\":\"B\""));
+  ASSERT_EQ(400, count(json, "\"ph\":\"E\""));
+}
+
+TEST_F(TraceRecorderTest, DumpsAndClearsWhileRecording) {
+  TraceRecorder::setEnabled(true);
+  std::atomic<bool> done {false};
+  std::thread writer([&] {
+    for (int i = 0; i < 200000; i++) {
+      TraceRecorder::beginSection("work", {"phase", "layout"});
+      TraceRecorder::endSection();
+    }
+    done = true;
+  });
+
+  while (!done) {
+    auto json = TraceRecorder::dumpJSON();
+    // Every event that made it into the dump is intact.
+    ASSERT_EQ(count(json, "\"ph\":\"B\""),
+      count(json, "\"name\":\"work\",\"args\":{\"phase\":\"layout\"}}"));
+    ASSERT_EQ(count(json, "{\"ph\":"),
+      count(json, "\"ph\":\"B\"") + count(json, "\"ph\":\"E\""));
+    TraceRecorder::clear();
+  }
+  writer.join();
+  TraceRecorder::setEnabled(false);
+
+  TraceRecorder::clear();
+  ASSERT_EQ("{\"traceEvents\":[]}", TraceRecorder::dumpJSON());
+}
@@ -2,56 +2,147 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iomanip>
 #include <mutex>
+#include <sstream>
+#include <unordered_map>
 #include <vector>
+#include <pthread.h>
 #include <time.h>
 
 #include <glog/logging.h>
 
 #include "MicroProfiler.h"
 
-// iOS doesn't support 'thread_local'. If we reimplement this to use pthread_setspecific
-// we can get rid of this
-#if defined(__APPLE__)
-#define MICRO_PROFILER_STUB_IMPLEMENTATION 1
-#else
-#define MICRO_PROFILER_STUB_IMPLEMENTATION 0
-#endif
-
 namespace facebook {
 namespace react {
 
-#if !MICRO_PROFILER_STUB_IMPLEMENTATION
+static const size_t kMaxSections = 256;
+
+static const size_t kSubBuckets = 8;
+static const size_t kMaxExponent = 40;
+static const size_t kNumBuckets = kSubBuckets + (kMaxExponent - 3) * kSubBuckets;
+
+const size_t MicroProfilerHistogram::kNumBuckets = react::kNumBuckets;
+
+size_t MicroProfilerHistogram::bucketForNs(uint64_t ns) {
+  if (ns < kSubBuckets) {
+    return ns;
+  }
+  size_t exponent = 63 - __builtin_clzll(ns);
+  if (exponent >= kMaxExponent) {
+    return kNumBuckets - 1;
+  }
+  return kSubBuckets + (exponent - 3) * kSubBuckets + ((ns >> (exponent - 3)) & (kSubBuckets - 1));
+}
+
+uint64_t MicroProfilerHistogram::bucketLowerBoundNs(size_t bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  size_t exponent = (bucket - kSubBuckets) / kSubBuckets + 3;
+  size_t subBucket = (bucket - kSubBuckets) % kSubBuckets;
+  return uint64_t(kSubBuckets + subBucket) << (exponent - 3);
+}
+
+// Only the owning thread writes, so plain loads and stores do, and readers
+// see values that are at worst slightly out of date.
+static void addRelaxed(std::atomic<uint_fast64_t>& counter, uint_fast64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct SectionData {
+  std::atomic<uint_fast64_t> time{0};
+  std::atomic<uint_fast64_t> calls{0};
+  std::atomic<uint_fast64_t> max{0};
+  std::atomic<uint_fast64_t> buckets[kNumBuckets];
+
+  SectionData() {
+    for (auto& bucket : buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
 struct TraceData {
   TraceData();
-  ~TraceData();
 
-  void addTime(MicroProfilerName name, uint_fast64_t time, uint_fast32_t internalClockCalls);
+  void addTime(MicroProfilerSectionId id, uint_fast64_t time);
+  void clear();
 
   std::thread::id threadId_;
-  uint_fast64_t startTime_;
-  std::atomic_uint_fast64_t times_[MicroProfilerName::__LENGTH__] = {};
-  std::atomic_uint_fast32_t calls_[MicroProfilerName::__LENGTH__] = {};
-  std::atomic_uint_fast32_t childProfileSections_[MicroProfilerName::__LENGTH__] = {};
+  std::atomic<bool> inUse_{true};
+  uint_fast32_t profileSections_ = 0;
+  // Allocated on the thread's first call to each section.
+  std::atomic<SectionData*> sections_[kMaxSections];
 };
 
 struct ProfilingImpl {
   std::mutex mutex_;
+  // Never freed; a thread that exits hands its TraceData to the next thread
+  // that needs one, so its timings still make it to the report.
   std::vector<TraceData*> allTraceData_;
-  bool isProfiling_ = false;
+  std::vector<std::string> sectionNames_;
+  std::unordered_map<std::string, MicroProfilerSectionId> sectionIds_;
+  std::atomic<bool> isProfiling_{false};
   uint_fast64_t startTime_;
   uint_fast64_t endTime_;
-  uint_fast64_t clockOverhead_;
-  uint_fast64_t profileSectionOverhead_;
+  uint_fast64_t clockOverhead_ = 0;
+  uint_fast64_t profileSectionOverhead_ = 0;
+
+  ProfilingImpl() {
+    for (int i = 0; i < MicroProfilerName::__LENGTH__; i++) {
+      auto name = MicroProfiler::profilingNameToString(static_cast<MicroProfilerName>(i));
+      sectionIds_[name] = sectionNames_.size();
+      sectionNames_.push_back(name);
+    }
+  }
 };
 
-static ProfilingImpl profiling;
-thread_local TraceData myTraceData;
-thread_local uint_fast32_t profileSections = 0;
+static ProfilingImpl& profiling() {
+  // Leaked, so that sections in static destructors are fine.
+  static ProfilingImpl* impl = new ProfilingImpl();
+  return *impl;
+}
+
+static void releaseTraceData(void* data) {
+  static_cast<TraceData*>(data)->inUse_.store(false, std::memory_order_release);
+}
+
+// iOS doesn't support 'thread_local', hence the pthread key.
+static TraceData& myTraceData() {
+  static pthread_key_t key = [] {
+    pthread_key_t k;
+    CHECK(pthread_key_create(&k, releaseTraceData) == 0);
+    return k;
+  }();
+
+  auto data = static_cast<TraceData*>(pthread_getspecific(key));
+  if (data) {
+    return *data;
+  }
+
+  auto& impl = profiling();
+  std::lock_guard<std::mutex> lock(impl.mutex_);
+  for (auto candidate : impl.allTraceData_) {
+    bool inUse = false;
+    if (candidate->inUse_.compare_exchange_strong(inUse, true)) {
+      data = candidate;
+      data->threadId_ = std::this_thread::get_id();
+      break;
+    }
+  }
+  if (!data) {
+    data = new TraceData();
+    impl.allTraceData_.push_back(data);
+  }
+  pthread_setspecific(key, data);
+  return *data;
+}
 
 static uint_fast64_t nowNs() {
   struct timespec time;
-  clock_gettime(CLOCK_REALTIME, &time);
+  clock_gettime(CLOCK_MONOTONIC, &time);
   return uint_fast64_t(1000000000) * time.tv_sec + time.tv_nsec;
 }
 
@@ -73,77 +164,179 @@ static std::string formatTimeNs(uint_fast64_t timeNs) {
 }
 
 MicroProfilerSection::MicroProfilerSection(MicroProfilerName name) :
-    isProfiling_(profiling.isProfiling_),
-    name_(name),
-    startNumProfileSections_(profileSections) {
+    MicroProfilerSection(static_cast<MicroProfilerSectionId>(name)) {}
+
+MicroProfilerSection::MicroProfilerSection(MicroProfilerSectionId id) :
+    isProfiling_(profiling().isProfiling_.load(std::memory_order_relaxed)),
+    id_(id) {
   if (!isProfiling_) {
     return;
   }
-  profileSections++;
+  auto& data = myTraceData();
+  startNumProfileSections_ = data.profileSections_++;
   startTime_ = nowNs();
 }
+
 MicroProfilerSection::~MicroProfilerSection() {
-  if (!isProfiling_ || !profiling.isProfiling_) {
+  if (!isProfiling_ || !profiling().isProfiling_.load(std::memory_order_relaxed)) {
     return;
   }
   auto endTime = nowNs();
-  auto endNumProfileSections = profileSections;
-  myTraceData.addTime(name_, endTime - startTime_, endNumProfileSections - startNumProfileSections_ - 1);
+  auto& data = myTraceData();
+  auto childProfileSections = data.profileSections_ - startNumProfileSections_ - 1;
+
+  // Corrected per call rather than in total, for the histogram's sake.
+  auto& impl = profiling();
+  auto overhead = impl.clockOverhead_ + impl.profileSectionOverhead_ * childProfileSections;
+  auto time = endTime - startTime_;
+  data.addTime(id_, time > overhead ? time - overhead : 0);
 }
 
 TraceData::TraceData() :
     threadId_(std::this_thread::get_id()) {
-  std::lock_guard<std::mutex> lock(profiling.mutex_);
-  profiling.allTraceData_.push_back(this);
+  for (auto& section : sections_) {
+    section.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+void TraceData::addTime(MicroProfilerSectionId id, uint_fast64_t time) {
+  auto section = sections_[id].load(std::memory_order_relaxed);
+  if (!section) {
+    section = new SectionData();
+    sections_[id].store(section, std::memory_order_release);
+  }
+  addRelaxed(section->time, time);
+  addRelaxed(section->calls, 1);
+  addRelaxed(section->buckets[MicroProfilerHistogram::bucketForNs(time)], 1);
+  if (time > section->max.load(std::memory_order_relaxed)) {
+    section->max.store(time, std::memory_order_relaxed);
+  }
 }
 
-TraceData::~TraceData() {
-  std::lock_guard<std::mutex> lock(profiling.mutex_);
-  auto& infos = profiling.allTraceData_;
-  infos.erase(std::remove(infos.begin(), infos.end(), this), infos.end());
+void TraceData::clear() {
+  for (auto& slot : sections_) {
+    auto section = slot.load(std::memory_order_acquire);
+    if (!section) {
+      continue;
+    }
+    section->time.store(0, std::memory_order_relaxed);
+    section->calls.store(0, std::memory_order_relaxed);
+    section->max.store(0, std::memory_order_relaxed);
+    for (auto& bucket : section->buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
 }
 
-void TraceData::addTime(MicroProfilerName name, uint_fast64_t time, uint_fast32_t childprofileSections) {
-  times_[name] += time;
-  calls_[name]++;
-  childProfileSections_[name] += childprofileSections;
+uint64_t MicroProfilerHistogram::percentileNs(
+    const std::vector<uint64_t>& buckets,
+    uint64_t calls,
+    uint64_t maxNs,
+    double percentile) {
+  // The smallest value with at least `percentile` of the calls at or below it.
+  auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(calls * percentile + 0.5));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      auto upperBound = i + 1 < kNumBuckets ? bucketLowerBoundNs(i + 1) - 1 : maxNs;
+      return std::min(upperBound, maxNs);
+    }
+  }
+  return maxNs;
 }
 
-static void printReport() {
-  LOG(ERROR) << "======= MICRO PROFILER REPORT =======";
-  LOG(ERROR) << "- Total Time: " << formatTimeNs(diffNs(profiling.startTime_, profiling.endTime_));
-  LOG(ERROR) << "- Clock Overhead: " << formatTimeNs(profiling.clockOverhead_);
-  LOG(ERROR) << "- Profiler Section Overhead: " << formatTimeNs(profiling.profileSectionOverhead_);
-  for (auto info : profiling.allTraceData_) {
-    LOG(ERROR) << "--- Thread ID 0x" << std::hex << info->threadId_ << " ---";
-    for (int i = 0; i < MicroProfilerName::__LENGTH__; i++) {
-      if (info->times_[i] > 0) {
-        auto totalTime = info->times_[i].load();
-        auto calls = info->calls_[i].load();
-        auto clockOverhead = profiling.clockOverhead_ * calls + profiling.profileSectionOverhead_ * info->childProfileSections_[i].load();
-        if (totalTime < clockOverhead) {
-          LOG(ERROR) << "- " << MicroProfiler::profilingNameToString(static_cast<MicroProfilerName>(i)) << ": "
-              << "ERROR: Total time was " << totalTime << "ns but clock overhead was calculated to be " << clockOverhead << "ns!";
-        } else {
-          auto correctedTime = totalTime - clockOverhead;
-          auto timePerCall = correctedTime / calls;
-          LOG(ERROR) << "- " << MicroProfiler::profilingNameToString(static_cast<MicroProfilerName>(i)) << ": "
-              << formatTimeNs(correctedTime) << " (" << calls << " calls, " << formatTimeNs(timePerCall) << "/call)";
-        }
+static MicroProfilerReport buildReport() {
+  auto& impl = profiling();
+  MicroProfilerReport report;
+  report.totalTimeNs = diffNs(impl.startTime_, impl.endTime_);
+  report.clockOverheadNs = impl.clockOverhead_;
+  report.profileSectionOverheadNs = impl.profileSectionOverhead_;
+
+  std::vector<uint64_t> buckets(kNumBuckets);
+  for (size_t id = 0; id < impl.sectionNames_.size(); id++) {
+    MicroProfilerSectionStats stats{impl.sectionNames_[id], 0, 0, 0, 0, 0};
+    std::fill(buckets.begin(), buckets.end(), 0);
+    for (auto info : impl.allTraceData_) {
+      auto section = info->sections_[id].load(std::memory_order_acquire);
+      if (!section) {
+        continue;
       }
+      stats.calls += section->calls.load(std::memory_order_relaxed);
+      stats.totalNs += section->time.load(std::memory_order_relaxed);
+      stats.maxNs = std::max<uint64_t>(stats.maxNs, section->max.load(std::memory_order_relaxed));
+      for (size_t i = 0; i < kNumBuckets; i++) {
+        buckets[i] += section->buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+    if (stats.calls == 0) {
+      continue;
     }
+    stats.p50Ns = MicroProfilerHistogram::percentileNs(buckets, stats.calls, stats.maxNs, 0.5);
+    stats.p99Ns = MicroProfilerHistogram::percentileNs(buckets, stats.calls, stats.maxNs, 0.99);
+    report.sections.push_back(std::move(stats));
   }
+  return report;
 }
 
-static void clearProfiling() {
-  CHECK(!profiling.isProfiling_) << "Trying to clear profiling but profiling was already started!";
-  for (auto info : profiling.allTraceData_) {
-    for (unsigned int i = 0; i < MicroProfilerName::__LENGTH__; i++) {
-      info->times_[i] = 0;
-      info->calls_[i] = 0;
-      info->childProfileSections_[i] = 0;
+static void printReport(const MicroProfilerReport& report) {
+  LOG(ERROR) << "======= MICRO PROFILER REPORT =======";
+  LOG(ERROR) << "- Total Time: " << formatTimeNs(report.totalTimeNs);
+  LOG(ERROR) << "- Clock Overhead: " << formatTimeNs(report.clockOverheadNs);
+  LOG(ERROR) << "- Profiler Section Overhead: " << formatTimeNs(report.profileSectionOverheadNs);
+  for (auto& section : report.sections) {
+    LOG(ERROR) << "- " << section.name << ": "
+        << formatTimeNs(section.totalNs) << " (" << section.calls << " calls, "
+        << formatTimeNs(section.totalNs / section.calls) << "/call, p50 "
+        << formatTimeNs(section.p50Ns) << ", p99 " << formatTimeNs(section.p99Ns)
+        << ", max " << formatTimeNs(section.maxNs) << ")";
+  }
+}
+
+static void appendJSONString(std::ostringstream& out, const std::string& str) {
+  out << '"';
+  for (unsigned char c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (c < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+          << std::dec << std::setfill(' ');
+    } else {
+      out << c;
     }
   }
+  out << '"';
+}
+
+std::string MicroProfilerReport::toJSON() const {
+  std::ostringstream out;
+  out << "{\"totalTimeNs\":" << totalTimeNs
+      << ",\"clockOverheadNs\":" << clockOverheadNs
+      << ",\"profileSectionOverheadNs\":" << profileSectionOverheadNs
+      << ",\"sections\":[";
+  for (size_t i = 0; i < sections.size(); i++) {
+    auto& section = sections[i];
+    if (i > 0) {
+      out << ',';
+    }
+    out << "{\"name\":";
+    appendJSONString(out, section.name);
+    out << ",\"calls\":" << section.calls
+        << ",\"totalNs\":" << section.totalNs
+        << ",\"p50Ns\":" << section.p50Ns
+        << ",\"p99Ns\":" << section.p99Ns
+        << ",\"maxNs\":" << section.maxNs << '}';
+  }
+  out << "]}";
+  return out.str();
+}
+
+static void clearProfiling() {
+  auto& impl = profiling();
+  CHECK(!impl.isProfiling_) << "Trying to clear profiling but profiling was already started!";
+  for (auto info : impl.allTraceData_) {
+    info->clear();
+  }
 }
 
 static uint_fast64_t calculateClockOverhead() {
@@ -157,45 +350,67 @@ static uint_fast64_t calculateClockOverhead() {
 }
 
 static uint_fast64_t calculateProfileSectionOverhead() {
+  auto& impl = profiling();
   int numCalls = 1000000;
   uint_fast64_t start = nowNs();
-  profiling.isProfiling_ = true;
+  impl.isProfiling_ = true;
   for (int i = 0; i < numCalls; i++) {
-    MICRO_PROFILER_SECTION(static_cast<MicroProfilerName>(0));
+    MicroProfilerSection section(static_cast<MicroProfilerName>(0));
   }
   uint_fast64_t end = nowNs();
-  profiling.isProfiling_ = false;
+  impl.isProfiling_ = false;
   return (end - start) / numCalls;
 }
 
+MicroProfilerSectionId MicroProfiler::registerSection(const char* name) {
+  auto& impl = profiling();
+  std::lock_guard<std::mutex> lock(impl.mutex_);
+  auto it = impl.sectionIds_.find(name);
+  if (it != impl.sectionIds_.end()) {
+    return it->second;
+  }
+  CHECK(impl.sectionNames_.size() < kMaxSections) << "Too many micro profiler sections, can't add " << name;
+  MicroProfilerSectionId id = impl.sectionNames_.size();
+  impl.sectionIds_[name] = id;
+  impl.sectionNames_.push_back(name);
+  return id;
+}
+
 void MicroProfiler::startProfiling() {
-  CHECK(!profiling.isProfiling_) << "Trying to start profiling but profiling was already started!";
+  auto& impl = profiling();
+  CHECK(!impl.isProfiling_) << "Trying to start profiling but profiling was already started!";
 
-  profiling.clockOverhead_ = calculateClockOverhead();
-  profiling.profileSectionOverhead_ = calculateProfileSectionOverhead();
+  // Measured with no correction applied.
+  impl.clockOverhead_ = 0;
+  impl.profileSectionOverhead_ = 0;
+  impl.clockOverhead_ = calculateClockOverhead();
+  impl.profileSectionOverhead_ = calculateProfileSectionOverhead();
 
-  std::lock_guard<std::mutex> lock(profiling.mutex_);
+  std::lock_guard<std::mutex> lock(impl.mutex_);
   clearProfiling();
 
-  profiling.startTime_ = nowNs();
-  profiling.isProfiling_ = true;
+  impl.startTime_ = nowNs();
+  impl.isProfiling_ = true;
 }
 
-void MicroProfiler::stopProfiling() {
-  CHECK(profiling.isProfiling_) << "Trying to stop profiling but profiling hasn't been started!";
+MicroProfilerReport MicroProfiler::stopProfiling() {
+  auto& impl = profiling();
+  CHECK(impl.isProfiling_) << "Trying to stop profiling but profiling hasn't been started!";
 
-  profiling.isProfiling_ = false;
-  profiling.endTime_ = nowNs();
+  impl.isProfiling_ = false;
+  impl.endTime_ = nowNs();
 
-  std::lock_guard<std::mutex> lock(profiling.mutex_);
+  std::lock_guard<std::mutex> lock(impl.mutex_);
 
-  printReport();
+  auto report = buildReport();
+  printReport(report);
 
   clearProfiling();
+  return report;
 }
 
 bool MicroProfiler::isProfiling() {
-  return profiling.isProfiling_;
+  return profiling().isProfiling_;
 }
 
 void MicroProfiler::runInternalBenchmark() {
@@ -208,17 +423,5 @@ void MicroProfiler::runInternalBenchmark() {
   }
   MicroProfiler::stopProfiling();
 }
-#else
-void MicroProfiler::startProfiling() {
-  CHECK(false) << "This platform has a stub implementation of the micro profiler and cannot collect traces";
-}
-void MicroProfiler::stopProfiling() {
-}
-bool MicroProfiler::isProfiling() {
-  return false;
-}
-void MicroProfiler::runInternalBenchmark() {
-}
-#endif
 
 } }
@@ -3,7 +3,12 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 // #define WITH_MICRO_PROFILER 1
 
@@ -24,6 +29,49 @@ enum MicroProfilerName {
   __LENGTH__,
 };
 
+// Identifies a section registered with MicroProfiler::registerSection.  The
+// MicroProfilerName values are the ids of the built-in sections.
+typedef uint32_t MicroProfilerSectionId;
+
+struct MicroProfilerSectionStats {
+  std::string name;
+  uint64_t calls;
+  // Times are corrected for the profiler's overhead.
+  uint64_t totalNs;
+  uint64_t p50Ns;
+  uint64_t p99Ns;
+  uint64_t maxNs;
+};
+
+struct MicroProfilerReport {
+  uint64_t totalTimeNs;
+  uint64_t clockOverheadNs;
+  uint64_t profileSectionOverheadNs;
+  // Sections that were hit, summed over all threads, in registration order.
+  std::vector<MicroProfilerSectionStats> sections;
+
+  std::string toJSON() const;
+};
+
+/**
+ * The latency histogram behind the reported percentiles.  Values below 8ns
+ * get a bucket each; above that, each power of two up to 2^40ns is split in
+ * 8 buckets, and longer calls share the last one.
+ */
+struct MicroProfilerHistogram {
+  static const size_t kNumBuckets;
+
+  static size_t bucketForNs(uint64_t ns);
+  static uint64_t bucketLowerBoundNs(size_t bucket);
+  // The upper bound of the bucket holding the call at `percentile`, capped
+  // at `maxNs`.
+  static uint64_t percentileNs(
+      const std::vector<uint64_t>& buckets,
+      uint64_t calls,
+      uint64_t maxNs,
+      double percentile);
+};
+
 /**
  * MicroProfiler is a performance profiler for measuring the cumulative impact of
  * a large number of small-ish calls. This is normally a problem for standard profilers
@@ -41,8 +89,17 @@ enum MicroProfilerName {
  * profiler section that is invoked within a parent profiler section. The latter is
  * subtracted from each section, child or not.
  *
+ * Sections other than the built-in ones are registered at runtime, once, and
+ * profiled by id:
+ *
+ *   static const auto kMeasure = MicroProfiler::registerSection("yoga.measure");
+ *   MICRO_PROFILER_SECTION(kMeasure);
+ *
+ * Every call is also added to a latency histogram with 8 buckets per power of
+ * two, so the reported percentiles are within 12.5% of the real ones.
+ *
  * After MicroProfiler::stopProfiling() is called, a table of tracing data is emitted
- * to glog (which shows up in logcat on Android).
+ * to glog (which shows up in logcat on Android), and returned.
  */
 struct MicroProfiler {
   static const char* profilingNameToString(MicroProfilerName name) {
@@ -58,8 +115,12 @@ struct MicroProfiler {
     }
   }
 
+  // Returns the same id when called again with the same name.  There is room
+  // for 256 sections, built-in ones included.
+  static MicroProfilerSectionId registerSection(const char* name);
+
   static void startProfiling();
-  static void stopProfiling();
+  static MicroProfilerReport stopProfiling();
   static bool isProfiling();
   static void runInternalBenchmark();
 };
@@ -67,11 +128,12 @@ struct MicroProfiler {
 class MicroProfilerSection {
 public:
   MicroProfilerSection(MicroProfilerName name);
+  MicroProfilerSection(MicroProfilerSectionId id);
   ~MicroProfilerSection();
 
 private:
   bool isProfiling_;
-  MicroProfilerName name_;
+  MicroProfilerSectionId id_;
   uint_fast64_t startTime_;
   uint_fast32_t startNumProfileSections_;
 };
@@ -0,0 +1,118 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <microprofiler/MicroProfiler.h>
+
+using namespace facebook::react;
+
+TEST(MicroProfilerHistogram, BucketsRoundTrip) {
+  uint64_t previousLowerBound = 0;
+  for (size_t bucket = 0; bucket < MicroProfilerHistogram::kNumBuckets; bucket++) {
+    auto lowerBound = MicroProfilerHistogram::bucketLowerBoundNs(bucket);
+    ASSERT_EQ(bucket, MicroProfilerHistogram::bucketForNs(lowerBound));
+    if (bucket > 0) {
+      ASSERT_GT(lowerBound, previousLowerBound);
+      // The last value before a bucket belongs to the one before it.
+      ASSERT_EQ(bucket - 1, MicroProfilerHistogram::bucketForNs(lowerBound - 1));
+      // Buckets are at most 12.5% wide.
+      ASSERT_LE((lowerBound - previousLowerBound) * 8, previousLowerBound + 8);
+    }
+    previousLowerBound = lowerBound;
+  }
+}
+
+TEST(MicroProfilerHistogram, SmallAndLargeValues) {
+  for (uint64_t ns = 0; ns < 8; ns++) {
+    ASSERT_EQ(ns, MicroProfilerHistogram::bucketForNs(ns));
+  }
+  ASSERT_EQ(8, MicroProfilerHistogram::bucketForNs(8));
+  ASSERT_EQ(15, MicroProfilerHistogram::bucketForNs(15));
+  ASSERT_EQ(16, MicroProfilerHistogram::bucketForNs(16));
+  ASSERT_EQ(16, MicroProfilerHistogram::bucketForNs(17));
+  ASSERT_EQ(MicroProfilerHistogram::kNumBuckets - 1,
+    MicroProfilerHistogram::bucketForNs(uint64_t(1) << 40));
+  ASSERT_EQ(MicroProfilerHistogram::kNumBuckets - 1,
+    MicroProfilerHistogram::bucketForNs(~uint64_t(0)));
+}
+
+TEST(MicroProfilerHistogram, Percentiles) {
+  // 1000 calls taking 1us to 1000us.
+  std::vector<uint64_t> buckets(MicroProfilerHistogram::kNumBuckets);
+  for (uint64_t ns = 1000; ns <= 1000000; ns += 1000) {
+    buckets[MicroProfilerHistogram::bucketForNs(ns)]++;
+  }
+
+  auto p50 = MicroProfilerHistogram::percentileNs(buckets, 1000, 1000000, 0.5);
+  auto p99 = MicroProfilerHistogram::percentileNs(buckets, 1000, 1000000, 0.99);
+  // Within a bucket, that is 12.5%, above the exact values.
+  ASSERT_GE(p50, 500000);
+  ASSERT_LE(p50, 500000 * 9 / 8);
+  ASSERT_GE(p99, 990000);
+  ASSERT_LE(p99, 1000000);
+
+  ASSERT_EQ(1000000, MicroProfilerHistogram::percentileNs(buckets, 1000, 1000000, 1.0));
+}
+
+TEST(MicroProfilerHistogram, PercentilesAreCappedAtMax) {
+  std::vector<uint64_t> buckets(MicroProfilerHistogram::kNumBuckets);
+  buckets[MicroProfilerHistogram::bucketForNs(1000)] = 10;
+  ASSERT_EQ(1000, MicroProfilerHistogram::percentileNs(buckets, 10, 1000, 0.5));
+}
+
+TEST(MicroProfiler, RegisterSectionReturnsSameId) {
+  auto id = MicroProfiler::registerSection("test.same");
+  ASSERT_GE(id, MicroProfilerName::__LENGTH__);
+  ASSERT_EQ(id, MicroProfiler::registerSection(std::string("test.same").c_str()));
+  ASSERT_NE(id, MicroProfiler::registerSection("test.other"));
+  ASSERT_EQ(
+    static_cast<MicroProfilerSectionId>(__INTERNAL_BENCHMARK_OUTER),
+    MicroProfiler::registerSection("__INTERNAL_BENCHMARK_OUTER"));
+}
+
+TEST(MicroProfiler, RegisterSectionOverflow) {
+  // Only the section after id 255 is refused.
+  ASSERT_DEATH({
+    MicroProfilerSectionId id = 0;
+    for (int i = 0; id < 255 && i < 256; i++) {
+      id = MicroProfiler::registerSection(("test.overflow." + std::to_string(i)).c_str());
+    }
+    if (id == 255) {
+      MicroProfiler::registerSection("test.overflow.last");
+    }
+  }, "Too many micro profiler sections, can't add test.overflow.last");
+}
+
+TEST(MicroProfiler, ReportsSections) {
+  auto id = MicroProfiler::registerSection("test.report \"quoted\"");
+  MicroProfiler::startProfiling();
+  for (int i = 0; i < 100; i++) {
+    MicroProfilerSection section(id);
+  }
+  auto report = MicroProfiler::stopProfiling();
+
+  ASSERT_EQ(1, report.sections.size());
+  auto& stats = report.sections[0];
+  ASSERT_EQ("test.report \"quoted\"", stats.name);
+  ASSERT_EQ(100, stats.calls);
+  ASSERT_LE(stats.p50Ns, stats.p99Ns);
+  ASSERT_LE(stats.p99Ns, stats.maxNs);
+  ASSERT_LE(stats.maxNs, stats.totalNs);
+}
+
+TEST(MicroProfilerReport, ToJSON) {
+  MicroProfilerReport report{1000, 20, 30, {
+    {"a\"b\\c\n", 2, 500, 200, 300, 300},
+    {"yoga.measure", 1, 7, 7, 7, 7},
+  }};
+  ASSERT_EQ(
+    "{\"totalTimeNs\":1000,\"clockOverheadNs\":20,\"profileSectionOverheadNs\":30,"
+    "\"sections\":["
+    "{\"name\":\"a\\\"b\\\\c\\u000a\",\"calls\":2,\"totalNs\":500,"
+    "\"p50Ns\":200,\"p99Ns\":300,\"maxNs\":300},"
+    "{\"name\":\"yoga.measure\",\"calls\":1,\"totalNs\":7,"
+    "\"p50Ns\":7,\"p99Ns\":7,\"maxNs\":7}]}",
+    report.toJSON());
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+
+// Measures layout with and without event subscribers, on one thread and on
+// several at once, each with its own tree.  Build yoga with YG_ENABLE_EVENTS,
+// otherwise layout doesn't publish and all scenarios cost the same.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <yoga/Yoga.h>
+#include <yoga/event/event.h>
+
+using namespace facebook::yoga;
+
+namespace {
+
+constexpr int kThreads = 4;
+
+std::atomic<uint64_t> eventCount{0};
+
+void countEvent(const YGNode&, Event::Type, Event::Data) {
+  eventCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// A root with 10 children of 10 children each.
+YGNodeRef buildTree(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 1000);
+  YGNodeStyleSetHeight(root, 1000);
+  for (uint32_t i = 0; i < 10; i++) {
+    const YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(child, 1);
+    YGNodeStyleSetFlexDirection(child, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(child, YGEdgeAll, 2);
+    for (uint32_t j = 0; j < 10; j++) {
+      const YGNodeRef grandchild = YGNodeNewWithConfig(config);
+      YGNodeStyleSetFlexGrow(grandchild, 1);
+      YGNodeStyleSetMargin(grandchild, YGEdgeAll, 1);
+      YGNodeInsertChild(child, grandchild, j);
+    }
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+// Lays out the tree `passes` times, changing its width so that each pass
+// lays out every node, and returns the time taken.
+double layoutNs(YGNodeRef root, int passes) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < passes; i++) {
+    YGNodeStyleSetWidth(root, 1000 + i % 2);
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  }
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void run(const char* name, int passes, int threads, YGConfigRef sharedConfig) {
+  std::vector<YGConfigRef> configs;
+  std::vector<YGNodeRef> roots;
+  for (int i = 0; i < threads; i++) {
+    configs.push_back(sharedConfig != nullptr ? sharedConfig : YGConfigNew());
+    roots.push_back(buildTree(configs.back()));
+  }
+
+  eventCount = 0;
+  std::vector<double> elapsedNs(threads);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; i++) {
+    workers.emplace_back(
+        [&, i] { elapsedNs[i] = layoutNs(roots[i], passes); });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  double slowestNs = 0;
+  for (double ns : elapsedNs) {
+    slowestNs = ns > slowestNs ? ns : slowestNs;
+  }
+  printf(
+      "%-36s %8d %12.0f %14.1f\n",
+      name,
+      threads,
+      slowestNs / passes,
+      static_cast<double>(eventCount.load()) / (passes * threads));
+
+  for (int i = 0; i < threads; i++) {
+    YGNodeFreeRecursive(roots[i]);
+    if (sharedConfig == nullptr) {
+      YGConfigFree(configs[i]);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int passes = argc > 1 ? atoi(argv[1]) : 2000;
+
+  printf("%-36s %8s %12s %14s\n", "scenario", "threads", "ns/pass", "events/pass");
+
+  Event::reset();
+  run("no subscribers", passes, 1, nullptr);
+  run("no subscribers", passes, kThreads, nullptr);
+
+  const YGConfigRef subscribed = YGConfigNew();
+  Event::subscribe(subscribed, countEvent);
+  run("other config has a subscriber", passes, kThreads, nullptr);
+  run("config subscriber", passes, 1, subscribed);
+
+  Event::subscribe(countEvent);
+  run("global subscriber", passes, 1, nullptr);
+  run("global subscriber", passes, kThreads, nullptr);
+
+  Event::reset();
+  YGConfigFree(subscribed);
+  return 0;
+}
@@ -0,0 +1,768 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGFuzzTree.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+
+#include <yoga/YGEnums.h>
+#include <yoga/YGNode.h>
+
+namespace facebook {
+namespace yoga {
+namespace fuzz {
+
+namespace {
+
+const std::array<float, 4> kAvailableSizes = {{YGUndefined, 100, 320.5f, 1000}};
+const std::array<float, 8> kPoints = {{0, 1, 2.5f, 7, 10, 33.3f, 100, 250}};
+const std::array<float, 4> kPercents = {{10, 33.3f, 50, 100}};
+const std::array<float, 4> kFactors = {{0, 0.5f, 1, 2}};
+
+// The tolerance of Yoga's float comparisons, see YGFloatsEqual.
+const float kFloatTolerance = 0.0001f;
+
+const float kCharWidth = 6.5f;
+const float kLineHeight = 12;
+
+// Text that wraps at the width it is given, with characters that don't fit
+// the pixel grid.
+YGSize measureText(
+    const Tree::Node& node,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const YGMeasureMode heightMode) {
+  const float naturalWidth = node.textLength * kCharWidth;
+  float measuredWidth = naturalWidth;
+  if (widthMode == YGMeasureModeExactly) {
+    measuredWidth = width;
+  } else if (widthMode == YGMeasureModeAtMost) {
+    measuredWidth = std::min(naturalWidth, std::max(width, 0.0f));
+  }
+  const float lineCount =
+      std::ceil(naturalWidth / std::max(measuredWidth, kCharWidth));
+  float measuredHeight = lineCount * kLineHeight;
+  if (heightMode == YGMeasureModeExactly) {
+    measuredHeight = height;
+  } else if (heightMode == YGMeasureModeAtMost) {
+    measuredHeight = std::min(measuredHeight, std::max(height, 0.0f));
+  }
+  return YGSize{measuredWidth, measuredHeight};
+}
+
+YGSize measure(
+    const YGNodeRef node,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const YGMeasureMode heightMode) {
+  return measureText(
+      *static_cast<const Tree::Node*>(YGNodeGetContext(node)),
+      width,
+      widthMode,
+      height,
+      heightMode);
+}
+
+void batchMeasure(YGMeasureRequest* requests, const uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    YGMeasureRequest& request = requests[i];
+    request.size = measure(
+        request.node,
+        request.width,
+        request.widthMode,
+        request.height,
+        request.heightMode);
+  }
+}
+
+float baseline(const YGNodeRef node, const float width, const float height) {
+  return YGFloatIsUndefined(height) ? 0 : height / 2;
+}
+
+YGNodeRef cloneNode(
+    const YGNodeRef oldNode,
+    const YGNodeRef owner,
+    const int childIndex) {
+  return YGNodeClone(oldNode);
+}
+
+// The number of values of the enum that a style property takes, or 0 if it
+// takes a length.
+int enumCount(const uint32_t prop) {
+  switch (prop) {
+    case YGStylePropDirection:
+      return enums::count<YGDirection>();
+    case YGStylePropFlexDirection:
+      return enums::count<YGFlexDirection>();
+    case YGStylePropJustifyContent:
+      return enums::count<YGJustify>();
+    case YGStylePropAlignContent:
+    case YGStylePropAlignItems:
+    case YGStylePropAlignSelf:
+      return enums::count<YGAlign>();
+    case YGStylePropPositionType:
+      return enums::count<YGPositionType>();
+    case YGStylePropFlexWrap:
+      return enums::count<YGWrap>();
+    case YGStylePropOverflow:
+      return enums::count<YGOverflow>();
+    case YGStylePropDisplay:
+      return enums::count<YGDisplay>();
+    default:
+      return 0;
+  }
+}
+
+// A value that the setters of the property accept, from the two low bits of
+// the byte for the unit and the rest for the value.
+YGValue styleValue(const uint32_t prop, const uint8_t byte) {
+  const int count = enumCount(prop);
+  if (count > 0) {
+    return YGValue{static_cast<float>(byte % count), YGUnitPoint};
+  }
+  const uint8_t unit = byte & 3;
+  const uint8_t index = byte >> 2;
+  if (prop == YGStylePropFlex || prop == YGStylePropFlexGrow ||
+      prop == YGStylePropFlexShrink) {
+    return YGValue{kFactors[index % kFactors.size()], YGUnitPoint};
+  }
+  if (prop == YGStylePropAspectRatio) {
+    return YGValue{kFactors[index % (kFactors.size() - 1)] + 0.5f, YGUnitPoint};
+  }
+  const bool isMargin = prop >= YGStylePropMargin && prop < YGStylePropPosition;
+  const bool isBorder =
+      prop >= YGStylePropBorder && prop < YGStylePropDimensions;
+  const bool takesAuto = isMargin || prop == YGStylePropFlexBasis ||
+      (prop >= YGStylePropDimensions && prop < YGStylePropMaxDimensions);
+  if (unit == 3 && takesAuto) {
+    return YGValue{YGUndefined, YGUnitAuto};
+  }
+  if (unit == 2 && !isBorder && !isMargin) {
+    return YGValue{kPercents[index % kPercents.size()], YGUnitPercent};
+  }
+  const float point = kPoints[index % kPoints.size()];
+  // Margins and positions can be negative.
+  const bool canBeNegative =
+      prop >= YGStylePropMargin && prop < YGStylePropPadding;
+  return YGValue{canBeNegative && unit == 1 ? -point : point, YGUnitPoint};
+}
+
+// Sets the style property with its setter, as hosts that don't batch style
+// updates do.
+void setStyle(const YGNodeRef node, const YGStyleUpdate& update) {
+  const uint32_t prop = update.prop;
+  const float value = update.value.value;
+  const YGUnit unit = update.value.unit;
+  if (prop >= YGStylePropMargin && prop < YGStylePropDimensions) {
+    const YGEdge edge = static_cast<YGEdge>((prop - YGStylePropMargin) % 9);
+    if (prop < YGStylePropPosition) {
+      if (unit == YGUnitAuto) {
+        YGNodeStyleSetMarginAuto(node, edge);
+      } else if (unit == YGUnitPercent) {
+        YGNodeStyleSetMarginPercent(node, edge, value);
+      } else {
+        YGNodeStyleSetMargin(node, edge, value);
+      }
+    } else if (prop < YGStylePropPadding) {
+      if (unit == YGUnitPercent) {
+        YGNodeStyleSetPositionPercent(node, edge, value);
+      } else {
+        YGNodeStyleSetPosition(node, edge, value);
+      }
+    } else if (prop < YGStylePropBorder) {
+      if (unit == YGUnitPercent) {
+        YGNodeStyleSetPaddingPercent(node, edge, value);
+      } else {
+        YGNodeStyleSetPadding(node, edge, value);
+      }
+    } else {
+      YGNodeStyleSetBorder(node, edge, value);
+    }
+    return;
+  }
+  switch (prop) {
+    case YGStylePropDirection:
+      return YGNodeStyleSetDirection(node, static_cast<YGDirection>(value));
+    case YGStylePropFlexDirection:
+      return YGNodeStyleSetFlexDirection(
+          node, static_cast<YGFlexDirection>(value));
+    case YGStylePropJustifyContent:
+      return YGNodeStyleSetJustifyContent(node, static_cast<YGJustify>(value));
+    case YGStylePropAlignContent:
+      return YGNodeStyleSetAlignContent(node, static_cast<YGAlign>(value));
+    case YGStylePropAlignItems:
+      return YGNodeStyleSetAlignItems(node, static_cast<YGAlign>(value));
+    case YGStylePropAlignSelf:
+      return YGNodeStyleSetAlignSelf(node, static_cast<YGAlign>(value));
+    case YGStylePropPositionType:
+      return YGNodeStyleSetPositionType(
+          node, static_cast<YGPositionType>(value));
+    case YGStylePropFlexWrap:
+      return YGNodeStyleSetFlexWrap(node, static_cast<YGWrap>(value));
+    case YGStylePropOverflow:
+      return YGNodeStyleSetOverflow(node, static_cast<YGOverflow>(value));
+    case YGStylePropDisplay:
+      return YGNodeStyleSetDisplay(node, static_cast<YGDisplay>(value));
+    case YGStylePropFlex:
+      return YGNodeStyleSetFlex(node, value);
+    case YGStylePropFlexGrow:
+      return YGNodeStyleSetFlexGrow(node, value);
+    case YGStylePropFlexShrink:
+      return YGNodeStyleSetFlexShrink(node, value);
+    case YGStylePropFlexBasis:
+      if (unit == YGUnitAuto) {
+        return YGNodeStyleSetFlexBasisAuto(node);
+      } else if (unit == YGUnitPercent) {
+        return YGNodeStyleSetFlexBasisPercent(node, value);
+      }
+      return YGNodeStyleSetFlexBasis(node, value);
+    case YGStylePropDimensions + YGDimensionWidth:
+      if (unit == YGUnitAuto) {
+        return YGNodeStyleSetWidthAuto(node);
+      } else if (unit == YGUnitPercent) {
+        return YGNodeStyleSetWidthPercent(node, value);
+      }
+      return YGNodeStyleSetWidth(node, value);
+    case YGStylePropDimensions + YGDimensionHeight:
+      if (unit == YGUnitAuto) {
+        return YGNodeStyleSetHeightAuto(node);
+      } else if (unit == YGUnitPercent) {
+        return YGNodeStyleSetHeightPercent(node, value);
+      }
+      return YGNodeStyleSetHeight(node, value);
+    case YGStylePropMaxDimensions + YGDimensionWidth:
+      return unit == YGUnitPercent ? YGNodeStyleSetMaxWidthPercent(node, value)
+                                   : YGNodeStyleSetMaxWidth(node, value);
+    case YGStylePropMaxDimensions + YGDimensionHeight:
+      return unit == YGUnitPercent
+          ? YGNodeStyleSetMaxHeightPercent(node, value)
+          : YGNodeStyleSetMaxHeight(node, value);
+    case YGStylePropMinDimensions + YGDimensionWidth:
+      return unit == YGUnitPercent ? YGNodeStyleSetMinWidthPercent(node, value)
+                                   : YGNodeStyleSetMinWidth(node, value);
+    case YGStylePropMinDimensions + YGDimensionHeight:
+      return unit == YGUnitPercent
+          ? YGNodeStyleSetMinHeightPercent(node, value)
+          : YGNodeStyleSetMinHeight(node, value);
+    case YGStylePropAspectRatio:
+      return YGNodeStyleSetAspectRatio(node, value);
+  }
+}
+
+constexpr size_t kLayoutValueCount = 18;
+
+const std::array<const char*, kLayoutValueCount> kLayoutValueNames = {{
+    "left",          "top",           "right",          "bottom",
+    "width",         "height",        "margin left",    "margin top",
+    "margin right",  "margin bottom", "border left",    "border top",
+    "border right",  "border bottom", "padding left",   "padding top",
+    "padding right", "padding bottom",
+}};
+
+// Whether a node had overflow is left out, as that is whatever the last pass
+// that didn't hit the cache found, and so depends on the earlier layouts.
+struct NodeLayout {
+  std::array<float, kLayoutValueCount> values;
+  YGDirection direction;
+};
+
+// The layouts of the nodes in pre-order.
+using TreeLayout = std::vector<NodeLayout>;
+
+void recordLayout(const YGNodeRef node, TreeLayout& layout) {
+  NodeLayout nodeLayout;
+  const std::array<YGEdge, 4> edges = {
+      {YGEdgeLeft, YGEdgeTop, YGEdgeRight, YGEdgeBottom}};
+  nodeLayout.values[0] = YGNodeLayoutGetLeft(node);
+  nodeLayout.values[1] = YGNodeLayoutGetTop(node);
+  nodeLayout.values[2] = YGNodeLayoutGetRight(node);
+  nodeLayout.values[3] = YGNodeLayoutGetBottom(node);
+  nodeLayout.values[4] = YGNodeLayoutGetWidth(node);
+  nodeLayout.values[5] = YGNodeLayoutGetHeight(node);
+  for (size_t i = 0; i < edges.size(); i++) {
+    nodeLayout.values[6 + i] = YGNodeLayoutGetMargin(node, edges[i]);
+    nodeLayout.values[10 + i] = YGNodeLayoutGetBorder(node, edges[i]);
+    nodeLayout.values[14 + i] = YGNodeLayoutGetPadding(node, edges[i]);
+  }
+  nodeLayout.direction = YGNodeLayoutGetDirection(node);
+  layout.push_back(nodeLayout);
+
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  for (uint32_t i = 0; i < childCount; i++) {
+    recordLayout(YGNodeGetChild(node, i), layout);
+  }
+}
+
+bool sameValue(const float a, const float b, const float tolerance) {
+  return std::isnan(a) ? std::isnan(b)
+                       : a == b || std::fabs(a - b) < tolerance;
+}
+
+bool sameLayout(
+    const NodeLayout& a,
+    const NodeLayout& b,
+    const float tolerance) {
+  for (size_t i = 0; i < kLayoutValueCount; i++) {
+    if (!sameValue(a.values[i], b.values[i], tolerance)) {
+      return false;
+    }
+  }
+  return a.direction == b.direction;
+}
+
+std::string diff(
+    const char* path,
+    const TreeLayout& reference,
+    const TreeLayout& layout,
+    const float tolerance = 0) {
+  char description[256];
+  if (layout.size() != reference.size()) {
+    snprintf(
+        description,
+        sizeof(description),
+        "%s: %zu nodes instead of %zu",
+        path,
+        layout.size(),
+        reference.size());
+    return description;
+  }
+  for (size_t i = 0; i < reference.size(); i++) {
+    for (size_t j = 0; j < kLayoutValueCount; j++) {
+      if (!sameValue(
+              reference[i].values[j], layout[i].values[j], tolerance)) {
+        snprintf(
+            description,
+            sizeof(description),
+            "%s: node %zu has %s %f instead of %f",
+            path,
+            i,
+            kLayoutValueNames[j],
+            layout[i].values[j],
+            reference[i].values[j]);
+        return description;
+      }
+    }
+    if (reference[i].direction != layout[i].direction) {
+      snprintf(
+          description,
+          sizeof(description),
+          "%s: node %zu has direction %s instead of %s",
+          path,
+          i,
+          YGDirectionToString(layout[i].direction),
+          YGDirectionToString(reference[i].direction));
+      return description;
+    }
+  }
+  return "";
+}
+
+void calculateLayoutAt(
+    const YGNodeRef root,
+    const float width,
+    const float height,
+    const YGDirection direction,
+    std::vector<YGNodeRef>* changedNodes) {
+  if (changedNodes != nullptr) {
+    YGNodeCalculateLayoutWithChangedNodes(
+        root, width, height, direction, nullptr, *changedNodes);
+  } else {
+    YGNodeCalculateLayout(root, width, height, direction);
+  }
+}
+
+void markLeavesDirty(const YGNodeRef node) {
+  if (YGNodeHasMeasureFunc(node)) {
+    YGNodeMarkDirty(node);
+  }
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  for (uint32_t i = 0; i < childCount; i++) {
+    markLeavesDirty(YGNodeGetChild(node, i));
+  }
+}
+
+// Makes the next layout round every node again, as rounding did before it
+// skipped the nodes that weren't laid out again.
+void markUnrounded(const YGNodeRef node) {
+  node->setLayoutRoundedPointScaleFactor(0);
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  for (uint32_t i = 0; i < childCount; i++) {
+    markUnrounded(YGNodeGetChild(node, i));
+  }
+}
+
+// A viewport that covers every child, however far out the fuzzed styles place
+// it, so that none is deferred.
+const YGViewport kEveryChildViewport = {-1e30f, 2e30f, 0, 0};
+
+// A viewport that defers the children past the first few points.
+const YGViewport kFirstChildrenViewport = {0, 10, 0, 10};
+
+void setViewports(const YGNodeRef node, const YGViewport& viewport) {
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  if (childCount > 0) {
+    YGNodeSetViewport(node, viewport);
+  }
+  for (uint32_t i = 0; i < childCount; i++) {
+    setViewports(YGNodeGetChild(node, i), viewport);
+  }
+}
+
+// Clears what the next layout would read of this one besides its caches, so
+// that it doesn't depend on which children this one deferred: the flex bases,
+// which are kept while they are defined, and the positions and measured sizes,
+// which baselines are found from before they are set again.  Also marks every
+// node dirty.
+void forgetLayout(const YGNodeRef node) {
+  node->setLayoutComputedFlexBasis(YGFloatOptional());
+  for (int i = 0; i < 4; i++) {
+    node->setLayoutPosition(0, i);
+  }
+  node->setLayoutMeasuredDimension(YGUndefined, YGDimensionWidth);
+  node->setLayoutMeasuredDimension(YGUndefined, YGDimensionHeight);
+  node->setDirty(true);
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  for (uint32_t i = 0; i < childCount; i++) {
+    forgetLayout(YGNodeGetChild(node, i));
+  }
+}
+
+void collectNodes(const YGNodeRef node, std::vector<YGNodeRef>& nodes) {
+  nodes.push_back(node);
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  for (uint32_t i = 0; i < childCount; i++) {
+    collectNodes(YGNodeGetChild(node, i), nodes);
+  }
+}
+
+// A tree built for one path, freed with its config.
+struct BuiltTree {
+  YGConfigRef config;
+  YGNodeRef root = nullptr;
+  YGNodeRef clone = nullptr;
+
+  explicit BuiltTree(const Tree& tree) : config{tree.newConfig()} {}
+  ~BuiltTree() {
+    if (clone != nullptr) {
+      YGNodeFreeRecursive(clone);
+    }
+    if (root != nullptr) {
+      YGNodeFreeRecursive(root);
+    }
+    YGConfigFree(config);
+  }
+};
+
+// The paths lay the tree out, and return the root to compare.
+using Path = YGNodeRef (*)(const Tree&, BuiltTree&);
+
+YGNodeRef layOut(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+YGNodeRef layOutWithStyleUpdates(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config, Tree::Styling::StyleUpdates);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+YGNodeRef relayOut(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config);
+  tree.calculateLayoutAtOtherSize(built.root);
+  markLeavesDirty(built.root);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+YGNodeRef relayOutWithBatchMeasure(const Tree& tree, BuiltTree& built) {
+  YGConfigSetBatchMeasureFunc(built.config, batchMeasure);
+  return relayOut(tree, built);
+}
+
+YGNodeRef relayOutClone(const Tree& tree, BuiltTree& built) {
+  YGConfigSetCloneNodeFunc(built.config, cloneNode);
+  built.root = tree.build(built.config);
+  tree.calculateLayoutAtOtherSize(built.root);
+  markLeavesDirty(built.root);
+  built.clone = YGNodeClone(built.root);
+  tree.calculateLayout(built.clone);
+  return built.clone;
+}
+
+YGNodeRef relayOutRoundingEveryNode(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config);
+  tree.calculateLayoutAtOtherSize(built.root);
+  markLeavesDirty(built.root);
+  markUnrounded(built.root);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+YGNodeRef layOutWithViewports(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config);
+  setViewports(built.root, kEveryChildViewport);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+YGNodeRef relayOutForgetting(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config);
+  tree.calculateLayout(built.root);
+  forgetLayout(built.root);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+// Lays out the children that a first layout deferred, once the viewports move
+// to cover them.
+YGNodeRef relayOutDeferred(const Tree& tree, BuiltTree& built) {
+  built.root = tree.build(built.config);
+  setViewports(built.root, kFirstChildrenViewport);
+  tree.calculateLayout(built.root);
+  setViewports(built.root, kEveryChildViewport);
+  forgetLayout(built.root);
+  tree.calculateLayout(built.root);
+  return built.root;
+}
+
+TreeLayout layOutAlong(const Tree& tree, const Path path) {
+  BuiltTree built{tree};
+  TreeLayout layout;
+  recordLayout(path(tree, built), layout);
+  return layout;
+}
+
+// Checks the changed nodes that a pass collected against the layouts of the
+// nodes before and after it.  Every node changed if there was no layout
+// before.  Nodes changed if a value differs by more than Yoga's tolerance.
+std::string diffChangedNodes(
+    const char* pass,
+    const std::vector<YGNodeRef>& nodes,
+    const std::vector<YGNodeRef>& changedNodes,
+    const TreeLayout& before,
+    const TreeLayout& after) {
+  char description[256];
+  size_t next = 0;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const bool changed =
+        before.empty() || !sameLayout(before[i], after[i], kFloatTolerance);
+    const bool collected =
+        next < changedNodes.size() && changedNodes[next] == nodes[i];
+    if (collected) {
+      next++;
+    }
+    if (changed != collected) {
+      snprintf(
+          description,
+          sizeof(description),
+          "changed nodes: the %s %s node %zu",
+          pass,
+          changed ? "misses" : "collects the unchanged",
+          i);
+      return description;
+    }
+  }
+  if (next != changedNodes.size()) {
+    snprintf(
+        description,
+        sizeof(description),
+        "changed nodes: the %s collects nodes out of pre-order",
+        pass);
+    return description;
+  }
+  return "";
+}
+
+// Collects the changed nodes of a layout at the other size and of a relayout,
+// and compares the relayout with a plain one.
+std::string diffChangedNodes(const Tree& tree) {
+  BuiltTree built{tree};
+  built.root = tree.build(built.config);
+  std::vector<YGNodeRef> nodes;
+  collectNodes(built.root, nodes);
+
+  std::vector<YGNodeRef> changedNodes;
+  tree.calculateLayoutAtOtherSize(built.root, &changedNodes);
+  TreeLayout first;
+  recordLayout(built.root, first);
+  std::string description = diffChangedNodes(
+      "first layout", nodes, changedNodes, TreeLayout{}, first);
+  if (!description.empty()) {
+    return description;
+  }
+
+  markLeavesDirty(built.root);
+  tree.calculateLayout(built.root, &changedNodes);
+  TreeLayout second;
+  recordLayout(built.root, second);
+  description =
+      diffChangedNodes("relayout", nodes, changedNodes, first, second);
+  if (!description.empty()) {
+    return description;
+  }
+  return diff("changed nodes", layOutAlong(tree, relayOut), second);
+}
+
+} // namespace
+
+class Tree::Reader {
+public:
+  Reader(const uint8_t* data, size_t size) : data_{data}, size_{size} {}
+
+  uint8_t next() {
+    return offset_ < size_ ? data_[offset_++] : 0;
+  }
+
+private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+Tree::Tree(const uint8_t* data, size_t size) {
+  Reader reader{data, size};
+  const uint8_t flags = reader.next();
+  direction_ = (flags & 1) ? YGDirectionRTL : YGDirectionLTR;
+  useWebDefaults_ = (flags & 2) != 0;
+  useLegacyStretchBehaviour_ = (flags & 4) != 0;
+  useWebFlexBasis_ = (flags & 8) != 0;
+  pointScaleFactor_ = static_cast<float>((flags >> 4) & 3);
+  availableWidth_ = reader.next() % kAvailableSizes.size();
+  availableHeight_ = reader.next() % kAvailableSizes.size();
+  nodes_.reserve(kMaxNodeCount);
+  decodeNode(reader, 0);
+}
+
+size_t Tree::decodeNode(Reader& reader, size_t depth) {
+  const size_t index = nodes_.size();
+  nodes_.emplace_back();
+
+  const uint8_t flags = reader.next();
+  const uint8_t styleCount = flags & 7;
+  for (uint8_t i = 0; i < styleCount; i++) {
+    const uint32_t prop = reader.next() % YGStylePropCount;
+    nodes_[index].style.push_back(
+        YGStyleUpdate{prop, styleValue(prop, reader.next())});
+  }
+  nodes_[index].hasBaseline = (flags & 16) != 0;
+  if (flags & 8) {
+    nodes_[index].textLength = reader.next() % 64;
+    return index;
+  }
+  if (depth == kMaxDepth) {
+    return index;
+  }
+  const uint8_t childCount = reader.next() % 6;
+  for (uint8_t i = 0; i < childCount && nodes_.size() < kMaxNodeCount; i++) {
+    const size_t child = decodeNode(reader, depth + 1);
+    nodes_[index].children.push_back(child);
+  }
+  return index;
+}
+
+YGConfigRef Tree::newConfig() const {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetUseWebDefaults(config, useWebDefaults_);
+  YGConfigSetUseLegacyStretchBehaviour(config, useLegacyStretchBehaviour_);
+  YGConfigSetExperimentalFeatureEnabled(
+      config, YGExperimentalFeatureWebFlexBasis, useWebFlexBasis_);
+  YGConfigSetPointScaleFactor(config, pointScaleFactor_);
+  return config;
+}
+
+YGNodeRef Tree::build(YGConfigRef config, Styling styling) const {
+  return buildNode(config, styling, 0);
+}
+
+YGNodeRef Tree::buildNode(YGConfigRef config, Styling styling, size_t index)
+    const {
+  const Node& node = nodes_[index];
+  const YGNodeRef ygNode = YGNodeNewWithConfig(config);
+  if (styling == Styling::StyleUpdates) {
+    YGNodeStyleApplyUpdates(
+        ygNode, node.style.data(), static_cast<uint32_t>(node.style.size()));
+  } else {
+    for (const auto& update : node.style) {
+      setStyle(ygNode, update);
+    }
+  }
+  YGNodeSetContext(ygNode, const_cast<Node*>(&node));
+  if (node.textLength >= 0) {
+    YGNodeSetMeasureFunc(ygNode, measure);
+  }
+  if (node.hasBaseline) {
+    YGNodeSetBaselineFunc(ygNode, baseline);
+  }
+  for (size_t i = 0; i < node.children.size(); i++) {
+    YGNodeInsertChild(
+        ygNode,
+        buildNode(config, styling, node.children[i]),
+        static_cast<uint32_t>(i));
+  }
+  return ygNode;
+}
+
+void Tree::calculateLayout(
+    YGNodeRef root,
+    std::vector<YGNodeRef>* changedNodes) const {
+  calculateLayoutAt(
+      root,
+      kAvailableSizes[availableWidth_],
+      kAvailableSizes[availableHeight_],
+      direction_,
+      changedNodes);
+}
+
+void Tree::calculateLayoutAtOtherSize(
+    YGNodeRef root,
+    std::vector<YGNodeRef>* changedNodes) const {
+  calculateLayoutAt(
+      root,
+      kAvailableSizes[(availableWidth_ + 1) % kAvailableSizes.size()],
+      kAvailableSizes[(availableHeight_ + 3) % kAvailableSizes.size()],
+      direction_,
+      changedNodes);
+}
+
+std::string diffLayouts(const Tree& tree) {
+  // Rounding a node again may move it by an ulp or so, so the layouts that
+  // round every node again are compared with Yoga's tolerance.
+  const struct {
+    const char* name;
+    Path reference;
+    Path path;
+    float tolerance;
+  } paths[] = {
+      {"style updates", layOut, layOutWithStyleUpdates, 0},
+      {"viewport", layOut, layOutWithViewports, 0},
+      {"batch measure", relayOut, relayOutWithBatchMeasure, 0},
+      {"clone", relayOut, relayOutClone, 0},
+      {"rounding", relayOutRoundingEveryNode, relayOut, kFloatTolerance},
+      {"deferred", relayOutForgetting, relayOutDeferred, 0},
+  };
+  for (const auto& path : paths) {
+    const std::string description = diff(
+        path.name,
+        layOutAlong(tree, path.reference),
+        layOutAlong(tree, path.path),
+        path.tolerance);
+    if (!description.empty()) {
+      return description;
+    }
+  }
+  return diffChangedNodes(tree);
+}
+
+} // namespace fuzz
+} // namespace yoga
+} // namespace facebook
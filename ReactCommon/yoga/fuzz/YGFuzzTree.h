@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+namespace facebook {
+namespace yoga {
+namespace fuzz {
+
+// A tree of styled nodes decoded from the bytes of a fuzzer input, so that it
+// can be built as many times as needed.  Inputs that run out read zeros, so
+// every input decodes to a tree, and the empty input to a single node.
+//
+// The input is read as:
+//
+//   [0]  bit 0 for RTL, bit 1 for web defaults, bit 2 for legacy stretch,
+//        bit 3 for web flex basis, bits 4-5 for the point scale factor
+//   [1]  the available width, [2] the available height
+//
+// followed by the nodes in pre-order, each a byte with the number of style
+// properties in bits 0-2, whether it is a measured leaf in bit 3 and whether
+// it has a baseline function in bit 4, then two bytes per style property, the
+// length of its text if it is a leaf, and the number of its children if not.
+class Tree {
+public:
+  static constexpr size_t kMaxNodeCount = 256;
+  static constexpr size_t kMaxDepth = 8;
+
+  Tree(const uint8_t* data, size_t size);
+
+  // A new config set up as the input asks, to free with YGConfigFree.
+  YGConfigRef newConfig() const;
+
+  // How the style of the nodes is set.
+  enum class Styling { Setters, StyleUpdates };
+
+  // Builds the nodes with the config, to free with YGNodeFreeRecursive.
+  YGNodeRef build(YGConfigRef config, Styling styling = Styling::Setters)
+      const;
+
+  // Both add the nodes whose layout changed to changedNodes if it is given,
+  // see YGNodeCalculateLayoutWithChangedNodes.
+  void calculateLayout(
+      YGNodeRef root,
+      std::vector<YGNodeRef>* changedNodes = nullptr) const;
+
+  // Lays out at another available size, so that a following calculateLayout
+  // finds caches that are partly stale.
+  void calculateLayoutAtOtherSize(
+      YGNodeRef root,
+      std::vector<YGNodeRef>* changedNodes = nullptr) const;
+
+  size_t nodeCount() const { return nodes_.size(); }
+
+  struct Node {
+    std::vector<YGStyleUpdate> style;
+    // The length of its text for a measured leaf, or -1.
+    int textLength = -1;
+    bool hasBaseline = false;
+    std::vector<size_t> children;
+  };
+
+private:
+  class Reader;
+
+  size_t decodeNode(Reader& reader, size_t depth);
+  YGNodeRef buildNode(YGConfigRef config, Styling styling, size_t index)
+      const;
+
+  YGDirection direction_ = YGDirectionLTR;
+  bool useWebDefaults_ = false;
+  bool useLegacyStretchBehaviour_ = false;
+  bool useWebFlexBasis_ = false;
+  float pointScaleFactor_ = 0;
+  uint8_t availableWidth_ = 0;
+  uint8_t availableHeight_ = 0;
+  std::vector<Node> nodes_;
+};
+
+// Lays the tree out along each of the paths that layout optimizations take,
+// and along the path that gives the same layout without the optimization:
+// batched style updates against setters, viewports that cover every child
+// against none, and, after a layout at another size, batch measuring, cloned
+// nodes and rounding only the nodes laid out again against plain relayouts,
+// and laying out children that a first layout deferred against laying out
+// the same tree again without deferring any.  Relayouts are only compared
+// with relayouts, as they need not round like a first layout does.  Also
+// checks that the changed nodes of a relayout are the nodes whose layout
+// changed.  Returns a description of the first difference, or an empty string
+// if there is none.
+std::string diffLayouts(const Tree& tree);
+
+} // namespace fuzz
+} // namespace yoga
+} // namespace facebook
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fuzz/YGFuzzTree.h>
+
+using facebook::yoga::fuzz::Tree;
+using facebook::yoga::fuzz::diffLayouts;
+
+// Compares the layout of each input along the optimized paths from the layout
+// along the reference path, and aborts on the first difference so that the
+// fuzzer keeps the input as a crash.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  const Tree tree{data, size};
+  const std::string description = diffLayouts(tree);
+  if (!description.empty()) {
+    fprintf(stderr, "%s\n", description.c_str());
+    abort();
+  }
+  return 0;
+}
+
+#ifdef YG_FUZZ_STANDALONE
+
+// Without libFuzzer, runs the inputs in the files given, such as crashes to
+// reproduce, or else random inputs.
+int main(int argc, char** argv) {
+  std::vector<uint8_t> input;
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      FILE* file = fopen(argv[i], "rb");
+      if (file == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", argv[i]);
+        return 1;
+      }
+      input.clear();
+      int byte;
+      while ((byte = fgetc(file)) != EOF) {
+        input.push_back(static_cast<uint8_t>(byte));
+      }
+      fclose(file);
+      LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    return 0;
+  }
+
+  srand(2019);
+  for (int i = 0; i < 100000; i++) {
+    input.resize(rand() % 512);
+    for (auto& byte : input) {
+      byte = static_cast<uint8_t>(rand());
+    }
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+
+// Lays out each tree of the perf corpus, the slowest of many random inputs,
+// and fails if the median time of a full layout is over the budget that
+// perf/budgets.txt records for it.  With --record, prints the budgets to
+// record instead, with headroom over the times measured on this machine.
+//
+//   YGLayoutPerfCorpus [--record] <perf dir>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fuzz/YGFuzzTree.h>
+
+using facebook::yoga::fuzz::Tree;
+
+namespace {
+
+constexpr int kPasses = 101;
+constexpr double kHeadroom = 3;
+
+bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  data.clear();
+  int byte;
+  while ((byte = fgetc(file)) != EOF) {
+    data.push_back(static_cast<uint8_t>(byte));
+  }
+  fclose(file);
+  return true;
+}
+
+// The median time to lay out every node of the tree again.
+double medianLayoutNs(const Tree& tree) {
+  const YGConfigRef config = tree.newConfig();
+  const YGNodeRef root = tree.build(config);
+  tree.calculateLayout(root);
+
+  std::vector<double> elapsedNs;
+  for (int i = 0; i < kPasses; i++) {
+    YGNodeMarkDirtyAndPropogateToDescendants(root);
+    const auto start = std::chrono::steady_clock::now();
+    tree.calculateLayout(root);
+    elapsedNs.push_back(std::chrono::duration<double, std::nano>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  }
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  std::nth_element(
+      elapsedNs.begin(), elapsedNs.begin() + kPasses / 2, elapsedNs.end());
+  return elapsedNs[kPasses / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const bool record = argc > 1 && strcmp(argv[1], "--record") == 0;
+  if (argc != (record ? 3 : 2)) {
+    fprintf(stderr, "Usage: %s [--record] <perf dir>\n", argv[0]);
+    return 2;
+  }
+  const std::string dir = argv[argc - 1];
+
+  FILE* budgets = fopen((dir + "/budgets.txt").c_str(), "r");
+  if (budgets == nullptr) {
+    fprintf(stderr, "Cannot open %s/budgets.txt\n", dir.c_str());
+    return 2;
+  }
+  int overBudgetCount = 0;
+  char line[256];
+  std::vector<uint8_t> input;
+  while (fgets(line, sizeof(line), budgets) != nullptr) {
+    char name[128];
+    double budgetNs;
+    if (line[0] == '#' || sscanf(line, "%127s %lf", name, &budgetNs) != 2) {
+      continue;
+    }
+    if (!readFile(dir + "/" + name + ".bin", input)) {
+      fprintf(stderr, "Cannot open %s/%s.bin\n", dir.c_str(), name);
+      return 2;
+    }
+    const Tree tree{input.data(), input.size()};
+    const double ns = medianLayoutNs(tree);
+    if (record) {
+      printf("%s %.0f\n", name, ns * kHeadroom);
+    } else {
+      const bool overBudget = ns > budgetNs;
+      overBudgetCount += overBudget;
+      printf(
+          "%-12s %4zu nodes %10.0f ns, budget %10.0f ns%s\n",
+          name,
+          tree.nodeCount(),
+          ns,
+          budgetNs,
+          overBudget ? "  OVER BUDGET" : "");
+    }
+  }
+  fclose(budgets);
+  return overBudgetCount > 0 ? 1 : 0;
+}
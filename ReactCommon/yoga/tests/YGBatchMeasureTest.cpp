@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+static int measureCount = 0;
+static std::vector<YGMeasureRequest> batchRequests;
+static bool leaveBatchUndefined = false;
+
+// Text of the length in the context of the node, in lines of 4.5 points.
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const float length = (float) (uintptr_t) YGNodeGetContext(node);
+  const float lineWidth =
+      widthMode == YGMeasureModeUndefined ? length : std::min(width, length);
+  const float lines = std::ceil(length / std::max(lineWidth, 1.0f));
+  return YGSize{lineWidth,
+                heightMode == YGMeasureModeExactly ? height : lines * 4.5f};
+}
+
+static YGSize countingMeasureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  measureCount++;
+  return measureText(node, width, widthMode, height, heightMode);
+}
+
+static void batchMeasureText(YGMeasureRequest* requests, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    YGMeasureRequest& request = requests[i];
+    batchRequests.push_back(request);
+    if (!leaveBatchUndefined) {
+      request.size = measureText(
+          request.node,
+          request.width,
+          request.widthMode,
+          request.height,
+          request.heightMode);
+    }
+  }
+}
+
+// A column of rows, of a fixed size box and a column of two texts beside it.
+// The width of the texts doesn't depend on what they say, so they can be
+// measured ahead when that changes.
+class Screen {
+public:
+  explicit Screen(bool batch) {
+    config_ = YGConfigNew();
+    if (batch) {
+      YGConfigSetBatchMeasureFunc(config_, batchMeasureText);
+    }
+    root_ = YGNodeNewWithConfig(config_);
+    for (uint32_t i = 0; i < 5; i++) {
+      const YGNodeRef row = YGNodeNewWithConfig(config_);
+      YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+      YGNodeStyleSetPadding(row, YGEdgeAll, 3);
+      const YGNodeRef box = YGNodeNewWithConfig(config_);
+      YGNodeStyleSetWidth(box, 20);
+      YGNodeStyleSetHeight(box, 20);
+      YGNodeInsertChild(row, box, 0);
+      const YGNodeRef column = YGNodeNewWithConfig(config_);
+      YGNodeStyleSetFlexGrow(column, 1);
+      YGNodeStyleSetFlexBasis(column, 0);
+      YGNodeStyleSetMargin(column, YGEdgeLeft, 2);
+      YGNodeInsertChild(row, column, 1);
+      for (uint32_t j = 0; j < 2; j++) {
+        const YGNodeRef text = YGNodeNewWithConfig(config_);
+        YGNodeStyleSetPadding(text, YGEdgeHorizontal, 1);
+        YGNodeSetMeasureFunc(text, countingMeasureText);
+        YGNodeSetContext(text, (void*) (uintptr_t)(40 + 30 * i + 70 * j));
+        YGNodeInsertChild(column, text, j);
+      }
+      YGNodeInsertChild(root_, row, i);
+    }
+  }
+
+  ~Screen() {
+    YGNodeFreeRecursive(root_);
+    YGConfigFree(config_);
+  }
+
+  YGNodeRef text(uint32_t row, uint32_t index) const {
+    return YGNodeGetChild(YGNodeGetChild(YGNodeGetChild(root_, row), 1), index);
+  }
+
+  void setText(uint32_t row, uint32_t index, uintptr_t length) {
+    YGNodeSetContext(text(row, index), (void*) length);
+    YGNodeMarkDirty(text(row, index));
+  }
+
+  void layout(float width) {
+    YGNodeCalculateLayout(root_, width, YGUndefined, YGDirectionLTR);
+  }
+
+  void expectSameLayout(const Screen& screen) const {
+    expectSameLayout(root_, screen.root_);
+  }
+
+private:
+  static void expectSameLayout(YGNodeRef a, YGNodeRef b) {
+    EXPECT_EQ(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b));
+    EXPECT_EQ(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b));
+    EXPECT_EQ(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b));
+    EXPECT_EQ(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b));
+    for (uint32_t i = 0; i < YGNodeGetChildCount(a); i++) {
+      expectSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+    }
+  }
+
+  YGConfigRef config_;
+  YGNodeRef root_;
+};
+
+} // namespace
+
+TEST(YogaTest, batch_measure_measures_changed_text_ahead_of_layout) {
+  Screen screen{true}, reference{false};
+  batchRequests.clear();
+  screen.layout(200);
+  reference.layout(200);
+  ASSERT_TRUE(batchRequests.empty());
+
+  for (uint32_t row = 0; row < 5; row++) {
+    screen.setText(row, 0, 15 + 10 * row);
+    reference.setText(row, 0, 15 + 10 * row);
+  }
+  measureCount = 0;
+  screen.layout(200);
+
+  ASSERT_EQ(0, measureCount);
+  ASSERT_FALSE(batchRequests.empty());
+  for (const auto& request : batchRequests) {
+    const YGNodeRef column = YGNodeGetOwner(request.node);
+    ASSERT_EQ(request.node, YGNodeGetChild(column, 0));
+  }
+  reference.layout(200);
+  screen.expectSameLayout(reference);
+}
+
+TEST(YogaTest, batch_measure_falls_back_to_measure_func) {
+  Screen screen{true}, reference{false};
+  screen.layout(200);
+  reference.layout(200);
+
+  screen.setText(2, 1, 300);
+  reference.setText(2, 1, 300);
+  measureCount = 0;
+  batchRequests.clear();
+  screen.layout(150);
+  reference.layout(150);
+
+  ASSERT_FALSE(batchRequests.empty());
+  ASSERT_NE(0, measureCount);
+  screen.expectSameLayout(reference);
+}
+
+TEST(YogaTest, batch_measure_sizes_left_undefined_are_measured) {
+  Screen screen{true}, reference{false};
+  screen.layout(200);
+  reference.layout(200);
+
+  screen.setText(0, 0, 25);
+  reference.setText(0, 0, 25);
+  leaveBatchUndefined = true;
+  measureCount = 0;
+  batchRequests.clear();
+  screen.layout(200);
+  leaveBatchUndefined = false;
+  reference.layout(200);
+
+  ASSERT_FALSE(batchRequests.empty());
+  ASSERT_NE(0, measureCount);
+  screen.expectSameLayout(reference);
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <vector>
+
+namespace {
+
+class ChangedNodesTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    config_ = YGConfigNew();
+    root_ = YGNodeNewWithConfig(config_);
+    YGNodeStyleSetWidth(root_, 100);
+  }
+
+  void TearDown() override {
+    YGNodeFreeRecursive(root_);
+    YGConfigFree(config_);
+  }
+
+  YGNodeRef addChild(YGNodeRef owner) {
+    const YGNodeRef child = YGNodeNewWithConfig(config_);
+    YGNodeInsertChild(owner, child, YGNodeGetChildCount(owner));
+    return child;
+  }
+
+  std::vector<YGNodeRef> layOut(void* layoutContext = nullptr) {
+    std::vector<YGNodeRef> changedNodes;
+    YGNodeCalculateLayoutWithChangedNodes(
+        root_,
+        YGUndefined,
+        YGUndefined,
+        YGDirectionLTR,
+        layoutContext,
+        changedNodes);
+    return changedNodes;
+  }
+
+  YGConfigRef config_;
+  YGNodeRef root_;
+};
+
+} // namespace
+
+TEST_F(ChangedNodesTest, first_layout_collects_every_node_in_pre_order) {
+  const YGNodeRef a = addChild(root_);
+  const YGNodeRef a1 = addChild(a);
+  const YGNodeRef a2 = addChild(a);
+  const YGNodeRef b = addChild(root_);
+  const YGNodeRef b1 = addChild(b);
+
+  ASSERT_EQ((std::vector<YGNodeRef>{root_, a, a1, a2, b, b1}), layOut());
+  ASSERT_TRUE(layOut().empty());
+}
+
+TEST_F(ChangedNodesTest, localized_change_collects_exactly_the_changed_nodes) {
+  const YGNodeRef a = addChild(root_);
+  YGNodeStyleSetHeight(a, 10);
+  const YGNodeRef a1 = addChild(a);
+  YGNodeStyleSetWidth(a1, 10);
+  const YGNodeRef b = addChild(root_);
+  YGNodeStyleSetFlexDirection(b, YGFlexDirectionRow);
+  YGNodeStyleSetHeight(b, 20);
+  const YGNodeRef b1 = addChild(b);
+  YGNodeStyleSetWidth(b1, 10);
+  const YGNodeRef b2 = addChild(b);
+  YGNodeStyleSetWidth(b2, 10);
+  const YGNodeRef b21 = addChild(b2);
+  YGNodeStyleSetHeight(b21, 5);
+  const YGNodeRef c = addChild(root_);
+  YGNodeStyleSetHeight(c, 10);
+  layOut();
+
+  // b1 grows and b2 moves, with its child.  The sizes of b and the rest
+  // are fixed.
+  YGNodeStyleSetWidth(b1, 30);
+  ASSERT_EQ((std::vector<YGNodeRef>{b1, b2}), layOut());
+  ASSERT_EQ(30, YGNodeLayoutGetLeft(b2));
+  ASSERT_TRUE(layOut().empty());
+}
+
+TEST_F(ChangedNodesTest, list_item_change_collects_the_items_it_moves) {
+  std::vector<YGNodeRef> items;
+  for (int i = 0; i < 8; i++) {
+    items.push_back(addChild(root_));
+    YGNodeStyleSetHeight(items.back(), 10);
+    YGNodeStyleSetHeight(addChild(items.back()), 5);
+  }
+  layOut();
+
+  // The root grows and the items after the third one move.  Their children
+  // stay where they are within them, and the first items are untouched.
+  YGNodeStyleSetHeight(items[3], 12);
+  std::vector<YGNodeRef> expected = {root_, items[3]};
+  expected.insert(expected.end(), items.begin() + 4, items.end());
+  ASSERT_EQ(expected, layOut());
+}
+
+TEST_F(ChangedNodesTest, collects_changes_made_by_other_layout_calls) {
+  const YGNodeRef a = addChild(root_);
+  YGNodeStyleSetHeight(a, 10);
+  const YGNodeRef b = addChild(root_);
+  YGNodeStyleSetHeight(b, 10);
+  layOut();
+
+  YGNodeStyleSetHeight(a, 20);
+  YGNodeCalculateLayout(root_, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ((std::vector<YGNodeRef>{root_, a, b}), layOut());
+}
+
+TEST_F(ChangedNodesTest, passes_layout_context_to_measure_functions) {
+  const YGNodeRef text = addChild(root_);
+  text->setMeasureFunc(
+      [](YGNode*, float, YGMeasureMode, float, YGMeasureMode, void* ctx) {
+        return YGSize{10, *static_cast<float*>(ctx)};
+      });
+
+  float height = 7;
+  layOut(&height);
+  ASSERT_EQ(7, YGNodeLayoutGetHeight(text));
+}
@@ -0,0 +1,27 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <fuzz/YGFuzzTree.h>
+
+#include <random>
+
+using facebook::yoga::fuzz::Tree;
+using facebook::yoga::fuzz::diffLayouts;
+
+// A fixed sample of what the layout fuzzer runs, see fuzz/YGLayoutFuzzer.cpp.
+TEST(YogaTest, optimized_layout_paths_match_reference_layout) {
+  std::mt19937 random{2019};
+  std::vector<uint8_t> input;
+  for (int i = 0; i < 2000; i++) {
+    input.resize(random() % 512);
+    for (auto& byte : input) {
+      byte = static_cast<uint8_t>(random());
+    }
+    const Tree tree{input.data(), input.size()};
+    ASSERT_EQ("", diffLayouts(tree)) << "input " << i;
+  }
+}
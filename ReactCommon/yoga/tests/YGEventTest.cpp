@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+
+// Built against a yoga with YG_ENABLE_EVENTS, see BUCK.
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/event.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace facebook::yoga;
+
+namespace {
+
+struct AllocationEvent {
+  const YGNode* node;
+  YGConfig* config;
+};
+
+class YGEventTest : public ::testing::Test {
+protected:
+  void TearDown() override {
+    Event::reset();
+  }
+};
+
+} // namespace
+
+TEST_F(YGEventTest, config_subscribers_receive_node_allocation) {
+  const YGConfigRef config = YGConfigNew();
+  const YGConfigRef otherConfig = YGConfigNew();
+  std::vector<AllocationEvent> events;
+  Event::subscribe(
+      config, [&](const YGNode& node, Event::Type type, Event::Data data) {
+        if (type == Event::NodeAllocation) {
+          events.push_back(
+              {&node, data.get<Event::NodeAllocation>().config});
+        }
+      });
+
+  const YGNodeRef node = YGNodeNewWithConfig(config);
+  const YGNodeRef otherNode = YGNodeNewWithConfig(otherConfig);
+
+  ASSERT_EQ(1u, events.size());
+  ASSERT_EQ(node, events[0].node);
+  ASSERT_EQ(config, events[0].config);
+
+  YGNodeFree(node);
+  YGNodeFree(otherNode);
+  YGConfigFree(config);
+  YGConfigFree(otherConfig);
+}
+
+TEST_F(YGEventTest, subscribers_run_in_order_added) {
+  const YGConfigRef config = YGConfigNew();
+  std::vector<int> calls;
+  for (int i = 0; i < 3; i++) {
+    Event::subscribe([&calls, i](const YGNode&, Event::Type type, Event::Data) {
+      if (type == Event::NodeAllocation) {
+        calls.push_back(i);
+      }
+    });
+  }
+  Event::subscribe(
+      config, [&calls](const YGNode&, Event::Type type, Event::Data) {
+        if (type == Event::NodeAllocation) {
+          calls.push_back(3);
+        }
+      });
+
+  // Global subscribers first, then the config's.
+  const YGNodeRef node = YGNodeNewWithConfig(config);
+  ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), calls);
+
+  YGNodeFree(node);
+  YGConfigFree(config);
+}
+
+TEST_F(YGEventTest, reset_while_publishing) {
+  std::atomic<bool> entered{false};
+  std::atomic<bool> reset{false};
+  Event::subscribe([&](const YGNode&, Event::Type type, Event::Data) {
+    if (type == Event::NodeAllocation) {
+      entered = true;
+      while (!reset) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  Event::subscribe([](const YGNode&, Event::Type, Event::Data) {});
+
+  std::thread publisher([] { YGNodeFree(YGNodeNew()); });
+  while (!entered) {
+    std::this_thread::yield();
+  }
+  // The publisher is still calling the first subscriber, and goes on to the
+  // second once it returns.
+  Event::reset();
+  reset = true;
+  publisher.join();
+}
@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Lays out pairs of identical random trees through random style changes.  One
+// tree only rounds the nodes laid out since they were last rounded.  The other
+// starts every pass from the first tree's layout and rounds every node, as
+// rounding used to, and the two must agree.
+
+namespace {
+
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const float length = 10.0f + 7.3f * (uintptr_t) YGNodeGetContext(node);
+  const float lineWidth =
+      widthMode == YGMeasureModeUndefined ? length : std::min(width, length);
+  const float lines = std::ceil(length / std::max(lineWidth, 1.0f));
+  return YGSize{
+      lineWidth,
+      heightMode == YGMeasureModeExactly ? height : lines * 4.7f,
+  };
+}
+
+class TreePair {
+public:
+  explicit TreePair(uint32_t seed) : random_(seed) {
+    config_ = YGConfigNew();
+    changeScale();
+    incremental_ = build(0);
+    random_.seed(seed);
+    changeScale();
+    full_ = build(0);
+  }
+
+  ~TreePair() {
+    YGNodeFreeRecursive(incremental_);
+    YGNodeFreeRecursive(full_);
+    YGConfigFree(config_);
+  }
+
+  void layout() {
+    copyRoundedLayout(incremental_, full_);
+    const float width = 300.0f + next(7) * 0.35f;
+    YGNodeCalculateLayout(incremental_, width, YGUndefined, YGDirectionLTR);
+    YGNodeCalculateLayout(full_, width, YGUndefined, YGDirectionLTR);
+  }
+
+  // Applies the same style change to a node of each tree, or changes the
+  // scale both are rounded with.
+  void mutate() {
+    if (next(10) == 0) {
+      changeScale();
+      return;
+    }
+    std::vector<YGNodeRef> incrementalNodes, fullNodes;
+    collect(incremental_, incrementalNodes);
+    collect(full_, fullNodes);
+    const size_t index = next(incrementalNodes.size());
+    const uint32_t change = next(1000);
+    const float value = fraction();
+    applyStyle(incrementalNodes[index], change, value);
+    applyStyle(fullNodes[index], change, value);
+  }
+
+  void expectSameLayout() const {
+    expectSameLayout(incremental_, full_);
+  }
+
+private:
+  uint32_t next(size_t bound) {
+    return std::uniform_int_distribution<uint32_t>(0, bound - 1)(random_);
+  }
+
+  void changeScale() {
+    const float scales[] = {1.0f, 2.0f, 3.0f, 2.625f};
+    YGConfigSetPointScaleFactor(config_, scales[next(4)]);
+  }
+
+  float fraction() {
+    return next(1000) / 100.0f;
+  }
+
+  YGNodeRef build(int depth) {
+    const YGNodeRef node = YGNodeNewWithConfig(config_);
+    const uint32_t change = next(1000);
+    applyStyle(node, change, fraction());
+    const uint32_t childCount = depth < 4 ? next(5) : 0;
+    if (childCount == 0 && next(3) == 0) {
+      YGNodeSetContext(node, (void*) (uintptr_t) next(20));
+      YGNodeSetMeasureFunc(node, measureText);
+      YGNodeSetNodeType(node, YGNodeTypeText);
+      return node;
+    }
+    for (uint32_t i = 0; i < childCount; i++) {
+      YGNodeInsertChild(node, build(depth + 1), i);
+    }
+    return node;
+  }
+
+  static void applyStyle(YGNodeRef node, uint32_t change, float value) {
+    switch (change % 10) {
+      case 0:
+        YGNodeStyleSetWidth(node, 5.0f + value * 4);
+        break;
+      case 1:
+        YGNodeStyleSetHeight(node, 5.0f + value * 4);
+        break;
+      case 2:
+        YGNodeStyleSetFlexGrow(node, value / 5);
+        break;
+      case 3:
+        YGNodeStyleSetPadding(node, (YGEdge)(change % YGEdgeAll), value);
+        break;
+      case 4:
+        YGNodeStyleSetMargin(node, (YGEdge)(change % YGEdgeAll), value);
+        break;
+      case 5:
+        YGNodeStyleSetFlexDirection(node, (YGFlexDirection)(change % 4));
+        break;
+      case 6:
+        YGNodeStyleSetJustifyContent(node, (YGJustify)(change % 6));
+        break;
+      case 7:
+        YGNodeStyleSetPositionType(node, (YGPositionType)(change % 2));
+        YGNodeStyleSetPosition(node, YGEdgeLeft, value);
+        break;
+      case 8:
+        YGNodeStyleSetFlexWrap(node, (YGWrap)(change % 3));
+        break;
+      case 9:
+        YGNodeStyleSetDisplay(
+            node, change % 4 == 0 ? YGDisplayNone : YGDisplayFlex);
+        break;
+    }
+  }
+
+  static void collect(YGNodeRef node, std::vector<YGNodeRef>& nodes) {
+    nodes.push_back(node);
+    for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+      collect(YGNodeGetChild(node, i), nodes);
+    }
+  }
+
+  // Rounding again a node that wasn't laid out drifts by an ulp or so each
+  // time, which would add up over passes, so each pass compares the two from
+  // the same start.
+  static void copyRoundedLayout(YGNodeRef from, YGNodeRef to) {
+    const auto& layout = from->getLayout();
+    for (int i = 0; i < 4; i++) {
+      to->setLayoutPosition(layout.position[i], i);
+    }
+    for (int i = 0; i < 2; i++) {
+      to->setLayoutDimension(layout.dimensions[i], i);
+    }
+    to->setLayoutRoundedPointScaleFactor(0);
+    for (uint32_t i = 0; i < YGNodeGetChildCount(from); i++) {
+      copyRoundedLayout(YGNodeGetChild(from, i), YGNodeGetChild(to, i));
+    }
+  }
+
+  static void expectNear(float expected, float actual) {
+    if (!std::isnan(expected) || !std::isnan(actual)) {
+      EXPECT_NEAR(expected, actual, 0.0001f);
+    }
+  }
+
+  static void expectSameLayout(YGNodeRef incremental, YGNodeRef full) {
+    expectNear(YGNodeLayoutGetLeft(full), YGNodeLayoutGetLeft(incremental));
+    expectNear(YGNodeLayoutGetTop(full), YGNodeLayoutGetTop(incremental));
+    expectNear(YGNodeLayoutGetWidth(full), YGNodeLayoutGetWidth(incremental));
+    expectNear(YGNodeLayoutGetHeight(full), YGNodeLayoutGetHeight(incremental));
+    ASSERT_EQ(YGNodeGetChildCount(incremental), YGNodeGetChildCount(full));
+    for (uint32_t i = 0; i < YGNodeGetChildCount(incremental); i++) {
+      expectSameLayout(
+          YGNodeGetChild(incremental, i), YGNodeGetChild(full, i));
+    }
+  }
+
+  std::mt19937 random_;
+  YGConfigRef config_;
+  YGNodeRef incremental_;
+  YGNodeRef full_;
+};
+
+} // namespace
+
+TEST(YogaTest, incremental_rounding_matches_full_rounding) {
+  for (uint32_t seed = 0; seed < 200; seed++) {
+    SCOPED_TRACE(seed);
+    TreePair trees{seed};
+    trees.layout();
+    trees.expectSameLayout();
+    for (int pass = 0; pass < 10; pass++) {
+      trees.mutate();
+      trees.layout();
+      trees.expectSameLayout();
+    }
+  }
+}
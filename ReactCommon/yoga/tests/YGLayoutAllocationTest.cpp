@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counts the allocations made while counting is on.  Replacing the global
+// operator new affects the whole test binary, so counting is off otherwise.
+
+namespace {
+
+static bool countAllocations = false;
+static size_t allocationCount = 0;
+
+static YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{widthMode == YGMeasureModeUndefined ? 40 : width / 2, 10};
+}
+
+// Rows that wrap, of flexible and absolute children and of text.
+static YGNodeRef createTree(YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  for (uint32_t i = 0; i < 20; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetFlexWrap(row, YGWrapWrap);
+    YGNodeStyleSetWidthPercent(row, 40);
+    for (uint32_t j = 0; j < 6; j++) {
+      const YGNodeRef child = YGNodeNewWithConfig(config);
+      if (j % 3 == 0) {
+        YGNodeSetMeasureFunc(child, measureText);
+      } else if (j % 3 == 1) {
+        YGNodeStyleSetFlexGrow(child, 1);
+        YGNodeStyleSetWidth(child, 30);
+        YGNodeStyleSetHeight(child, 10);
+      } else {
+        YGNodeStyleSetPositionType(child, YGPositionTypeAbsolute);
+        YGNodeStyleSetPosition(child, YGEdgeLeft, 5);
+        YGNodeStyleSetWidth(child, 10);
+        YGNodeStyleSetHeight(child, 10);
+      }
+      YGNodeInsertChild(row, child, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+// Cached measurements past the first few are allocated the first time they're
+// needed, so the tree is laid out once at each width before counting.
+static void layOutAtEachWidth(YGNodeRef root) {
+  for (float width = 300; width < 311; width++) {
+    YGNodeCalculateLayout(root, width, YGUndefined, YGDirectionLTR);
+  }
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+  if (countAllocations) {
+    allocationCount++;
+  }
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+TEST(YogaTest, relayout_does_not_allocate) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = createTree(config);
+  layOutAtEachWidth(root);
+
+  const YGNodeRef text = YGNodeGetChild(YGNodeGetChild(root, 7), 3);
+  for (float width = 301; width < 311; width++) {
+    YGNodeMarkDirty(text);
+    countAllocations = true;
+    allocationCount = 0;
+    YGNodeCalculateLayout(root, width, YGUndefined, YGDirectionLTR);
+    countAllocations = false;
+    ASSERT_EQ(0u, allocationCount);
+  }
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, relayout_with_changed_nodes_does_not_allocate) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = createTree(config);
+  layOutAtEachWidth(root);
+  std::vector<YGNodeRef> changedNodes;
+  YGNodeCalculateLayoutWithChangedNodes(
+      root, 300, YGUndefined, YGDirectionLTR, nullptr, changedNodes);
+
+  const YGNodeRef text = YGNodeGetChild(YGNodeGetChild(root, 7), 3);
+  changedNodes.reserve(YGNodeGetChildCount(root) * 8);
+  for (float width = 301; width < 311; width++) {
+    YGNodeMarkDirty(text);
+    countAllocations = true;
+    allocationCount = 0;
+    YGNodeCalculateLayoutWithChangedNodes(
+        root, width, YGUndefined, YGDirectionLTR, nullptr, changedNodes);
+    countAllocations = false;
+    ASSERT_EQ(0u, allocationCount);
+    ASSERT_FALSE(changedNodes.empty());
+  }
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+namespace {
+
+static const uint32_t kChildCount = 1000;
+
+static int measureCount = 0;
+static int tallMeasureCount = 0;
+
+// Children are 10 high, and those with a context 20.
+static YGSize measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  measureCount++;
+  if (node->getContext() != nullptr) {
+    tallMeasureCount++;
+    return YGSize{width, 20};
+  }
+  return YGSize{width, 10};
+}
+
+static YGNodeRef createList() {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+  YGNodeStyleSetOverflow(root, YGOverflowScroll);
+  YGNodeStyleSetPadding(root, YGEdgeTop, 5);
+
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    const YGNodeRef child = YGNodeNew();
+    YGNodeSetMeasureFunc(child, measure);
+    YGNodeStyleSetFlexShrink(child, 0);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+static YGViewport viewportAt(float offset) {
+  return YGViewport{offset, 100, 50, 10};
+}
+
+} // namespace
+
+TEST(YogaTest, lazy_layout_lays_out_children_within_viewport) {
+  const YGNodeRef root = createList();
+  YGNodeSetViewport(root, viewportAt(0));
+
+  measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // The viewport and its overscan span the first 15 children.
+  ASSERT_EQ(15, measureCount);
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    const YGNodeRef child = YGNodeGetChild(root, i);
+    ASSERT_EQ(i >= 15, YGNodeLayoutGetIsDeferred(child));
+    ASSERT_EQ(i >= 15, YGNodeIsDirty(child));
+    ASSERT_FLOAT_EQ(5 + 10 * i, YGNodeLayoutGetTop(child));
+    ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(child));
+    ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(child));
+  }
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, lazy_layout_matches_full_layout_within_viewport) {
+  const YGNodeRef lazy = createList();
+  const YGNodeRef full = createList();
+  for (uint32_t i = 0; i < kChildCount; i += 3) {
+    YGNodeSetContext(YGNodeGetChild(lazy, i), lazy);
+    YGNodeSetContext(YGNodeGetChild(full, i), full);
+  }
+  // Scrolled to, so that the children before the viewport were laid out and
+  // keep the size they were laid out at. The children after them are then
+  // where they would be in a full layout.
+  for (float offset = 0; offset <= 2000; offset += 100) {
+    YGNodeSetViewport(lazy, viewportAt(offset));
+    YGNodeCalculateLayout(lazy, YGUndefined, YGUndefined, YGDirectionLTR);
+  }
+  YGNodeCalculateLayout(full, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    const YGNodeRef lazyChild = YGNodeGetChild(lazy, i);
+    const YGNodeRef fullChild = YGNodeGetChild(full, i);
+    const float top = YGNodeLayoutGetTop(fullChild);
+    if (top + YGNodeLayoutGetHeight(fullChild) < 2000 - 50 + 5 ||
+        top > 2000 + 100 + 50) {
+      continue;
+    }
+    ASSERT_FALSE(YGNodeLayoutGetIsDeferred(lazyChild));
+    ASSERT_FLOAT_EQ(top, YGNodeLayoutGetTop(lazyChild));
+    ASSERT_FLOAT_EQ(
+        YGNodeLayoutGetHeight(fullChild), YGNodeLayoutGetHeight(lazyChild));
+  }
+
+  YGNodeFreeRecursive(lazy);
+  YGNodeFreeRecursive(full);
+}
+
+TEST(YogaTest, lazy_layout_measures_dirty_children_once_within_viewport) {
+  const YGNodeRef root = createList();
+  YGNodeSetViewport(root, viewportAt(0));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Children that were laid out and scrolled past keep their size.
+  const YGNodeRef child = YGNodeGetChild(root, 2);
+  YGNodeSetViewport(root, viewportAt(500));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(YGNodeLayoutGetIsDeferred(child));
+  ASSERT_FALSE(YGNodeIsDirty(child));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(child));
+
+  YGNodeSetContext(child, root);
+  YGNodeMarkDirty(child);
+  YGNodeSetViewport(root, viewportAt(600));
+  tallMeasureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, tallMeasureCount);
+  ASSERT_TRUE(YGNodeLayoutGetIsDeferred(child));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(child));
+
+  YGNodeSetViewport(root, viewportAt(0));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(1, tallMeasureCount);
+  ASSERT_FALSE(YGNodeLayoutGetIsDeferred(child));
+  ASSERT_FLOAT_EQ(20, YGNodeLayoutGetHeight(child));
+  ASSERT_FLOAT_EQ(45, YGNodeLayoutGetTop(YGNodeGetChild(root, 3)));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, lazy_layout_lays_out_all_children_without_viewport) {
+  const YGNodeRef root = createList();
+  YGNodeSetViewport(root, viewportAt(0));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  YGNodeClearViewport(root);
+  measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(kChildCount - 15, measureCount);
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    ASSERT_FALSE(YGNodeLayoutGetIsDeferred(YGNodeGetChild(root, i)));
+    ASSERT_FALSE(YGNodeIsDirty(YGNodeGetChild(root, i)));
+  }
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, lazy_layout_drops_predicted_flex_basis_once_laid_out) {
+  const YGNodeRef root = createList();
+  YGNodeStyleSetHeightAuto(root);
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    YGNodeStyleSetFlexBasis(YGNodeGetChild(root, i), 30);
+  }
+  // Without a height the flex basis doesn't apply, so deferred children get
+  // the estimated child size as their flex basis instead.
+  YGNodeSetViewport(root, viewportAt(0));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(YGNodeLayoutGetIsDeferred(YGNodeGetChild(root, 15)));
+
+  YGNodeStyleSetHeight(root, 100);
+  YGNodeClearViewport(root);
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    YGNodeMarkDirty(YGNodeGetChild(root, i));
+  }
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  for (uint32_t i = 0; i < kChildCount; i++) {
+    const YGNodeRef child = YGNodeGetChild(root, i);
+    ASSERT_FLOAT_EQ(5 + 30 * i, YGNodeLayoutGetTop(child));
+    ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(child));
+  }
+
+  YGNodeFreeRecursive(root);
+}
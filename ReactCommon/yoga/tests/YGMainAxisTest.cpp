@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+// Containers are laid out by code instantiated for each main axis, so the same
+// children are laid out along each of them, in both directions.
+
+namespace {
+
+struct Expected {
+  YGFlexDirection flexDirection;
+  YGDirection direction;
+  float left[2];
+  float top[2];
+  float width;
+  float height;
+};
+
+static const Expected kExpected[] = {
+    {YGFlexDirectionColumn, YGDirectionLTR, {7, 7}, {7, 21}, 86, 10},
+    {YGFlexDirectionColumn, YGDirectionRTL, {7, 7}, {7, 21}, 86, 10},
+    {YGFlexDirectionColumnReverse, YGDirectionLTR, {7, 7}, {83, 69}, 86, 10},
+    {YGFlexDirectionColumnReverse, YGDirectionRTL, {7, 7}, {83, 69}, 86, 10},
+    {YGFlexDirectionRow, YGDirectionLTR, {7, 31}, {7, 7}, 20, 86},
+    {YGFlexDirectionRow, YGDirectionRTL, {73, 49}, {7, 7}, 20, 86},
+    {YGFlexDirectionRowReverse, YGDirectionLTR, {73, 49}, {7, 7}, 20, 86},
+    {YGFlexDirectionRowReverse, YGDirectionRTL, {7, 31}, {7, 7}, 20, 86},
+};
+
+} // namespace
+
+TEST(YogaTest, children_are_laid_out_along_each_main_axis) {
+  for (const Expected& expected : kExpected) {
+    SCOPED_TRACE(YGFlexDirectionToString(expected.flexDirection));
+    SCOPED_TRACE(YGDirectionToString(expected.direction));
+
+    const bool isRow = expected.flexDirection == YGFlexDirectionRow ||
+        expected.flexDirection == YGFlexDirectionRowReverse;
+    const YGNodeRef root = YGNodeNew();
+    YGNodeStyleSetFlexDirection(root, expected.flexDirection);
+    YGNodeStyleSetWidth(root, 100);
+    YGNodeStyleSetHeight(root, 100);
+    YGNodeStyleSetPadding(root, YGEdgeAll, 3);
+    YGNodeStyleSetBorder(root, YGEdgeAll, 2);
+    for (uint32_t i = 0; i < 2; i++) {
+      const YGNodeRef child = YGNodeNew();
+      YGNodeStyleSetFlexBasis(child, isRow ? 20 : 10);
+      YGNodeStyleSetMargin(child, YGEdgeAll, 2);
+      YGNodeInsertChild(root, child, i);
+    }
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, expected.direction);
+
+    for (uint32_t i = 0; i < 2; i++) {
+      const YGNodeRef child = YGNodeGetChild(root, i);
+      ASSERT_FLOAT_EQ(expected.left[i], YGNodeLayoutGetLeft(child));
+      ASSERT_FLOAT_EQ(expected.top[i], YGNodeLayoutGetTop(child));
+      ASSERT_FLOAT_EQ(expected.width, YGNodeLayoutGetWidth(child));
+      ASSERT_FLOAT_EQ(expected.height, YGNodeLayoutGetHeight(child));
+    }
+
+    YGNodeFreeRecursive(root);
+  }
+}
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+namespace {
+
+static int dirtiedCount = 0;
+
+static void countDirtied(YGNodeRef node) {
+  dirtiedCount++;
+}
+
+static const YGStyleUpdate kUpdates[] = {
+    {YGStylePropFlexDirection, {YGFlexDirectionRow, YGUnitPoint}},
+    {YGStylePropAlignItems, {YGAlignCenter, YGUnitPoint}},
+    {YGStylePropFlexGrow, {2, YGUnitPoint}},
+    {YGStylePropFlexBasis, {30, YGUnitPercent}},
+    {YGStylePropMargin + YGEdgeTop, {4, YGUnitPoint}},
+    {YGStylePropMargin + YGEdgeHorizontal, {0, YGUnitAuto}},
+    {YGStylePropPosition + YGEdgeLeft, {10, YGUnitPercent}},
+    {YGStylePropPadding + YGEdgeAll, {3, YGUnitPoint}},
+    {YGStylePropBorder + YGEdgeBottom, {1, YGUnitPoint}},
+    {YGStylePropDimensions + YGDimensionWidth, {50, YGUnitPercent}},
+    {YGStylePropDimensions + YGDimensionHeight, {0, YGUnitAuto}},
+    {YGStylePropMinDimensions + YGDimensionHeight, {20, YGUnitPoint}},
+    {YGStylePropMaxDimensions + YGDimensionWidth, {80, YGUnitPoint}},
+    {YGStylePropAspectRatio, {1.5f, YGUnitPoint}},
+};
+
+static void setStyle(YGNodeRef node) {
+  YGNodeStyleSetFlexDirection(node, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(node, YGAlignCenter);
+  YGNodeStyleSetFlexGrow(node, 2);
+  YGNodeStyleSetFlexBasisPercent(node, 30);
+  YGNodeStyleSetMargin(node, YGEdgeTop, 4);
+  YGNodeStyleSetMarginAuto(node, YGEdgeHorizontal);
+  YGNodeStyleSetPositionPercent(node, YGEdgeLeft, 10);
+  YGNodeStyleSetPadding(node, YGEdgeAll, 3);
+  YGNodeStyleSetBorder(node, YGEdgeBottom, 1);
+  YGNodeStyleSetWidthPercent(node, 50);
+  YGNodeStyleSetHeightAuto(node);
+  YGNodeStyleSetMinHeight(node, 20);
+  YGNodeStyleSetMaxWidth(node, 80);
+  YGNodeStyleSetAspectRatio(node, 1.5f);
+}
+
+} // namespace
+
+TEST(YogaTest, style_updates_set_style_as_setters_do) {
+  const YGNodeRef updated = YGNodeNew();
+  const YGNodeRef set = YGNodeNew();
+  YGNodeStyleApplyUpdates(
+      updated, kUpdates, sizeof(kUpdates) / sizeof(kUpdates[0]));
+  setStyle(set);
+
+  ASSERT_TRUE(updated->getStyle() == set->getStyle());
+  ASSERT_EQ(
+      set->getStyle().assignedProps(), updated->getStyle().assignedProps());
+
+  YGNodeFree(updated);
+  YGNodeFree(set);
+}
+
+TEST(YogaTest, style_updates_mark_dirty_once_if_changed) {
+  const YGNodeRef root = YGNodeNew();
+  const YGNodeRef child = YGNodeNew();
+  YGNodeInsertChild(root, child, 0);
+  YGNodeStyleApplyUpdates(child, kUpdates, 2);
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  YGNodeSetDirtiedFunc(child, countDirtied);
+  YGNodeSetDirtiedFunc(root, countDirtied);
+
+  dirtiedCount = 0;
+  YGNodeStyleApplyUpdates(child, kUpdates, 2);
+  ASSERT_FALSE(YGNodeIsDirty(child));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+  ASSERT_EQ(0, dirtiedCount);
+
+  YGNodeStyleApplyUpdates(
+      child, kUpdates, sizeof(kUpdates) / sizeof(kUpdates[0]));
+  ASSERT_TRUE(YGNodeIsDirty(child));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  ASSERT_EQ(2, dirtiedCount);
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaDeathTest, style_updates_reject_units_without_setters) {
+  const YGStyleUpdate kUnsupported[] = {
+      {YGStylePropPadding + YGEdgeLeft, {0, YGUnitAuto}},
+      {YGStylePropPosition + YGEdgeTop, {0, YGUnitAuto}},
+      {YGStylePropBorder + YGEdgeAll, {0, YGUnitAuto}},
+      {YGStylePropBorder + YGEdgeAll, {10, YGUnitPercent}},
+      {YGStylePropMinDimensions + YGDimensionWidth, {0, YGUnitAuto}},
+      {YGStylePropMaxDimensions + YGDimensionHeight, {0, YGUnitAuto}},
+  };
+  const YGNodeRef node = YGNodeNew();
+  for (const YGStyleUpdate& update : kUnsupported) {
+    ASSERT_DEATH(
+        YGNodeStyleApplyUpdates(node, &update, 1), "to an unsupported unit");
+  }
+  YGNodeFree(node);
+}
@@ -32,8 +32,60 @@
 //   and it may or may not be part of the current line(as it may be absolutely
 //   positioned or inculding it may have caused to overshoot availableInnerDim)
 //
-// - relativeChildren: Maintain a vector of the child nodes that can shrink
-//   and/or grow.
+// - relativeChildren: The child nodes that can shrink and/or grow.
+
+// The children of a line that are neither hidden nor absolutely positioned.
+// A view over the owner's children rather than a copy, so that collecting the
+// lines of a layout pass doesn't allocate.  Indexes rather than iterators, as
+// children are laid out while it's iterated.
+class YGLineChildren {
+public:
+  class iterator {
+  public:
+    iterator(const YGVector* children, uint32_t index, uint32_t end)
+        : children_(children), index_(index), end_(end) {
+      skipIgnoredChildren();
+    }
+
+    YGNodeRef operator*() const { return (*children_)[index_]; }
+
+    iterator& operator++() {
+      index_++;
+      skipIgnoredChildren();
+      return *this;
+    }
+
+    bool operator!=(const iterator& other) const {
+      return index_ != other.index_;
+    }
+
+  private:
+    const YGVector* children_;
+    uint32_t index_;
+    uint32_t end_;
+
+    void skipIgnoredChildren() {
+      while (index_ < end_ &&
+             ((*children_)[index_]->getStyle().display() == YGDisplayNone ||
+              (*children_)[index_]->getStyle().positionType() ==
+                  YGPositionTypeAbsolute)) {
+        index_++;
+      }
+    }
+  };
+
+  YGLineChildren() = default;
+  YGLineChildren(const YGVector& children, uint32_t start, uint32_t end)
+      : children_(&children), start_(start), end_(end) {}
+
+  iterator begin() const { return iterator{children_, start_, end_}; }
+  iterator end() const { return iterator{children_, end_, end_}; }
+
+private:
+  const YGVector* children_ = nullptr;
+  uint32_t start_ = 0;
+  uint32_t end_ = 0;
+};
 
 struct YGCollectFlexItemsRowValues {
   uint32_t itemsOnLine;
@@ -41,7 +93,7 @@ struct YGCollectFlexItemsRowValues {
   float totalFlexGrowFactors;
   float totalFlexShrinkScaledFactors;
   uint32_t endOfLineIndex;
-  std::vector<YGNodeRef> relativeChildren;
+  YGLineChildren relativeChildren;
   float remainingFreeSpace;
   // The size of the mainDim for the row after considering size, padding, margin
   // and border of flex items. This is used to calculate maxLineDim after going
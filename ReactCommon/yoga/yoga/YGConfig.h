@@ -9,6 +9,12 @@
 #include "Yoga-internal.h"
 #include "Yoga.h"
 
+namespace facebook {
+namespace yoga {
+class EventSubscribers;
+}
+} // namespace facebook
+
 struct YGConfig {
   using LogWithContextFn = int (*)(
       YGConfigRef config,
@@ -45,6 +51,10 @@ public:
       experimentalFeatures = {};
   void* context = nullptr;
   YGMarkerCallbacks markerCallbacks = {nullptr, nullptr};
+  YGBatchMeasureFunc batchMeasureFunc = nullptr;
+  // Created by the first Event::subscribe for the config, and deleted with it.
+  // Not copied by YGConfigCopy.
+  facebook::yoga::EventSubscribers* eventSubscribers = nullptr;
 
   YGConfig(YGLogger logger);
   void log(YGConfig*, YGNode*, YGLogLevel, void*, const char*, va_list);
@@ -9,22 +9,55 @@
 
 using namespace facebook;
 
-bool YGLayout::operator==(YGLayout layout) const {
+YGCachedMeasurements& YGCachedMeasurements::operator=(
+    const YGCachedMeasurements& measurements) {
+  inline_ = measurements.inline_;
+  if (measurements.spilled_ == nullptr) {
+    spilled_ = nullptr;
+  } else if (spilled_ == nullptr) {
+    spilled_.reset(new Spilled(*measurements.spilled_));
+  } else {
+    *spilled_ = *measurements.spilled_;
+  }
+  return *this;
+}
+
+bool YGCachedMeasurements::operator==(
+    const YGCachedMeasurements& measurements) const {
+  for (uint32_t i = 0; i < YG_INLINE_CACHED_RESULT_COUNT; ++i) {
+    if (!(inline_[i] == measurements.inline_[i])) {
+      return false;
+    }
+  }
+  // Entries that were never allocated are as good as default ones.
+  const YGCachedMeasurement unused;
+  for (uint32_t i = 0;
+       i < YG_MAX_CACHED_RESULT_COUNT - YG_INLINE_CACHED_RESULT_COUNT;
+       ++i) {
+    const auto& a = spilled_ ? (*spilled_)[i] : unused;
+    const auto& b =
+        measurements.spilled_ ? (*measurements.spilled_)[i] : unused;
+    if (!(a == b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool YGLayout::operator==(const YGLayout& layout) const {
   bool isEqual = YGFloatArrayEqual(position, layout.position) &&
       YGFloatArrayEqual(dimensions, layout.dimensions) &&
       YGFloatArrayEqual(margin, layout.margin) &&
       YGFloatArrayEqual(border, layout.border) &&
       YGFloatArrayEqual(padding, layout.padding) &&
       direction == layout.direction && hadOverflow == layout.hadOverflow &&
+      isDeferred == layout.isDeferred &&
       lastOwnerDirection == layout.lastOwnerDirection &&
       nextCachedMeasurementsIndex == layout.nextCachedMeasurementsIndex &&
       cachedLayout == layout.cachedLayout &&
+      cachedMeasurements == layout.cachedMeasurements &&
       computedFlexBasis == layout.computedFlexBasis;
 
-  for (uint32_t i = 0; i < YG_MAX_CACHED_RESULT_COUNT && isEqual; ++i) {
-    isEqual = isEqual && cachedMeasurements[i] == layout.cachedMeasurements[i];
-  }
-
   if (!yoga::isUndefined(measuredDimensions[0]) ||
       !yoga::isUndefined(layout.measuredDimensions[0])) {
     isEqual =
@@ -38,3 +71,25 @@ bool YGLayout::operator==(YGLayout layout) const {
 
   return isEqual;
 }
+
+bool YGLayoutOutputs::operator==(const YGLayoutOutputs& outputs) const {
+  return YGFloatArrayEqual(position, outputs.position) &&
+      YGFloatArrayEqual(dimensions, outputs.dimensions) &&
+      YGFloatArrayEqual(margin, outputs.margin) &&
+      YGFloatArrayEqual(border, outputs.border) &&
+      YGFloatArrayEqual(padding, outputs.padding) &&
+      direction == outputs.direction;
+}
+
+bool YGRecordedLayoutOutputs::record(const YGLayout& layout) {
+  const YGLayoutOutputs outputs{layout};
+  if (outputs_ == nullptr) {
+    outputs_.reset(new YGLayoutOutputs(outputs));
+    return true;
+  }
+  if (outputs == *outputs_) {
+    return false;
+  }
+  *outputs_ = outputs;
+  return true;
+}
@@ -5,12 +5,49 @@
  * file in the root directory of this source tree.
  */
 #pragma once
+#include <memory>
 #include "YGFloatOptional.h"
 #include "Yoga-internal.h"
 
 constexpr std::array<float, 2> kYGDefaultDimensionValues = {
     {YGUndefined, YGUndefined}};
 
+// The measurements cached for a node, YG_INLINE_CACHED_RESULT_COUNT of them
+// inline.  The rest are allocated the first time one of them is used, and kept
+// until the layout is replaced.
+class YGCachedMeasurements {
+  using Spilled = std::array<
+      YGCachedMeasurement,
+      YG_MAX_CACHED_RESULT_COUNT - YG_INLINE_CACHED_RESULT_COUNT>;
+
+  std::array<YGCachedMeasurement, YG_INLINE_CACHED_RESULT_COUNT> inline_ = {};
+  std::unique_ptr<Spilled> spilled_ = nullptr;
+
+public:
+  YGCachedMeasurements() = default;
+  YGCachedMeasurements(const YGCachedMeasurements& measurements)
+      : inline_(measurements.inline_),
+        spilled_(
+            measurements.spilled_ ? new Spilled(*measurements.spilled_)
+                                  : nullptr) {}
+  YGCachedMeasurements(YGCachedMeasurements&&) = default;
+
+  YGCachedMeasurements& operator=(const YGCachedMeasurements& measurements);
+  YGCachedMeasurements& operator=(YGCachedMeasurements&&) = default;
+
+  YGCachedMeasurement& operator[](uint32_t index) {
+    if (index < YG_INLINE_CACHED_RESULT_COUNT) {
+      return inline_[index];
+    }
+    if (spilled_ == nullptr) {
+      spilled_.reset(new Spilled());
+    }
+    return (*spilled_)[index - YG_INLINE_CACHED_RESULT_COUNT];
+  }
+
+  bool operator==(const YGCachedMeasurements& measurements) const;
+};
+
 struct YGLayout {
   std::array<float, 4> position = {};
   std::array<float, 2> dimensions = kYGDefaultDimensionValues;
@@ -21,6 +58,7 @@ struct YGLayout {
   bool didUseLegacyFlag : 1;
   bool doesLegacyStretchFlagAffectsLayout : 1;
   bool hadOverflow : 1;
+  bool isDeferred : 1;
 
   uint32_t computedFlexBasisGeneration = 0;
   YGFloatOptional computedFlexBasis = {};
@@ -31,18 +69,67 @@ struct YGLayout {
   YGDirection lastOwnerDirection = (YGDirection) -1;
 
   uint32_t nextCachedMeasurementsIndex = 0;
-  std::array<YGCachedMeasurement, YG_MAX_CACHED_RESULT_COUNT>
-      cachedMeasurements = {};
+  YGCachedMeasurements cachedMeasurements = {};
   std::array<float, 2> measuredDimensions = kYGDefaultDimensionValues;
 
   YGCachedMeasurement cachedLayout = YGCachedMeasurement();
 
+  // The point scale factor that position and dimensions were last rounded to
+  // the pixel grid with, or 0 if either has been set since.
+  float roundedPointScaleFactor = 0;
+
   YGLayout()
       : direction(YGDirectionInherit),
         didUseLegacyFlag(false),
         doesLegacyStretchFlagAffectsLayout(false),
-        hadOverflow(false) {}
+        hadOverflow(false),
+        isDeferred(false) {}
+
+  bool operator==(const YGLayout& layout) const;
+  bool operator!=(const YGLayout& layout) const { return !(*this == layout); }
+};
+
+// The parts of a YGLayout that hosts read once layout is done.
+struct YGLayoutOutputs {
+  std::array<float, 4> position = {};
+  std::array<float, 2> dimensions = kYGDefaultDimensionValues;
+  std::array<float, 4> margin = {};
+  std::array<float, 4> border = {};
+  std::array<float, 4> padding = {};
+  YGDirection direction = YGDirectionInherit;
+
+  YGLayoutOutputs() = default;
+  explicit YGLayoutOutputs(const YGLayout& layout)
+      : position(layout.position),
+        dimensions(layout.dimensions),
+        margin(layout.margin),
+        border(layout.border),
+        padding(layout.padding),
+        direction(layout.direction) {}
+
+  bool operator==(const YGLayoutOutputs& outputs) const;
+  bool operator!=(const YGLayoutOutputs& outputs) const {
+    return !(*this == outputs);
+  }
+};
+
+// The YGLayoutOutputs a node last reported, allocated the first time they are
+// recorded, so that nodes never laid out through
+// YGNodeCalculateLayoutWithChangedNodes don't pay for them.
+class YGRecordedLayoutOutputs {
+  std::unique_ptr<YGLayoutOutputs> outputs_ = nullptr;
+
+public:
+  YGRecordedLayoutOutputs() = default;
+  YGRecordedLayoutOutputs(const YGRecordedLayoutOutputs& recorded)
+      : outputs_(
+            recorded.outputs_ ? new YGLayoutOutputs(*recorded.outputs_)
+                              : nullptr) {}
+  YGRecordedLayoutOutputs(YGRecordedLayoutOutputs&&) = default;
+
+  YGRecordedLayoutOutputs& operator=(YGRecordedLayoutOutputs&&) = default;
 
-  bool operator==(YGLayout layout) const;
-  bool operator!=(YGLayout layout) const { return !(*this == layout); }
+  // Records the outputs of the given layout, returning whether they differ
+  // from those recorded last time.  The first ones always differ.
+  bool record(const YGLayout& layout);
 };
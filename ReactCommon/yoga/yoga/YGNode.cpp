@@ -22,17 +22,20 @@ YGNode::YGNode(YGNode&& node) {
   measureUsesContext_ = node.measureUsesContext_;
   baselineUsesContext_ = node.baselineUsesContext_;
   printUsesContext_ = node.printUsesContext_;
+  hasRecordedLayoutOutputs_ = node.hasRecordedLayoutOutputs_;
   measure_ = node.measure_;
   baseline_ = node.baseline_;
   print_ = node.print_;
   dirtied_ = node.dirtied_;
   style_ = node.style_;
-  layout_ = node.layout_;
+  layout_ = std::move(node.layout_);
+  recordedLayoutOutputs_ = std::move(node.recordedLayoutOutputs_);
   lineIndex_ = node.lineIndex_;
   owner_ = node.owner_;
   children_ = std::move(node.children_);
   config_ = node.config_;
   resolvedDimensions_ = node.resolvedDimensions_;
+  viewport_ = std::move(node.viewport_);
   for (auto c : children_) {
     c->setOwner(c);
   }
@@ -60,7 +63,7 @@ YGFloatOptional YGNode::getLeadingPosition(
   }
 
   auto leadingPosition = YGComputedEdgeValue(
-      style_.position(), leading[axis], CompactValue::ofUndefined());
+      style_.position(), YGLeadingEdge(axis), CompactValue::ofUndefined());
 
   return leadingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -92,7 +95,7 @@ bool YGNode::isLeadingPositionDefined(const YGFlexDirection axis) const {
                style_.position(), YGEdgeStart, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position(), leading[axis], CompactValue::ofUndefined())
+           style_.position(), YGLeadingEdge(axis), CompactValue::ofUndefined())
            .isUndefined();
 }
 
@@ -106,8 +109,9 @@ bool YGNode::isTrailingPosDefined(const YGFlexDirection axis) const {
            .isUndefined();
 }
 
+template <typename Axis>
 YGFloatOptional YGNode::getLeadingMargin(
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) const {
   if (YGFlexDirectionIsRow(axis) &&
       !style_.margin()[YGEdgeStart].isUndefined()) {
@@ -116,12 +120,13 @@ YGFloatOptional YGNode::getLeadingMargin(
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin(), leading[axis], CompactValue::ofZero()),
+          style_.margin(), YGLeadingEdge(axis), CompactValue::ofZero()),
       widthSize);
 }
 
+template <typename Axis>
 YGFloatOptional YGNode::getTrailingMargin(
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) const {
   if (YGFlexDirectionIsRow(axis) && !style_.margin()[YGEdgeEnd].isUndefined()) {
     return YGResolveValueMargin(style_.margin()[YGEdgeEnd], widthSize);
@@ -129,12 +134,13 @@ YGFloatOptional YGNode::getTrailingMargin(
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin(), trailing[axis], CompactValue::ofZero()),
+          style_.margin(), YGTrailingEdge(axis), CompactValue::ofZero()),
       widthSize);
 }
 
+template <typename Axis>
 YGFloatOptional YGNode::getMarginForAxis(
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) const {
   return getLeadingMargin(axis, widthSize) + getTrailingMargin(axis, widthSize);
 }
@@ -231,18 +237,22 @@ void YGNode::removeChild(uint32_t index) {
 
 void YGNode::setLayoutDirection(YGDirection direction) {
   layout_.direction = direction;
+  hasRecordedLayoutOutputs_ = false;
 }
 
 void YGNode::setLayoutMargin(float margin, int index) {
   layout_.margin[index] = margin;
+  hasRecordedLayoutOutputs_ = false;
 }
 
 void YGNode::setLayoutBorder(float border, int index) {
   layout_.border[index] = border;
+  hasRecordedLayoutOutputs_ = false;
 }
 
 void YGNode::setLayoutPadding(float padding, int index) {
   layout_.padding[index] = padding;
+  hasRecordedLayoutOutputs_ = false;
 }
 
 void YGNode::setLayoutLastOwnerDirection(YGDirection direction) {
@@ -256,6 +266,8 @@ void YGNode::setLayoutComputedFlexBasis(
 
 void YGNode::setLayoutPosition(float position, int index) {
   layout_.position[index] = position;
+  layout_.roundedPointScaleFactor = 0;
+  hasRecordedLayoutOutputs_ = false;
 }
 
 void YGNode::setLayoutComputedFlexBasisGeneration(
@@ -271,8 +283,18 @@ void YGNode::setLayoutHadOverflow(bool hadOverflow) {
   layout_.hadOverflow = hadOverflow;
 }
 
+void YGNode::setLayoutIsDeferred(bool isDeferred) {
+  layout_.isDeferred = isDeferred;
+}
+
 void YGNode::setLayoutDimension(float dimension, int index) {
   layout_.dimensions[index] = dimension;
+  layout_.roundedPointScaleFactor = 0;
+  hasRecordedLayoutOutputs_ = false;
+}
+
+void YGNode::setLayoutRoundedPointScaleFactor(float pointScaleFactor) {
+  layout_.roundedPointScaleFactor = pointScaleFactor;
 }
 
 // If both left and right are defined, then use left. Otherwise return +left or
@@ -326,20 +348,22 @@ void YGNode::setPosition(
       trailing[crossAxis]);
 }
 
-YGValue YGNode::marginLeadingValue(const YGFlexDirection axis) const {
+template <typename Axis>
+YGValue YGNode::marginLeadingValue(const Axis axis) const {
   if (YGFlexDirectionIsRow(axis) &&
       !style_.margin()[YGEdgeStart].isUndefined()) {
     return style_.margin()[YGEdgeStart];
   } else {
-    return style_.margin()[leading[axis]];
+    return style_.margin()[YGLeadingEdge(axis)];
   }
 }
 
-YGValue YGNode::marginTrailingValue(const YGFlexDirection axis) const {
+template <typename Axis>
+YGValue YGNode::marginTrailingValue(const Axis axis) const {
   if (YGFlexDirectionIsRow(axis) && !style_.margin()[YGEdgeEnd].isUndefined()) {
     return style_.margin()[YGEdgeEnd];
   } else {
-    return style_.margin()[trailing[axis]];
+    return style_.margin()[YGTrailingEdge(axis)];
   }
 }
 
@@ -449,7 +473,7 @@ float YGNode::getLeadingBorder(const YGFlexDirection axis) const {
   }
 
   leadingBorder = YGComputedEdgeValue(
-      style_.border(), leading[axis], CompactValue::ofZero());
+      style_.border(), YGLeadingEdge(axis), CompactValue::ofZero());
   return YGFloatMax(leadingBorder.value, 0.0f);
 }
 
@@ -464,7 +488,7 @@ float YGNode::getTrailingBorder(const YGFlexDirection flexDirection) const {
   }
 
   trailingBorder = YGComputedEdgeValue(
-      style_.border(), trailing[flexDirection], CompactValue::ofZero());
+      style_.border(), YGTrailingEdge(flexDirection), CompactValue::ofZero());
   return YGFloatMax(trailingBorder.value, 0.0f);
 }
 
@@ -481,7 +505,7 @@ YGFloatOptional YGNode::getLeadingPadding(
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding(), leading[axis], CompactValue::ofZero()),
+          style_.padding(), YGLeadingEdge(axis), CompactValue::ofZero()),
       widthSize);
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
 }
@@ -497,21 +521,23 @@ YGFloatOptional YGNode::getTrailingPadding(
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding(), trailing[axis], CompactValue::ofZero()),
+          style_.padding(), YGTrailingEdge(axis), CompactValue::ofZero()),
       widthSize);
 
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
 }
 
+template <typename Axis>
 YGFloatOptional YGNode::getLeadingPaddingAndBorder(
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) const {
   return getLeadingPadding(axis, widthSize) +
       YGFloatOptional(getLeadingBorder(axis));
 }
 
+template <typename Axis>
 YGFloatOptional YGNode::getTrailingPaddingAndBorder(
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) const {
   return getTrailingPadding(axis, widthSize) +
       YGFloatOptional(getTrailingBorder(axis));
@@ -571,6 +597,11 @@ bool YGNode::isLayoutTreeEqualToNode(const YGNode& node) const {
   return isLayoutTreeEqual;
 }
 
+bool YGNode::recordLayoutOutputs() {
+  hasRecordedLayoutOutputs_ = true;
+  return recordedLayoutOutputs_.record(layout_);
+}
+
 void YGNode::reset() {
   YGAssertWithNode(
       this,
@@ -589,3 +620,28 @@ void YGNode::reset() {
   }
   setConfig(config);
 }
+
+// The getters are only called with a YGFlexDirection, and with the constant
+// axes the layout kernels are instantiated for.  The other getters are only
+// called for a few children per container, and aren't worth the code.
+#define YG_NODE_AXIS_METHODS(Axis)                                  \
+  template YGFloatOptional YGNode::getLeadingMargin(                \
+      const Axis, const float) const;                               \
+  template YGFloatOptional YGNode::getTrailingMargin(               \
+      const Axis, const float) const;                               \
+  template YGFloatOptional YGNode::getMarginForAxis(                \
+      const Axis, const float) const;                               \
+  template YGValue YGNode::marginLeadingValue(const Axis) const;    \
+  template YGValue YGNode::marginTrailingValue(const Axis) const;   \
+  template YGFloatOptional YGNode::getLeadingPaddingAndBorder(      \
+      const Axis, const float) const;                               \
+  template YGFloatOptional YGNode::getTrailingPaddingAndBorder(     \
+      const Axis, const float) const;
+
+YG_NODE_AXIS_METHODS(YGFlexDirection)
+YG_NODE_AXIS_METHODS(YGConstantAxis<YGFlexDirectionColumn>)
+YG_NODE_AXIS_METHODS(YGConstantAxis<YGFlexDirectionColumnReverse>)
+YG_NODE_AXIS_METHODS(YGConstantAxis<YGFlexDirectionRow>)
+YG_NODE_AXIS_METHODS(YGConstantAxis<YGFlexDirectionRowReverse>)
+
+#undef YG_NODE_AXIS_METHODS
@@ -6,6 +6,7 @@
  */
 #pragma once
 #include <cstdint>
+#include <memory>
 #include <stdio.h>
 #include "CompactValue.h"
 #include "YGConfig.h"
@@ -28,6 +29,7 @@ private:
   bool measureUsesContext_ : 1;
   bool baselineUsesContext_ : 1;
   bool printUsesContext_ : 1;
+  bool hasRecordedLayoutOutputs_ : 1;
   uint8_t reserved_ = 0;
   union {
     YGMeasureFunc noContext;
@@ -44,12 +46,14 @@ private:
   YGDirtiedFunc dirtied_ = nullptr;
   YGStyle style_ = {};
   YGLayout layout_ = {};
+  YGRecordedLayoutOutputs recordedLayoutOutputs_ = {};
   uint32_t lineIndex_ = 0;
   YGNodeRef owner_ = nullptr;
   YGVector children_ = {};
   YGConfigRef config_;
   std::array<YGValue, 2> resolvedDimensions_ = {
       {YGValueUndefined, YGValueUndefined}};
+  std::shared_ptr<const YGViewport> viewport_ = nullptr;
 
   YGFloatOptional relativePosition(
       const YGFlexDirection axis,
@@ -77,6 +81,7 @@ public:
         measureUsesContext_{false},
         baselineUsesContext_{false},
         printUsesContext_{false},
+        hasRecordedLayoutOutputs_{false},
         config_{newConfig} {};
   ~YGNode() = default; // cleanup of owner/children relationships in YGNodeFree
 
@@ -126,6 +131,9 @@ public:
 
   uint32_t getLineIndex() const { return lineIndex_; }
 
+  // The viewport the children are laid out lazily for, or nullptr.
+  const YGViewport* getViewport() const { return viewport_.get(); }
+
   bool isReferenceBaseline() { return isReferenceBaseline_; }
 
   // returns the YGNodeRef that owns this YGNode. An owner is used to identify
@@ -169,7 +177,10 @@ public:
     return resolvedDimensions_[index];
   }
 
-  // Methods related to positions, margin, padding and border
+  // Methods related to positions, margin, padding and border.  The templated
+  // ones are the ones the layout kernels call for every child.  Their axis is
+  // a YGFlexDirection, or in the kernels the YGConstantAxis of their main axis,
+  // and YGNode.cpp defines them for just those.
   YGFloatOptional getLeadingPosition(
       const YGFlexDirection axis,
       const float axisSize) const;
@@ -178,11 +189,13 @@ public:
   YGFloatOptional getTrailingPosition(
       const YGFlexDirection axis,
       const float axisSize) const;
+  template <typename Axis>
   YGFloatOptional getLeadingMargin(
-      const YGFlexDirection axis,
+      const Axis axis,
       const float widthSize) const;
+  template <typename Axis>
   YGFloatOptional getTrailingMargin(
-      const YGFlexDirection axis,
+      const Axis axis,
       const float widthSize) const;
   float getLeadingBorder(const YGFlexDirection flexDirection) const;
   float getTrailingBorder(const YGFlexDirection flexDirection) const;
@@ -192,14 +205,17 @@ public:
   YGFloatOptional getTrailingPadding(
       const YGFlexDirection axis,
       const float widthSize) const;
+  template <typename Axis>
   YGFloatOptional getLeadingPaddingAndBorder(
-      const YGFlexDirection axis,
+      const Axis axis,
       const float widthSize) const;
+  template <typename Axis>
   YGFloatOptional getTrailingPaddingAndBorder(
-      const YGFlexDirection axis,
+      const Axis axis,
       const float widthSize) const;
+  template <typename Axis>
   YGFloatOptional getMarginForAxis(
-      const YGFlexDirection axis,
+      const Axis axis,
       const float widthSize) const;
   // Setters
 
@@ -217,6 +233,15 @@ public:
 
   void setHasNewLayout(bool hasNewLayout) { hasNewLayout_ = hasNewLayout; }
 
+  // Records the layout outputs, returning whether they differ from those
+  // recorded last time.
+  bool recordLayoutOutputs();
+
+  // Whether the layout outputs are those recorded last time.  Only the
+  // outputs of nodes laid out since can differ, and as a node is only laid out
+  // as part of laying out its owner, neither can those of its subtree.
+  bool hasRecordedLayoutOutputs() const { return hasRecordedLayoutOutputs_; }
+
   void setNodeType(YGNodeType nodeType) { nodeType_ = nodeType; }
 
   void setMeasureFunc(YGMeasureFunc measureFunc);
@@ -241,10 +266,17 @@ public:
 
   void setStyle(const YGStyle& style) { style_ = style; }
 
-  void setLayout(const YGLayout& layout) { layout_ = layout; }
+  void setLayout(const YGLayout& layout) {
+    layout_ = layout;
+    hasRecordedLayoutOutputs_ = false;
+  }
 
   void setLineIndex(uint32_t lineIndex) { lineIndex_ = lineIndex; }
 
+  void setViewport(std::shared_ptr<const YGViewport> viewport) {
+    viewport_ = std::move(viewport);
+  }
+
   void setIsReferenceBaseline(bool isReferenceBaseline) {
     isReferenceBaseline_ = isReferenceBaseline;
   }
@@ -264,12 +296,14 @@ public:
       uint32_t computedFlexBasisGeneration);
   void setLayoutMeasuredDimension(float measuredDimension, int index);
   void setLayoutHadOverflow(bool hadOverflow);
+  void setLayoutIsDeferred(bool isDeferred);
   void setLayoutDimension(float dimension, int index);
   void setLayoutDirection(YGDirection direction);
   void setLayoutMargin(float margin, int index);
   void setLayoutBorder(float border, int index);
   void setLayoutPadding(float padding, int index);
   void setLayoutPosition(float position, int index);
+  void setLayoutRoundedPointScaleFactor(float pointScaleFactor);
   void setPosition(
       const YGDirection direction,
       const float mainSize,
@@ -281,8 +315,10 @@ public:
   void markDirtyAndPropogateDownwards();
 
   // Other methods
-  YGValue marginLeadingValue(const YGFlexDirection axis) const;
-  YGValue marginTrailingValue(const YGFlexDirection axis) const;
+  template <typename Axis>
+  YGValue marginLeadingValue(const Axis axis) const;
+  template <typename Axis>
+  YGValue marginTrailingValue(const Axis axis) const;
   YGValue resolveFlexBasisPtr() const;
   void resolveDimension();
   YGDirection resolveDirection(const YGDirection ownerDirection);
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <type_traits>
 #include <vector>
 #include "CompactValue.h"
 #include "Yoga.h"
@@ -43,6 +44,30 @@ extern const YGValue YGValueUndefined;
 extern const YGValue YGValueAuto;
 extern const YGValue YGValueZero;
 
+// A flex direction known at compile time.  The layout kernels are instantiated
+// for each main axis with one of these in place of a YGFlexDirection, which
+// makes the edges and dimensions of that axis constants in them and in the
+// axis getters of YGNode.  It converts to the YGFlexDirection it stands for.
+template <YGFlexDirection Axis>
+using YGConstantAxis = std::integral_constant<YGFlexDirection, Axis>;
+
+// leading[axis] and trailing[axis], for axes that are constants.
+inline constexpr YGEdge YGLeadingEdge(const YGFlexDirection axis) {
+  return axis == YGFlexDirectionColumn
+      ? YGEdgeTop
+      : axis == YGFlexDirectionColumnReverse
+          ? YGEdgeBottom
+          : axis == YGFlexDirectionRow ? YGEdgeLeft : YGEdgeRight;
+}
+
+inline constexpr YGEdge YGTrailingEdge(const YGFlexDirection axis) {
+  return axis == YGFlexDirectionColumn
+      ? YGEdgeBottom
+      : axis == YGFlexDirectionColumnReverse
+          ? YGEdgeTop
+          : axis == YGFlexDirectionRow ? YGEdgeRight : YGEdgeLeft;
+}
+
 struct YGCachedMeasurement {
   float availableWidth;
   float availableHeight;
@@ -89,6 +114,10 @@ struct YGCachedMeasurement {
 // 98% of analyzed layouts require less than 8 entries.
 #define YG_MAX_CACHED_RESULT_COUNT 8
 
+// Of which 90% fit in the first four, which are kept in the node.  The others
+// are allocated when first needed.
+#define YG_INLINE_CACHED_RESULT_COUNT 4
+
 namespace facebook {
 namespace yoga {
 namespace detail {
@@ -143,8 +172,34 @@ static const float kDefaultFlexShrink = 0.0f;
 static const float kWebDefaultFlexShrink = 1.0f;
 
 extern bool YGFloatsEqual(const float a, const float b);
-extern facebook::yoga::detail::CompactValue YGComputedEdgeValue(
+// Inline, so that the edge folds away where it's a constant.
+inline facebook::yoga::detail::CompactValue YGComputedEdgeValue(
     const facebook::yoga::detail::Values<
         facebook::yoga::enums::count<YGEdge>()>& edges,
     YGEdge edge,
-    facebook::yoga::detail::CompactValue defaultValue);
+    facebook::yoga::detail::CompactValue defaultValue) {
+  if (!edges[edge].isUndefined()) {
+    return edges[edge];
+  }
+
+  if ((edge == YGEdgeTop || edge == YGEdgeBottom) &&
+      !edges[YGEdgeVertical].isUndefined()) {
+    return edges[YGEdgeVertical];
+  }
+
+  if ((edge == YGEdgeLeft || edge == YGEdgeRight || edge == YGEdgeStart ||
+       edge == YGEdgeEnd) &&
+      !edges[YGEdgeHorizontal].isUndefined()) {
+    return edges[YGEdgeHorizontal];
+  }
+
+  if (!edges[YGEdgeAll].isUndefined()) {
+    return edges[YGEdgeAll];
+  }
+
+  if (edge == YGEdgeStart || edge == YGEdgeEnd) {
+    return facebook::yoga::detail::CompactValue::ofUndefined();
+  }
+
+  return defaultValue;
+}
@@ -109,36 +109,6 @@ bool YGFloatIsUndefined(const float value) {
   return facebook::yoga::isUndefined(value);
 }
 
-detail::CompactValue YGComputedEdgeValue(
-    const YGStyle::Edges& edges,
-    YGEdge edge,
-    detail::CompactValue defaultValue) {
-  if (!edges[edge].isUndefined()) {
-    return edges[edge];
-  }
-
-  if ((edge == YGEdgeTop || edge == YGEdgeBottom) &&
-      !edges[YGEdgeVertical].isUndefined()) {
-    return edges[YGEdgeVertical];
-  }
-
-  if ((edge == YGEdgeLeft || edge == YGEdgeRight || edge == YGEdgeStart ||
-       edge == YGEdgeEnd) &&
-      !edges[YGEdgeHorizontal].isUndefined()) {
-    return edges[YGEdgeHorizontal];
-  }
-
-  if (!edges[YGEdgeAll].isUndefined()) {
-    return edges[YGEdgeAll];
-  }
-
-  if (edge == YGEdgeStart || edge == YGEdgeEnd) {
-    return detail::CompactValue::ofUndefined();
-  }
-
-  return defaultValue;
-}
-
 void* YGNodeGetContext(YGNodeRef node) {
   return node->getContext();
 }
@@ -213,15 +183,16 @@ WIN_EXPORT YGNodeRef YGNodeNewWithConfig(const YGConfigRef config) {
   const YGNodeRef node = new YGNode();
   YGAssertWithConfig(
       config, node != nullptr, "Could not allocate memory for node");
-#ifdef YG_ENABLE_EVENTS
-  Event::publish<Event::NodeAllocation>(node, {config});
-#endif
 
   if (config->useWebDefaults) {
     node->getStyle().flexDirection() = YGFlexDirectionRow;
     node->getStyle().alignContent() = YGAlignStretch;
   }
   node->setConfig(config);
+#ifdef YG_ENABLE_EVENTS
+  // After setConfig, so that the config's subscribers receive it.
+  Event::publish<Event::NodeAllocation>(node, {config});
+#endif
   return node;
 }
 
@@ -349,12 +320,15 @@ YGConfigRef YGConfigNew(void) {
 }
 
 void YGConfigFree(const YGConfigRef config) {
+  delete config->eventSubscribers;
   delete config;
   gConfigInstanceCount--;
 }
 
 void YGConfigCopy(const YGConfigRef dest, const YGConfigRef src) {
+  const auto eventSubscribers = dest->eventSubscribers;
   memcpy(dest, src, sizeof(YGConfig));
+  dest->eventSubscribers = eventSubscribers;
 }
 
 void YGNodeSetIsReferenceBaseline(YGNodeRef node, bool isReferenceBaseline) {
@@ -509,6 +483,26 @@ void YGNodeMarkDirty(const YGNodeRef node) {
   node->markDirtyAndPropogate();
 }
 
+void YGNodeSetViewport(const YGNodeRef node, const YGViewport viewport) {
+  const YGViewport* current = node->getViewport();
+  if (current != nullptr && YGFloatsEqual(current->offset, viewport.offset) &&
+      YGFloatsEqual(current->length, viewport.length) &&
+      YGFloatsEqual(current->overscan, viewport.overscan) &&
+      YGFloatsEqual(
+          current->estimatedChildSize, viewport.estimatedChildSize)) {
+    return;
+  }
+  node->setViewport(std::make_shared<const YGViewport>(viewport));
+  node->markDirtyAndPropogate();
+}
+
+void YGNodeClearViewport(const YGNodeRef node) {
+  if (node->getViewport() != nullptr) {
+    node->setViewport(nullptr);
+    node->markDirtyAndPropogate();
+  }
+}
+
 void YGNodeCopyStyle(const YGNodeRef dstNode, const YGNodeRef srcNode) {
   if (!(dstNode->getStyle() == srcNode->getStyle())) {
     dstNode->setStyle(srcNode->getStyle());
@@ -532,40 +526,59 @@ float YGNodeStyleGetFlexShrink(const YGNodeConstRef node) {
 namespace {
 
 template <typename T, typename NeedsUpdate, typename Update>
-void updateStyle(
-    YGNode* node,
+bool updateStyle(
+    YGStyle& style,
     T value,
     NeedsUpdate&& needsUpdate,
     Update&& update) {
-  if (needsUpdate(node->getStyle(), value)) {
-    update(node->getStyle(), value);
-    node->markDirtyAndPropogate();
+  if (needsUpdate(style, value)) {
+    update(style, value);
+    return true;
   }
+  return false;
 }
 
 template <typename Ref, typename T>
-void updateStyle(YGNode* node, Ref (YGStyle::*prop)(), T value) {
-  updateStyle(
-      node,
+bool updateStyle(YGStyle& style, Ref (YGStyle::*prop)(), T value) {
+  return updateStyle(
+      style,
       value,
       [prop](YGStyle& s, T x) { return (s.*prop)() != x; },
       [prop](YGStyle& s, T x) { (s.*prop)() = x; });
 }
 
 template <typename Ref, typename Idx>
-void updateIndexedStyleProp(
-    YGNode* node,
+bool updateIndexedStyleProp(
+    YGStyle& style,
     Ref (YGStyle::*prop)(),
     Idx idx,
     detail::CompactValue value) {
   using detail::CompactValue;
-  updateStyle(
-      node,
+  return updateStyle(
+      style,
       value,
       [idx, prop](YGStyle& s, CompactValue x) { return (s.*prop)()[idx] != x; },
       [idx, prop](YGStyle& s, CompactValue x) { (s.*prop)()[idx] = x; });
 }
 
+template <typename Ref, typename T>
+void updateStyle(YGNode* node, Ref (YGStyle::*prop)(), T value) {
+  if (updateStyle(node->getStyle(), prop, value)) {
+    node->markDirtyAndPropogate();
+  }
+}
+
+template <typename Ref, typename Idx>
+void updateIndexedStyleProp(
+    YGNode* node,
+    Ref (YGStyle::*prop)(),
+    Idx idx,
+    detail::CompactValue value) {
+  if (updateIndexedStyleProp(node->getStyle(), prop, idx, value)) {
+    node->markDirtyAndPropogate();
+  }
+}
+
 } // namespace
 
 // MSVC has trouble inferring the return type of pointer to member functions
@@ -890,6 +903,182 @@ YGValue YGNodeStyleGetMaxHeight(const YGNodeConstRef node) {
   return node->getStyle().maxDimensions()[YGDimensionHeight];
 };
 
+static_assert(
+    YGStylePropMargin == YGStyle::marginBit &&
+        YGStylePropPosition == YGStyle::positionBit &&
+        YGStylePropPadding == YGStyle::paddingBit &&
+        YGStylePropBorder == YGStyle::borderBit &&
+        YGStylePropDimensions == YGStyle::dimensionsBit &&
+        YGStylePropMaxDimensions == YGStyle::maxDimensionsBit &&
+        YGStylePropMinDimensions == YGStyle::minDimensionsBit &&
+        YGStylePropCount == YGStyle::numStyles,
+    "YGStyleProp must be numbered as the props of YGStyle");
+
+namespace {
+
+detail::CompactValue compactValueOf(const YGValue value) {
+  switch (value.unit) {
+    case YGUnitPoint:
+      return detail::CompactValue::ofMaybe<YGUnitPoint>(value.value);
+    case YGUnitPercent:
+      return detail::CompactValue::ofMaybe<YGUnitPercent>(value.value);
+    case YGUnitAuto:
+      return detail::CompactValue::ofAuto();
+    case YGUnitUndefined:
+      break;
+  }
+  return detail::CompactValue::ofUndefined();
+}
+
+// Whether the property has a setter for values of the unit, among the
+// properties that have a unit.
+bool hasSetterForUnit(const uint32_t prop, const YGUnit unit) {
+  switch (unit) {
+    case YGUnitAuto:
+      return prop == YGStylePropFlexBasis ||
+          (prop >= YGStylePropMargin && prop < YGStylePropPosition) ||
+          (prop >= YGStylePropDimensions && prop < YGStylePropMaxDimensions);
+    case YGUnitPercent:
+      return prop < YGStylePropBorder || prop >= YGStylePropDimensions;
+    case YGUnitPoint:
+    case YGUnitUndefined:
+      break;
+  }
+  return true;
+}
+
+template <typename Enum>
+Enum enumOf(const YGValue value) {
+  return static_cast<Enum>(static_cast<int>(value.value));
+}
+
+// Sets one property of the style, as its setter would, without marking the
+// node dirty. Returns whether it changed.
+bool updateStyleProp(
+    const YGNodeRef node,
+    const uint32_t prop,
+    const YGValue value) {
+  YGStyle& style = node->getStyle();
+  if ((prop == YGStylePropFlexBasis ||
+       (prop >= YGStylePropMargin && prop < YGStylePropAspectRatio)) &&
+      !hasSetterForUnit(prop, value.unit)) {
+    YGAssertWithNode(
+        node, false, "Cannot update a style property to an unsupported unit");
+    return false;
+  }
+  if (prop >= YGStylePropMargin && prop < YGStylePropAspectRatio) {
+    if (prop < YGStylePropPosition) {
+      return updateIndexedStyleProp<MSVC_HINT(margin)>(
+          style,
+          &YGStyle::margin,
+          static_cast<YGEdge>(prop - YGStylePropMargin),
+          compactValueOf(value));
+    } else if (prop < YGStylePropPadding) {
+      return updateIndexedStyleProp<MSVC_HINT(position)>(
+          style,
+          &YGStyle::position,
+          static_cast<YGEdge>(prop - YGStylePropPosition),
+          compactValueOf(value));
+    } else if (prop < YGStylePropBorder) {
+      return updateIndexedStyleProp<MSVC_HINT(padding)>(
+          style,
+          &YGStyle::padding,
+          static_cast<YGEdge>(prop - YGStylePropPadding),
+          compactValueOf(value));
+    } else if (prop < YGStylePropDimensions) {
+      return updateIndexedStyleProp<MSVC_HINT(border)>(
+          style,
+          &YGStyle::border,
+          static_cast<YGEdge>(prop - YGStylePropBorder),
+          detail::CompactValue::ofMaybe<YGUnitPoint>(value.value));
+    } else if (prop < YGStylePropMaxDimensions) {
+      return updateIndexedStyleProp<MSVC_HINT(dimensions)>(
+          style,
+          &YGStyle::dimensions,
+          static_cast<YGDimension>(prop - YGStylePropDimensions),
+          compactValueOf(value));
+    } else if (prop < YGStylePropMinDimensions) {
+      return updateIndexedStyleProp<MSVC_HINT(maxDimensions)>(
+          style,
+          &YGStyle::maxDimensions,
+          static_cast<YGDimension>(prop - YGStylePropMaxDimensions),
+          compactValueOf(value));
+    } else {
+      return updateIndexedStyleProp<MSVC_HINT(minDimensions)>(
+          style,
+          &YGStyle::minDimensions,
+          static_cast<YGDimension>(prop - YGStylePropMinDimensions),
+          compactValueOf(value));
+    }
+  }
+
+  switch (prop) {
+    case YGStylePropDirection:
+      return updateStyle<MSVC_HINT(direction)>(
+          style, &YGStyle::direction, enumOf<YGDirection>(value));
+    case YGStylePropFlexDirection:
+      return updateStyle<MSVC_HINT(flexDirection)>(
+          style, &YGStyle::flexDirection, enumOf<YGFlexDirection>(value));
+    case YGStylePropJustifyContent:
+      return updateStyle<MSVC_HINT(justifyContent)>(
+          style, &YGStyle::justifyContent, enumOf<YGJustify>(value));
+    case YGStylePropAlignContent:
+      return updateStyle<MSVC_HINT(alignContent)>(
+          style, &YGStyle::alignContent, enumOf<YGAlign>(value));
+    case YGStylePropAlignItems:
+      return updateStyle<MSVC_HINT(alignItems)>(
+          style, &YGStyle::alignItems, enumOf<YGAlign>(value));
+    case YGStylePropAlignSelf:
+      return updateStyle<MSVC_HINT(alignSelf)>(
+          style, &YGStyle::alignSelf, enumOf<YGAlign>(value));
+    case YGStylePropPositionType:
+      return updateStyle<MSVC_HINT(positionType)>(
+          style, &YGStyle::positionType, enumOf<YGPositionType>(value));
+    case YGStylePropFlexWrap:
+      return updateStyle<MSVC_HINT(flexWrap)>(
+          style, &YGStyle::flexWrap, enumOf<YGWrap>(value));
+    case YGStylePropOverflow:
+      return updateStyle<MSVC_HINT(overflow)>(
+          style, &YGStyle::overflow, enumOf<YGOverflow>(value));
+    case YGStylePropDisplay:
+      return updateStyle<MSVC_HINT(display)>(
+          style, &YGStyle::display, enumOf<YGDisplay>(value));
+    case YGStylePropFlex:
+      return updateStyle<MSVC_HINT(flex)>(
+          style, &YGStyle::flex, YGFloatOptional{value.value});
+    case YGStylePropFlexGrow:
+      return updateStyle<MSVC_HINT(flexGrow)>(
+          style, &YGStyle::flexGrow, YGFloatOptional{value.value});
+    case YGStylePropFlexShrink:
+      return updateStyle<MSVC_HINT(flexShrink)>(
+          style, &YGStyle::flexShrink, YGFloatOptional{value.value});
+    case YGStylePropFlexBasis:
+      return updateStyle<MSVC_HINT(flexBasis)>(
+          style, &YGStyle::flexBasis, compactValueOf(value));
+    case YGStylePropAspectRatio:
+      return updateStyle<MSVC_HINT(aspectRatio)>(
+          style, &YGStyle::aspectRatio, YGFloatOptional{value.value});
+  }
+
+  YGAssertWithNode(node, false, "Cannot update an unknown style property");
+  return false;
+}
+
+} // namespace
+
+void YGNodeStyleApplyUpdates(
+    const YGNodeRef node,
+    const YGStyleUpdate* updates,
+    const uint32_t count) {
+  bool changed = false;
+  for (uint32_t i = 0; i < count; i++) {
+    changed |= updateStyleProp(node, updates[i].prop, updates[i].value);
+  }
+  if (changed) {
+    node->markDirtyAndPropogate();
+  }
+}
+
 #define YG_NODE_LAYOUT_PROPERTY_IMPL(type, name, instanceName) \
   type YGNodeLayoutGet##name(const YGNodeRef node) {           \
     return node->getLayout().instanceName;                     \
@@ -929,6 +1118,7 @@ YG_NODE_LAYOUT_PROPERTY_IMPL(float, Width, dimensions[YGDimensionWidth]);
 YG_NODE_LAYOUT_PROPERTY_IMPL(float, Height, dimensions[YGDimensionHeight]);
 YG_NODE_LAYOUT_PROPERTY_IMPL(YGDirection, Direction, direction);
 YG_NODE_LAYOUT_PROPERTY_IMPL(bool, HadOverflow, hadOverflow);
+YG_NODE_LAYOUT_PROPERTY_IMPL(bool, IsDeferred, isDeferred);
 
 YG_NODE_LAYOUT_RESOLVED_PROPERTY_IMPL(float, Margin, margin);
 YG_NODE_LAYOUT_RESOLVED_PROPERTY_IMPL(float, Border, border);
@@ -949,6 +1139,31 @@ void YGNodeLayoutSetPointScaleFactor(const YGNodeRef node, float pixelsInPoint)
 
 uint32_t gCurrentGenerationCount = 0;
 
+// The sizes that the batch measure function of a config measured leaves at,
+// ahead of a layout pass, for the constraints they were last measured with.
+class YGPremeasuredSizes {
+public:
+  void measure(YGNodeRef root, YGBatchMeasureFunc batchMeasureFunc);
+
+  bool find(
+      YGNodeRef node,
+      float width,
+      YGMeasureMode widthMode,
+      float height,
+      YGMeasureMode heightMode,
+      YGSize& size) const;
+
+private:
+  static void collect(YGNodeRef node, std::vector<YGMeasureRequest>& requests);
+  static void addRequest(
+      YGNodeRef node,
+      const YGCachedMeasurement& measurement,
+      std::vector<YGMeasureRequest>& requests);
+
+  // Sorted by node.
+  std::vector<YGMeasureRequest> requests_;
+};
+
 bool YGLayoutNodeInternal(
     const YGNodeRef node,
     const float availableWidth,
@@ -962,6 +1177,7 @@ bool YGLayoutNodeInternal(
     const char* reason,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext);
 
 #ifdef DEBUG
@@ -993,9 +1209,10 @@ static const std::array<YGEdge, 4> pos = {{
 static const std::array<YGDimension, 4> dim = {
     {YGDimensionHeight, YGDimensionHeight, YGDimensionWidth, YGDimensionWidth}};
 
+template <typename Axis>
 static inline float YGNodePaddingAndBorderForAxis(
     const YGNodeConstRef node,
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) {
   return (node->getLeadingPaddingAndBorder(axis, widthSize) +
           node->getTrailingPaddingAndBorder(axis, widthSize))
@@ -1076,9 +1293,10 @@ static bool YGIsBaselineLayout(const YGNodeRef node) {
   return false;
 }
 
+template <typename Axis>
 static inline float YGNodeDimWithMargin(
     const YGNodeRef node,
-    const YGFlexDirection axis,
+    const Axis axis,
     const float widthSize) {
   return node->getLayout().measuredDimensions[dim[axis]] +
       (node->getLeadingMargin(axis, widthSize) +
@@ -1086,9 +1304,10 @@ static inline float YGNodeDimWithMargin(
           .unwrap();
 }
 
+template <typename Axis>
 static inline bool YGNodeIsStyleDimDefined(
     const YGNodeRef node,
-    const YGFlexDirection axis,
+    const Axis axis,
     const float ownerSize) {
   bool isUndefined =
       YGFloatIsUndefined(node->getResolvedDimension(dim[axis]).value);
@@ -1103,16 +1322,18 @@ static inline bool YGNodeIsStyleDimDefined(
         YGFloatIsUndefined(ownerSize))));
 }
 
+template <typename Axis>
 static inline bool YGNodeIsLayoutDimDefined(
     const YGNodeRef node,
-    const YGFlexDirection axis) {
+    const Axis axis) {
   const float value = node->getLayout().measuredDimensions[dim[axis]];
   return !YGFloatIsUndefined(value) && value >= 0.0f;
 }
 
+template <typename Axis>
 static YGFloatOptional YGNodeBoundAxisWithinMinAndMax(
     const YGNodeConstRef node,
-    const YGFlexDirection axis,
+    const Axis axis,
     const YGFloatOptional value,
     const float axisSize) {
   YGFloatOptional min;
@@ -1143,9 +1364,10 @@ static YGFloatOptional YGNodeBoundAxisWithinMinAndMax(
 
 // Like YGNodeBoundAxisWithinMinAndMax but also ensures that the value doesn't
 // go below the padding and border amount.
+template <typename Axis>
 static inline float YGNodeBoundAxis(
     const YGNodeRef node,
-    const YGFlexDirection axis,
+    const Axis axis,
     const float value,
     const float axisSize,
     const float widthSize) {
@@ -1156,10 +1378,47 @@ static inline float YGNodeBoundAxis(
       YGNodePaddingAndBorderForAxis(node, axis, widthSize));
 }
 
+// Sizes a node whose layout is deferred, without laying it out or cleaning it.
+// Dimensions that it isn't sized exactly along keep the size they were last
+// laid out at.
+static void YGNodeSetDeferredLayout(
+    const YGNodeRef node,
+    const float width,
+    const float height,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout) {
+  const YGFlexDirection axes[] = {YGFlexDirectionRow, YGFlexDirectionColumn};
+  const float sizes[] = {width, height};
+  const YGMeasureMode measureModes[] = {widthMeasureMode, heightMeasureMode};
+  const float ownerSizes[] = {ownerWidth, ownerHeight};
+  for (int i = 0; i < 2; i++) {
+    const YGFlexDirection axis = axes[i];
+    const float lastSize = node->getLayout().dimensions[dim[axis]];
+    float size = YGFloatIsUndefined(lastSize) ? 0 : lastSize;
+    if (measureModes[i] == YGMeasureModeExactly) {
+      size = sizes[i] - node->getMarginForAxis(axis, ownerWidth).unwrap();
+    }
+    node->setLayoutMeasuredDimension(
+        YGNodeBoundAxis(node, axis, size, ownerSizes[i], ownerWidth),
+        dim[axis]);
+    if (performLayout) {
+      node->setLayoutDimension(
+          node->getLayout().measuredDimensions[dim[axis]], dim[axis]);
+    }
+  }
+  if (performLayout) {
+    node->setHasNewLayout(true);
+  }
+}
+
+template <typename Axis>
 static void YGNodeSetChildTrailingPosition(
     const YGNodeRef node,
     const YGNodeRef child,
-    const YGFlexDirection axis) {
+    const Axis axis) {
   const float size = child->getLayout().measuredDimensions[dim[axis]];
   child->setLayoutPosition(
       node->getLayout().measuredDimensions[dim[axis]] - size -
@@ -1167,9 +1426,10 @@ static void YGNodeSetChildTrailingPosition(
       trailing[axis]);
 }
 
+template <typename Axis>
 static void YGConstrainMaxSizeForMode(
     const YGNodeConstRef node,
-    const enum YGFlexDirection axis,
+    const Axis axis,
     const float ownerAxisSize,
     const float ownerWidth,
     YGMeasureMode* mode,
@@ -1194,9 +1454,12 @@ static void YGConstrainMaxSizeForMode(
   }
 }
 
+template <typename MainAxis>
 static void YGNodeComputeFlexBasisForChild(
     const YGNodeRef node,
     const YGNodeRef child,
+    const MainAxis mainAxis,
+    const float deferredMainSize,
     const float width,
     const YGMeasureMode widthMode,
     const float height,
@@ -1206,9 +1469,8 @@ static void YGNodeComputeFlexBasisForChild(
     const YGDirection direction,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
-  const YGFlexDirection mainAxis =
-      YGResolveFlexDirection(node->getStyle().flexDirection(), direction);
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
   const float mainAxisSize = isMainAxisRow ? width : height;
   const float mainAxisownerSize = isMainAxisRow ? ownerWidth : ownerHeight;
@@ -1254,6 +1516,13 @@ static void YGNodeComputeFlexBasisForChild(
         YGResolveValue(
             child->getResolvedDimensions()[YGDimensionHeight], ownerHeight),
         paddingAndBorder));
+  } else if (!YGFloatIsUndefined(deferredMainSize)) {
+    // The child is deferred, so use the size it is predicted to have rather
+    // than measuring it.
+    const YGFloatOptional paddingAndBorder = YGFloatOptional(
+        YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth));
+    child->setLayoutComputedFlexBasis(YGFloatOptionalMax(
+        YGFloatOptional(deferredMainSize), paddingAndBorder));
   } else {
     // Compute the flex basis and hypothetical main size (i.e. the clamped flex
     // basis).
@@ -1381,6 +1650,7 @@ static void YGNodeComputeFlexBasisForChild(
         "measure",
         config,
         layoutMarkerData,
+        premeasuredSizes,
         layoutContext);
 
     child->setLayoutComputedFlexBasis(YGFloatOptional(YGFloatMax(
@@ -1399,6 +1669,7 @@ static void YGNodeAbsoluteLayoutChild(
     const YGDirection direction,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
   const YGFlexDirection mainAxis =
       YGResolveFlexDirection(node->getStyle().flexDirection(), direction);
@@ -1505,6 +1776,7 @@ static void YGNodeAbsoluteLayoutChild(
         "abs-measure",
         config,
         layoutMarkerData,
+        premeasuredSizes,
         layoutContext);
     childWidth = child->getLayout().measuredDimensions[YGDimensionWidth] +
         child->getMarginForAxis(YGFlexDirectionRow, width).unwrap();
@@ -1525,6 +1797,7 @@ static void YGNodeAbsoluteLayoutChild(
       "abs-layout",
       config,
       layoutMarkerData,
+      premeasuredSizes,
       layoutContext);
 
   if (child->isTrailingPosDefined(mainAxis) &&
@@ -1585,6 +1858,133 @@ static void YGNodeAbsoluteLayoutChild(
   }
 }
 
+// The size a measure function is given along an axis, for an available size
+// that includes margin, padding and border.
+static float YGMeasureFuncInnerSize(
+    const YGNodeRef node,
+    const YGFlexDirection axis,
+    const float availableSize,
+    const float availableWidth) {
+  // We want to make sure we don't call measure with negative size
+  return YGFloatIsUndefined(availableSize)
+      ? availableSize
+      : YGFloatMax(
+            0,
+            availableSize -
+                node->getMarginForAxis(axis, availableWidth).unwrap() -
+                YGNodePaddingAndBorderForAxis(node, axis, availableWidth));
+}
+
+static bool YGSameConstraint(const float a, const float b) {
+  return a == b || (yoga::isUndefined(a) && yoga::isUndefined(b));
+}
+
+void YGPremeasuredSizes::measure(
+    const YGNodeRef root,
+    const YGBatchMeasureFunc batchMeasureFunc) {
+  collect(root, requests_);
+  if (requests_.empty()) {
+    return;
+  }
+  batchMeasureFunc(requests_.data(), static_cast<uint32_t>(requests_.size()));
+  std::sort(
+      requests_.begin(),
+      requests_.end(),
+      [](const YGMeasureRequest& a, const YGMeasureRequest& b) {
+        return std::less<YGNodeRef>()(a.node, b.node);
+      });
+}
+
+bool YGPremeasuredSizes::find(
+    const YGNodeRef node,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const YGMeasureMode heightMode,
+    YGSize& size) const {
+  auto request = std::lower_bound(
+      requests_.begin(),
+      requests_.end(),
+      node,
+      [](const YGMeasureRequest& request, const YGNodeRef node) {
+        return std::less<YGNodeRef>()(request.node, node);
+      });
+  for (; request != requests_.end() && request->node == node; request++) {
+    if (request->widthMode == widthMode && request->heightMode == heightMode &&
+        YGSameConstraint(request->width, width) &&
+        YGSameConstraint(request->height, height)) {
+      // Left undefined by the batch measure function.
+      if (YGFloatIsUndefined(request->size.width) ||
+          YGFloatIsUndefined(request->size.height)) {
+        return false;
+      }
+      size = request->size;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Clean nodes keep their cached measurements, so only dirty leaves are
+// measured, with the constraints they were measured with by the last pass.
+// Nodes that were never laid out can't be predicted, and are measured during
+// the pass.
+void YGPremeasuredSizes::collect(
+    const YGNodeRef node,
+    std::vector<YGMeasureRequest>& requests) {
+  // Deferred nodes stay dirty, and are likely to be deferred again.
+  if (!node->isDirty() || node->getLayout().isDeferred) {
+    return;
+  }
+  if (!node->hasMeasureFunc()) {
+    for (auto child : node->getChildren()) {
+      collect(child, requests);
+    }
+    return;
+  }
+  YGLayout& layout = node->getLayout();
+  addRequest(node, layout.cachedLayout, requests);
+  for (uint32_t i = 0; i < layout.nextCachedMeasurementsIndex; i++) {
+    addRequest(node, layout.cachedMeasurements[i], requests);
+  }
+}
+
+void YGPremeasuredSizes::addRequest(
+    const YGNodeRef node,
+    const YGCachedMeasurement& measurement,
+    std::vector<YGMeasureRequest>& requests) {
+  const YGMeasureMode widthMode = measurement.widthMeasureMode;
+  const YGMeasureMode heightMode = measurement.heightMeasureMode;
+  // Unused, or not measured as both dimensions are exact.
+  if (widthMode == (YGMeasureMode) -1 ||
+      (widthMode == YGMeasureModeExactly &&
+       heightMode == YGMeasureModeExactly)) {
+    return;
+  }
+  const float width = YGMeasureFuncInnerSize(
+      node,
+      YGFlexDirectionRow,
+      measurement.availableWidth,
+      measurement.availableWidth);
+  const float height = YGMeasureFuncInnerSize(
+      node,
+      YGFlexDirectionColumn,
+      measurement.availableHeight,
+      measurement.availableWidth);
+  // The requests of the node are last, and few.
+  for (auto request = requests.rbegin();
+       request != requests.rend() && request->node == node;
+       request++) {
+    if (request->widthMode == widthMode && request->heightMode == heightMode &&
+        YGSameConstraint(request->width, width) &&
+        YGSameConstraint(request->height, height)) {
+      return;
+    }
+  }
+  requests.push_back(
+      {node, width, widthMode, height, heightMode, {YGUndefined, YGUndefined}});
+}
+
 static void YGNodeWithMeasureFuncSetMeasuredDimensions(
     const YGNodeRef node,
     const float availableWidth,
@@ -1593,6 +1993,7 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
     const YGMeasureMode heightMeasureMode,
     const float ownerWidth,
     const float ownerHeight,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
   YGAssertWithNode(
       node,
@@ -1608,14 +2009,10 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
   const float marginAxisColumn =
       node->getMarginForAxis(YGFlexDirectionColumn, availableWidth).unwrap();
 
-  // We want to make sure we don't call measure with negative size
-  const float innerWidth = YGFloatIsUndefined(availableWidth)
-      ? availableWidth
-      : YGFloatMax(0, availableWidth - marginAxisRow - paddingAndBorderAxisRow);
-  const float innerHeight = YGFloatIsUndefined(availableHeight)
-      ? availableHeight
-      : YGFloatMax(
-            0, availableHeight - marginAxisColumn - paddingAndBorderAxisColumn);
+  const float innerWidth = YGMeasureFuncInnerSize(
+      node, YGFlexDirectionRow, availableWidth, availableWidth);
+  const float innerHeight = YGMeasureFuncInnerSize(
+      node, YGFlexDirectionColumn, availableHeight, availableWidth);
 
   if (widthMeasureMode == YGMeasureModeExactly &&
       heightMeasureMode == YGMeasureModeExactly) {
@@ -1637,15 +2034,26 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
             ownerWidth),
         YGDimensionHeight);
   } else {
-    // Measure the text under the current constraints.
-    const YGSize measuredSize = marker::MarkerSection<YGMarkerMeasure>::wrap(
-        node,
-        &YGNode::measure,
-        innerWidth,
-        widthMeasureMode,
-        innerHeight,
-        heightMeasureMode,
-        layoutContext);
+    // Measure the text under the current constraints, unless it was measured
+    // under them ahead of the pass.
+    YGSize measuredSize;
+    if (premeasuredSizes == nullptr ||
+        !premeasuredSizes->find(
+            node,
+            innerWidth,
+            widthMeasureMode,
+            innerHeight,
+            heightMeasureMode,
+            measuredSize)) {
+      measuredSize = marker::MarkerSection<YGMarkerMeasure>::wrap(
+          node,
+          &YGNode::measure,
+          innerWidth,
+          widthMeasureMode,
+          innerHeight,
+          heightMeasureMode,
+          layoutContext);
+    }
 
     node->setLayoutMeasuredDimension(
         YGNodeBoundAxis(
@@ -1818,6 +2226,17 @@ static float YGNodeCalculateAvailableInnerDim(
   return availableInnerDim;
 }
 
+// The viewport of a container that lays out lazily, along the main axis from
+// the leading edge of its content box.
+struct YGLazyWindow {
+  float start;
+  float end;
+  float estimatedChildSize;
+};
+
+// Children that are predicted to be outside of the lazy window, if any, are
+// deferred: they get the size they were last laid out at as their flex basis.
+template <typename MainAxis>
 static float YGNodeComputeFlexBasisForChildren(
     const YGNodeRef node,
     const float availableInnerWidth,
@@ -1825,14 +2244,16 @@ static float YGNodeComputeFlexBasisForChildren(
     YGMeasureMode widthMeasureMode,
     YGMeasureMode heightMeasureMode,
     YGDirection direction,
-    YGFlexDirection mainAxis,
+    const MainAxis mainAxis,
     const YGConfigRef config,
     bool performLayout,
+    const YGLazyWindow* lazyWindow,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
   float totalOuterFlexBasis = 0.0f;
   YGNodeRef singleFlexChild = nullptr;
-  YGVector children = node->getChildren();
+  const YGVector& children = node->getChildren();
   YGMeasureMode measureModeMainDim =
       YGFlexDirectionIsRow(mainAxis) ? widthMeasureMode : heightMeasureMode;
   // If there is only one child with flexGrow + flexShrink it means we can set
@@ -1857,6 +2278,12 @@ static float YGNodeComputeFlexBasisForChildren(
 
   for (auto child : children) {
     child->resolveDimension();
+    if (child->getLayout().isDeferred) {
+      // Its flex basis was only predicted, and it stayed dirty, so marking it
+      // dirty again hasn't cleared it.
+      child->setLayoutComputedFlexBasis(YGFloatOptional());
+      child->setLayoutIsDeferred(false);
+    }
     if (child->getStyle().display() == YGDisplayNone) {
       YGZeroOutLayoutRecursivly(child, layoutContext);
       child->setHasNewLayout(true);
@@ -1883,9 +2310,26 @@ static float YGNodeComputeFlexBasisForChildren(
       child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
       child->setLayoutComputedFlexBasis(YGFloatOptional(0));
     } else {
+      float deferredMainSize = YGUndefined;
+      if (lazyWindow != nullptr) {
+        const float lastMainSize =
+            child->getLayout().dimensions[dim[mainAxis]];
+        const float mainSize = YGFloatIsUndefined(lastMainSize)
+            ? lazyWindow->estimatedChildSize
+            : lastMainSize;
+        const float marginMain =
+            child->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+        if (totalOuterFlexBasis >= lazyWindow->end ||
+            totalOuterFlexBasis + marginMain + mainSize <= lazyWindow->start) {
+          child->setLayoutIsDeferred(true);
+          deferredMainSize = mainSize;
+        }
+      }
       YGNodeComputeFlexBasisForChild(
           node,
           child,
+          mainAxis,
+          deferredMainSize,
           availableInnerWidth,
           widthMeasureMode,
           availableInnerHeight,
@@ -1895,6 +2339,7 @@ static float YGNodeComputeFlexBasisForChildren(
           direction,
           config,
           layoutMarkerData,
+          premeasuredSizes,
           layoutContext);
     }
 
@@ -1911,20 +2356,18 @@ static float YGNodeComputeFlexBasisForChildren(
 // computedFlexBasis properly computed(To do this use
 // YGNodeComputeFlexBasisForChildren function). This function calculates
 // YGCollectFlexItemsRowMeasurement
+template <typename MainAxis>
 static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
     const YGNodeRef& node,
-    const YGDirection ownerDirection,
+    const MainAxis mainAxis,
     const float mainAxisownerSize,
     const float availableInnerWidth,
     const float availableInnerMainDim,
     const uint32_t startOfLineIndex,
     const uint32_t lineCount) {
   YGCollectFlexItemsRowValues flexAlgoRowMeasurement = {};
-  flexAlgoRowMeasurement.relativeChildren.reserve(node->getChildren().size());
 
   float sizeConsumedOnCurrentLineIncludingMinConstraint = 0;
-  const YGFlexDirection mainAxis = YGResolveFlexDirection(
-      node->getStyle().flexDirection(), node->resolveDirection(ownerDirection));
   const bool isNodeFlexWrap = node->getStyle().flexWrap() != YGWrapNoWrap;
 
   // Add items to the current line until it's full or we run out of items.
@@ -1971,8 +2414,6 @@ static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
           -child->resolveFlexShrink() *
           child->getLayout().computedFlexBasis.unwrap();
     }
-
-    flexAlgoRowMeasurement.relativeChildren.push_back(child);
   }
 
   // The total flex factor needs to be floored to 1.
@@ -1987,6 +2428,8 @@ static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
     flexAlgoRowMeasurement.totalFlexShrinkScaledFactors = 1;
   }
   flexAlgoRowMeasurement.endOfLineIndex = endOfLineIndex;
+  flexAlgoRowMeasurement.relativeChildren =
+      YGLineChildren{node->getChildren(), startOfLineIndex, endOfLineIndex};
   return flexAlgoRowMeasurement;
 }
 
@@ -1994,10 +2437,11 @@ static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
 // of the flex items abide the min and max constraints. At the end of this
 // function the child nodes would have proper size. Prior using this function
 // please ensure that YGDistributeFreeSpaceFirstPass is called.
+template <typename MainAxis>
 static float YGDistributeFreeSpaceSecondPass(
     YGCollectFlexItemsRowValues& collectedFlexItemsValues,
     const YGNodeRef node,
-    const YGFlexDirection mainAxis,
+    const MainAxis mainAxis,
     const YGFlexDirection crossAxis,
     const float mainAxisownerSize,
     const float availableInnerMainDim,
@@ -2009,6 +2453,7 @@ static float YGDistributeFreeSpaceSecondPass(
     const bool performLayout,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
   float childFlexBasis = 0;
   float flexShrinkScaledFactor = 0;
@@ -2160,6 +2605,19 @@ static float YGDistributeFreeSpaceSecondPass(
     const YGMeasureMode childHeightMeasureMode =
         !isMainAxisRow ? childMainMeasureMode : childCrossMeasureMode;
 
+    if (currentRelativeChild->getLayout().isDeferred) {
+      YGNodeSetDeferredLayout(
+          currentRelativeChild,
+          childWidth,
+          childHeight,
+          childWidthMeasureMode,
+          childHeightMeasureMode,
+          availableInnerWidth,
+          availableInnerHeight,
+          performLayout);
+      continue;
+    }
+
     // Recursively call the layout algorithm for this child with the updated
     // main size.
     YGLayoutNodeInternal(
@@ -2175,6 +2633,7 @@ static float YGDistributeFreeSpaceSecondPass(
         "flex",
         config,
         layoutMarkerData,
+        premeasuredSizes,
         layoutContext);
     node->setLayoutHadOverflow(
         node->getLayout().hadOverflow |
@@ -2186,9 +2645,10 @@ static float YGDistributeFreeSpaceSecondPass(
 // It distributes the free space to the flexible items.For those flexible items
 // whose min and max constraints are triggered, those flex item's clamped size
 // is removed from the remaingfreespace.
+template <typename MainAxis>
 static void YGDistributeFreeSpaceFirstPass(
     YGCollectFlexItemsRowValues& collectedFlexItemsValues,
-    const YGFlexDirection mainAxis,
+    const MainAxis mainAxis,
     const float mainAxisownerSize,
     const float availableInnerMainDim,
     const float availableInnerWidth) {
@@ -2291,10 +2751,11 @@ static void YGDistributeFreeSpaceFirstPass(
 // At the end of this function the child nodes would have the proper size
 // assigned to them.
 //
+template <typename MainAxis>
 static void YGResolveFlexibleLength(
     const YGNodeRef node,
     YGCollectFlexItemsRowValues& collectedFlexItemsValues,
-    const YGFlexDirection mainAxis,
+    const MainAxis mainAxis,
     const YGFlexDirection crossAxis,
     const float mainAxisownerSize,
     const float availableInnerMainDim,
@@ -2306,6 +2767,7 @@ static void YGResolveFlexibleLength(
     const bool performLayout,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
   const float originalFreeSpace = collectedFlexItemsValues.remainingFreeSpace;
   // First pass: detect the flex items whose min/max constraints trigger
@@ -2332,17 +2794,19 @@ static void YGResolveFlexibleLength(
       performLayout,
       config,
       layoutMarkerData,
+      premeasuredSizes,
       layoutContext);
 
   collectedFlexItemsValues.remainingFreeSpace =
       originalFreeSpace - distributedFreeSpace;
 }
 
+template <typename MainAxis>
 static void YGJustifyMainAxis(
     const YGNodeRef node,
     YGCollectFlexItemsRowValues& collectedFlexItemsValues,
     const uint32_t startOfLineIndex,
-    const YGFlexDirection mainAxis,
+    const MainAxis mainAxis,
     const YGFlexDirection crossAxis,
     const YGMeasureMode measureModeMainDim,
     const YGMeasureMode measureModeCrossDim,
@@ -2454,7 +2918,7 @@ static void YGJustifyMainAxis(
        i++) {
     const YGNodeRef child = node->getChild(i);
     const YGStyle& childStyle = child->getStyle();
-    const YGLayout childLayout = child->getLayout();
+    const YGLayout& childLayout = child->getLayout();
     if (childStyle.display() == YGDisplayNone) {
       continue;
     }
@@ -2555,6 +3019,53 @@ static void YGJustifyMainAxis(
   }
 }
 
+// Runs the statement with constantMainAxis bound to the main axis as a
+// YGConstantAxis.  Only the kernels that loop over the children of a line are
+// called through it, so that they are instantiated for each main axis while
+// the rest of the container is compiled once.
+#define YG_WITH_CONSTANT_MAIN_AXIS(mainAxis, ...)                       \
+  switch (mainAxis) {                                                  \
+    case YGFlexDirectionColumn: {                                      \
+      const YGConstantAxis<YGFlexDirectionColumn> constantMainAxis{};  \
+      __VA_ARGS__;                                                     \
+      break;                                                           \
+    }                                                                  \
+    case YGFlexDirectionColumnReverse: {                               \
+      const YGConstantAxis<YGFlexDirectionColumnReverse>               \
+          constantMainAxis{};                                          \
+      __VA_ARGS__;                                                     \
+      break;                                                           \
+    }                                                                  \
+    case YGFlexDirectionRow: {                                         \
+      const YGConstantAxis<YGFlexDirectionRow> constantMainAxis{};     \
+      __VA_ARGS__;                                                     \
+      break;                                                           \
+    }                                                                  \
+    case YGFlexDirectionRowReverse: {                                  \
+      const YGConstantAxis<YGFlexDirectionRowReverse> constantMainAxis{}; \
+      __VA_ARGS__;                                                     \
+      break;                                                           \
+    }                                                                  \
+  }
+
+// Steps 1 to 11 of YGNodelayoutImpl, which lay out the children of a container
+// along its main axis.
+static void YGNodeLayoutFlexContainer(
+    const YGNodeRef node,
+    const YGFlexDirection mainAxis,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection direction,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
+    void* const layoutContext);
+
 //
 // This is the main routine that implements a subset of the flexbox layout
 // algorithm described in the W3C CSS documentation:
@@ -2632,6 +3143,7 @@ static void YGNodelayoutImpl(
     const bool performLayout,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
   YGAssertWithNode(
       node,
@@ -2700,6 +3212,7 @@ static void YGNodelayoutImpl(
         heightMeasureMode,
         ownerWidth,
         ownerHeight,
+        premeasuredSizes,
         layoutContext);
     return;
   }
@@ -2737,9 +3250,41 @@ static void YGNodelayoutImpl(
   // Reset layout flags, as they could have changed.
   node->setLayoutHadOverflow(false);
 
+  YGNodeLayoutFlexContainer(
+      node,
+      YGResolveFlexDirection(node->getStyle().flexDirection(), direction),
+      availableWidth,
+      availableHeight,
+      direction,
+      widthMeasureMode,
+      heightMeasureMode,
+      ownerWidth,
+      ownerHeight,
+      performLayout,
+      config,
+      layoutMarkerData,
+      premeasuredSizes,
+      layoutContext);
+}
+
+static void YGNodeLayoutFlexContainer(
+    const YGNodeRef node,
+    const YGFlexDirection mainAxis,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection direction,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    const bool performLayout,
+    const YGConfigRef config,
+    YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
+    void* const layoutContext) {
+  const uint32_t childCount = YGNodeGetChildCount(node);
+
   // STEP 1: CALCULATE VALUES FOR REMAINDER OF ALGORITHM
-  const YGFlexDirection mainAxis =
-      YGResolveFlexDirection(node->getStyle().flexDirection(), direction);
   const YGFlexDirection crossAxis = YGFlexDirectionCross(mainAxis, direction);
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
   const bool isNodeFlexWrap = node->getStyle().flexWrap() != YGWrapNoWrap;
@@ -2799,20 +3344,42 @@ static void YGNodelayoutImpl(
   const float availableInnerCrossDim =
       isMainAxisRow ? availableInnerHeight : availableInnerWidth;
 
+  // Only the children within the viewport are laid out, as long as where they
+  // are doesn't depend on the free space or on their baselines.
+  const YGViewport* viewport = node->getViewport();
+  YGLazyWindow lazyWindow;
+  const bool isLazy = viewport != nullptr && !isNodeFlexWrap &&
+      node->getStyle().justifyContent() == YGJustifyFlexStart &&
+      !YGIsBaselineLayout(node);
+  if (isLazy) {
+    const float leadingPaddingAndBorderMain =
+        node->getLeadingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
+    lazyWindow.start =
+        viewport->offset - viewport->overscan - leadingPaddingAndBorderMain;
+    lazyWindow.end = viewport->offset + viewport->length +
+        viewport->overscan - leadingPaddingAndBorderMain;
+    lazyWindow.estimatedChildSize = viewport->estimatedChildSize;
+  }
+
   // STEP 3: DETERMINE FLEX BASIS FOR EACH ITEM
 
-  float totalOuterFlexBasis = YGNodeComputeFlexBasisForChildren(
-      node,
-      availableInnerWidth,
-      availableInnerHeight,
-      widthMeasureMode,
-      heightMeasureMode,
-      direction,
+  float totalOuterFlexBasis = 0;
+  YG_WITH_CONSTANT_MAIN_AXIS(
       mainAxis,
-      config,
-      performLayout,
-      layoutMarkerData,
-      layoutContext);
+      totalOuterFlexBasis = YGNodeComputeFlexBasisForChildren(
+          node,
+          availableInnerWidth,
+          availableInnerHeight,
+          widthMeasureMode,
+          heightMeasureMode,
+          direction,
+          constantMainAxis,
+          config,
+          performLayout,
+          isLazy ? &lazyWindow : nullptr,
+          layoutMarkerData,
+          premeasuredSizes,
+          layoutContext));
 
   const bool flexBasisOverflows = measureModeMainDim == YGMeasureModeUndefined
       ? false
@@ -2838,14 +3405,16 @@ static void YGNodelayoutImpl(
   YGCollectFlexItemsRowValues collectedFlexItemsValues;
   for (; endOfLineIndex < childCount;
        lineCount++, startOfLineIndex = endOfLineIndex) {
-    collectedFlexItemsValues = YGCalculateCollectFlexItemsRowValues(
-        node,
-        ownerDirection,
-        mainAxisownerSize,
-        availableInnerWidth,
-        availableInnerMainDim,
-        startOfLineIndex,
-        lineCount);
+    YG_WITH_CONSTANT_MAIN_AXIS(
+        mainAxis,
+        collectedFlexItemsValues = YGCalculateCollectFlexItemsRowValues(
+            node,
+            constantMainAxis,
+            mainAxisownerSize,
+            availableInnerWidth,
+            availableInnerMainDim,
+            startOfLineIndex,
+            lineCount));
     endOfLineIndex = collectedFlexItemsValues.endOfLineIndex;
 
     // If we don't need to measure the cross axis, we can skip the entire flex
@@ -2905,22 +3474,25 @@ static void YGNodelayoutImpl(
     }
 
     if (!canSkipFlex) {
-      YGResolveFlexibleLength(
-          node,
-          collectedFlexItemsValues,
+      YG_WITH_CONSTANT_MAIN_AXIS(
           mainAxis,
-          crossAxis,
-          mainAxisownerSize,
-          availableInnerMainDim,
-          availableInnerCrossDim,
-          availableInnerWidth,
-          availableInnerHeight,
-          flexBasisOverflows,
-          measureModeCrossDim,
-          performLayout,
-          config,
-          layoutMarkerData,
-          layoutContext);
+          YGResolveFlexibleLength(
+              node,
+              collectedFlexItemsValues,
+              constantMainAxis,
+              crossAxis,
+              mainAxisownerSize,
+              availableInnerMainDim,
+              availableInnerCrossDim,
+              availableInnerWidth,
+              availableInnerHeight,
+              flexBasisOverflows,
+              measureModeCrossDim,
+              performLayout,
+              config,
+              layoutMarkerData,
+              premeasuredSizes,
+              layoutContext));
     }
 
     node->setLayoutHadOverflow(
@@ -2934,21 +3506,23 @@ static void YGNodelayoutImpl(
     // of items that are aligned "stretch". We need to compute these stretch
     // values and set the final positions.
 
-    YGJustifyMainAxis(
-        node,
-        collectedFlexItemsValues,
-        startOfLineIndex,
+    YG_WITH_CONSTANT_MAIN_AXIS(
         mainAxis,
-        crossAxis,
-        measureModeMainDim,
-        measureModeCrossDim,
-        mainAxisownerSize,
-        ownerWidth,
-        availableInnerMainDim,
-        availableInnerCrossDim,
-        availableInnerWidth,
-        performLayout,
-        layoutContext);
+        YGJustifyMainAxis(
+            node,
+            collectedFlexItemsValues,
+            startOfLineIndex,
+            constantMainAxis,
+            crossAxis,
+            measureModeMainDim,
+            measureModeCrossDim,
+            mainAxisownerSize,
+            ownerWidth,
+            availableInnerMainDim,
+            availableInnerCrossDim,
+            availableInnerWidth,
+            performLayout,
+            layoutContext));
 
     float containerCrossAxis = availableInnerCrossDim;
     if (measureModeCrossDim == YGMeasureModeUndefined ||
@@ -3081,20 +3655,33 @@ static void YGNodelayoutImpl(
                   ? YGMeasureModeUndefined
                   : YGMeasureModeExactly;
 
-              YGLayoutNodeInternal(
-                  child,
-                  childWidth,
-                  childHeight,
-                  direction,
-                  childWidthMeasureMode,
-                  childHeightMeasureMode,
-                  availableInnerWidth,
-                  availableInnerHeight,
-                  true,
-                  "stretch",
-                  config,
-                  layoutMarkerData,
-                  layoutContext);
+              if (child->getLayout().isDeferred) {
+                YGNodeSetDeferredLayout(
+                    child,
+                    childWidth,
+                    childHeight,
+                    childWidthMeasureMode,
+                    childHeightMeasureMode,
+                    availableInnerWidth,
+                    availableInnerHeight,
+                    true);
+              } else {
+                YGLayoutNodeInternal(
+                    child,
+                    childWidth,
+                    childHeight,
+                    direction,
+                    childWidthMeasureMode,
+                    childHeightMeasureMode,
+                    availableInnerWidth,
+                    availableInnerHeight,
+                    true,
+                    "stretch",
+                    config,
+                    layoutMarkerData,
+                    premeasuredSizes,
+                    layoutContext);
+              }
             }
           } else {
             const float remainingCrossDim = containerCrossAxis -
@@ -3302,6 +3889,7 @@ static void YGNodelayoutImpl(
                         "multiline-stretch",
                         config,
                         layoutMarkerData,
+                        premeasuredSizes,
                         layoutContext);
                   }
                 }
@@ -3442,6 +4030,7 @@ static void YGNodelayoutImpl(
           direction,
           config,
           layoutMarkerData,
+          premeasuredSizes,
           layoutContext);
     }
 
@@ -3470,6 +4059,8 @@ static void YGNodelayoutImpl(
   }
 }
 
+#undef YG_WITH_CONSTANT_MAIN_AXIS
+
 uint32_t gDepth = 0;
 bool gPrintChanges = false;
 bool gPrintSkips = false;
@@ -3532,7 +4123,11 @@ static inline bool YGMeasureModeNewMeasureSizeIsStricterAndStillValid(
       (lastComputedSize <= size || YGFloatsEqual(size, lastComputedSize));
 }
 
-float YGRoundValueToPixelGrid(
+// Rounds in double precision.  Layout dimensions are the difference of two
+// rounded absolute edges, which in float can land further off the pixel grid
+// than YGDoubleEqual tolerates, so that rounding them again moves text nodes
+// by a pixel.
+static double YGRoundToPixelGridPrecise(
     const double value,
     const double pointScaleFactor,
     const bool forceCeil,
@@ -3583,6 +4178,15 @@ float YGRoundValueToPixelGrid(
       : scaledValue / pointScaleFactor;
 }
 
+float YGRoundValueToPixelGrid(
+    const double value,
+    const double pointScaleFactor,
+    const bool forceCeil,
+    const bool forceFloor) {
+  return YGRoundToPixelGridPrecise(
+      value, pointScaleFactor, forceCeil, forceFloor);
+}
+
 bool YGNodeCanUseCachedMeasurement(
     const YGMeasureMode widthMode,
     const float width,
@@ -3676,6 +4280,7 @@ bool YGLayoutNodeInternal(
     const char* reason,
     const YGConfigRef config,
     YGMarkerLayoutData& layoutMarkerData,
+    const YGPremeasuredSizes* premeasuredSizes,
     void* const layoutContext) {
 #ifdef YG_ENABLE_EVENTS
   Event::publish<Event::NodeLayout>(node);
@@ -3838,6 +4443,7 @@ bool YGLayoutNodeInternal(
         performLayout,
         config,
         layoutMarkerData,
+        premeasuredSizes,
         layoutContext);
 
     if (gPrintChanges) {
@@ -3942,6 +4548,16 @@ static void YGRoundToPixelGrid(
     return;
   }
 
+  // Values already on the pixel grid round to themselves, whatever the
+  // absolute offset, so nodes that haven't been laid out since they were
+  // rounded can be skipped.  So can their subtrees, as a node is only laid out
+  // as part of laying out its owner.  Infinite or undefined offsets aren't
+  // skipped, as rounding makes the whole subtree undefined.
+  if (node->getLayout().roundedPointScaleFactor == pointScaleFactor &&
+      std::isfinite(absoluteLeft) && std::isfinite(absoluteTop)) {
+    return;
+  }
+
   const double nodeLeft = node->getLayout().position[YGEdgeLeft];
   const double nodeTop = node->getLayout().position[YGEdgeTop];
 
@@ -3977,24 +4593,25 @@ static void YGRoundToPixelGrid(
       !YGDoubleEqual(fmod(nodeHeight * pointScaleFactor, 1.0), 1.0);
 
   node->setLayoutDimension(
-      YGRoundValueToPixelGrid(
+      YGRoundToPixelGridPrecise(
           absoluteNodeRight,
           pointScaleFactor,
           (textRounding && hasFractionalWidth),
           (textRounding && !hasFractionalWidth)) -
-          YGRoundValueToPixelGrid(
+          YGRoundToPixelGridPrecise(
               absoluteNodeLeft, pointScaleFactor, false, textRounding),
       YGDimensionWidth);
 
   node->setLayoutDimension(
-      YGRoundValueToPixelGrid(
+      YGRoundToPixelGridPrecise(
           absoluteNodeBottom,
           pointScaleFactor,
           (textRounding && hasFractionalHeight),
           (textRounding && !hasFractionalHeight)) -
-          YGRoundValueToPixelGrid(
+          YGRoundToPixelGridPrecise(
               absoluteNodeTop, pointScaleFactor, false, textRounding),
       YGDimensionHeight);
+  node->setLayoutRoundedPointScaleFactor(pointScaleFactor);
 
   const uint32_t childCount = YGNodeGetChildCount(node);
   for (uint32_t i = 0; i < childCount; i++) {
@@ -4006,96 +4623,121 @@ static void YGRoundToPixelGrid(
   }
 }
 
-void YGNodeCalculateLayoutWithContext(
+static void YGCollectChangedNodes(
+    const YGNodeRef node,
+    std::vector<YGNodeRef>& changedNodes) {
+  if (node->hasRecordedLayoutOutputs()) {
+    return;
+  }
+  if (node->recordLayoutOutputs()) {
+    changedNodes.push_back(node);
+  }
+  for (auto child : node->getChildren()) {
+    YGCollectChangedNodes(child, changedNodes);
+  }
+}
+
+static void YGCalculateLayout(
     const YGNodeRef node,
     const float ownerWidth,
     const float ownerHeight,
     const YGDirection ownerDirection,
-    void* layoutContext) {
+    void* layoutContext,
+    std::vector<YGNodeRef>* changedNodes) {
 
 #ifdef YG_ENABLE_EVENTS
   Event::publish<Event::LayoutPassStart>(node);
 #endif
-  // unique pointer to allow ending the marker early
-  std::unique_ptr<marker::MarkerSection<YGMarkerLayout>> marker{
-      new marker::MarkerSection<YGMarkerLayout>{node}};
-
-  // Increment the generation count. This will force the recursive routine to
-  // visit all dirty nodes at least once. Subsequent visits will be skipped if
-  // the input parameters don't change.
-  gCurrentGenerationCount++;
-  node->resolveDimension();
   float width = YGUndefined;
   YGMeasureMode widthMeasureMode = YGMeasureModeUndefined;
-  const auto& maxDimensions = node->getStyle().maxDimensions();
-  if (YGNodeIsStyleDimDefined(node, YGFlexDirectionRow, ownerWidth)) {
-    width =
-        (YGResolveValue(
-             node->getResolvedDimension(dim[YGFlexDirectionRow]), ownerWidth) +
-         node->getMarginForAxis(YGFlexDirectionRow, ownerWidth))
-            .unwrap();
-    widthMeasureMode = YGMeasureModeExactly;
-  } else if (!YGResolveValue(maxDimensions[YGDimensionWidth], ownerWidth)
-                  .isUndefined()) {
-    width =
-        YGResolveValue(maxDimensions[YGDimensionWidth], ownerWidth).unwrap();
-    widthMeasureMode = YGMeasureModeAtMost;
-  } else {
-    width = ownerWidth;
-    widthMeasureMode = YGFloatIsUndefined(width) ? YGMeasureModeUndefined
-                                                 : YGMeasureModeExactly;
-  }
-
   float height = YGUndefined;
   YGMeasureMode heightMeasureMode = YGMeasureModeUndefined;
-  if (YGNodeIsStyleDimDefined(node, YGFlexDirectionColumn, ownerHeight)) {
-    height = (YGResolveValue(
-                  node->getResolvedDimension(dim[YGFlexDirectionColumn]),
-                  ownerHeight) +
-              node->getMarginForAxis(YGFlexDirectionColumn, ownerWidth))
-                 .unwrap();
-    heightMeasureMode = YGMeasureModeExactly;
-  } else if (!YGResolveValue(maxDimensions[YGDimensionHeight], ownerHeight)
-                  .isUndefined()) {
-    height =
-        YGResolveValue(maxDimensions[YGDimensionHeight], ownerHeight).unwrap();
-    heightMeasureMode = YGMeasureModeAtMost;
-  } else {
-    height = ownerHeight;
-    heightMeasureMode = YGFloatIsUndefined(height) ? YGMeasureModeUndefined
+  {
+    // Scoped to end the marker before the end of the pass is published.
+    marker::MarkerSection<YGMarkerLayout> marker{node};
+
+    // Increment the generation count. This will force the recursive routine to
+    // visit all dirty nodes at least once. Subsequent visits will be skipped if
+    // the input parameters don't change.
+    gCurrentGenerationCount++;
+    node->resolveDimension();
+    YGPremeasuredSizes premeasuredSizes;
+    if (node->getConfig()->batchMeasureFunc != nullptr) {
+      premeasuredSizes.measure(node, node->getConfig()->batchMeasureFunc);
+    }
+    const auto& maxDimensions = node->getStyle().maxDimensions();
+    if (YGNodeIsStyleDimDefined(node, YGFlexDirectionRow, ownerWidth)) {
+      width = (YGResolveValue(
+                   node->getResolvedDimension(dim[YGFlexDirectionRow]),
+                   ownerWidth) +
+               node->getMarginForAxis(YGFlexDirectionRow, ownerWidth))
+                  .unwrap();
+      widthMeasureMode = YGMeasureModeExactly;
+    } else if (!YGResolveValue(maxDimensions[YGDimensionWidth], ownerWidth)
+                    .isUndefined()) {
+      width =
+          YGResolveValue(maxDimensions[YGDimensionWidth], ownerWidth).unwrap();
+      widthMeasureMode = YGMeasureModeAtMost;
+    } else {
+      width = ownerWidth;
+      widthMeasureMode = YGFloatIsUndefined(width) ? YGMeasureModeUndefined
                                                    : YGMeasureModeExactly;
-  }
-  if (YGLayoutNodeInternal(
-          node,
-          width,
-          height,
-          ownerDirection,
-          widthMeasureMode,
-          heightMeasureMode,
-          ownerWidth,
-          ownerHeight,
-          true,
-          "initial",
-          node->getConfig(),
-          marker->data,
-          layoutContext)) {
-    node->setPosition(
-        node->getLayout().direction, ownerWidth, ownerHeight, ownerWidth);
-    YGRoundToPixelGrid(node, node->getConfig()->pointScaleFactor, 0.0f, 0.0f);
+    }
 
-#ifdef DEBUG
-    if (node->getConfig()->printTree) {
-      YGNodePrint(
-          node,
-          (YGPrintOptions)(
-              YGPrintOptionsLayout | YGPrintOptionsChildren |
-              YGPrintOptionsStyle));
+    if (YGNodeIsStyleDimDefined(node, YGFlexDirectionColumn, ownerHeight)) {
+      height = (YGResolveValue(
+                    node->getResolvedDimension(dim[YGFlexDirectionColumn]),
+                    ownerHeight) +
+                node->getMarginForAxis(YGFlexDirectionColumn, ownerWidth))
+                   .unwrap();
+      heightMeasureMode = YGMeasureModeExactly;
+    } else if (!YGResolveValue(maxDimensions[YGDimensionHeight], ownerHeight)
+                    .isUndefined()) {
+      height = YGResolveValue(maxDimensions[YGDimensionHeight], ownerHeight)
+                   .unwrap();
+      heightMeasureMode = YGMeasureModeAtMost;
+    } else {
+      height = ownerHeight;
+      heightMeasureMode = YGFloatIsUndefined(height) ? YGMeasureModeUndefined
+                                                     : YGMeasureModeExactly;
     }
+    if (YGLayoutNodeInternal(
+            node,
+            width,
+            height,
+            ownerDirection,
+            widthMeasureMode,
+            heightMeasureMode,
+            ownerWidth,
+            ownerHeight,
+            true,
+            "initial",
+            node->getConfig(),
+            marker.data,
+            &premeasuredSizes,
+            layoutContext)) {
+      node->setPosition(
+          node->getLayout().direction, ownerWidth, ownerHeight, ownerWidth);
+      YGRoundToPixelGrid(node, node->getConfig()->pointScaleFactor, 0.0f, 0.0f);
+
+#ifdef DEBUG
+      if (node->getConfig()->printTree) {
+        YGNodePrint(
+            node,
+            (YGPrintOptions)(
+                YGPrintOptionsLayout | YGPrintOptionsChildren |
+                YGPrintOptionsStyle));
+      }
 #endif
-  }
+    }
 
-  // end marker here
-  marker = nullptr;
+    if (changedNodes != nullptr) {
+      // Compares the nodes laid out or positioned since they were last
+      // compared, whether or not by this pass, and skips the rest.
+      changedNodes->clear();
+      YGCollectChangedNodes(node, *changedNodes);
+    }
+  }
 
 #ifdef YG_ENABLE_EVENTS
   Event::publish<Event::LayoutPassEnd>(node);
@@ -4131,6 +4773,7 @@ void YGNodeCalculateLayoutWithContext(
             "initial",
             originalNode->getConfig(),
             layoutMarkerData,
+            nullptr,
             layoutContext)) {
       originalNode->setPosition(
           originalNode->getLayout().direction,
@@ -4163,6 +4806,16 @@ void YGNodeCalculateLayoutWithContext(
   }
 }
 
+void YGNodeCalculateLayoutWithContext(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection,
+    void* layoutContext) {
+  YGCalculateLayout(
+      node, ownerWidth, ownerHeight, ownerDirection, layoutContext, nullptr);
+}
+
 void YGNodeCalculateLayout(
     const YGNodeRef node,
     const float ownerWidth,
@@ -4172,6 +4825,22 @@ void YGNodeCalculateLayout(
       node, ownerWidth, ownerHeight, ownerDirection, nullptr);
 }
 
+void YGNodeCalculateLayoutWithChangedNodes(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection,
+    void* layoutContext,
+    std::vector<YGNodeRef>& changedNodes) {
+  YGCalculateLayout(
+      node,
+      ownerWidth,
+      ownerHeight,
+      ownerDirection,
+      layoutContext,
+      &changedNodes);
+}
+
 void YGConfigSetLogger(const YGConfigRef config, YGLogger logger) {
   if (logger != nullptr) {
     config->setLogger(logger);
@@ -4255,6 +4924,12 @@ void YGConfigSetCloneNodeFunc(
   config->setCloneNodeCallback(callback);
 }
 
+void YGConfigSetBatchMeasureFunc(
+    const YGConfigRef config,
+    const YGBatchMeasureFunc batchMeasureFunc) {
+  config->batchMeasureFunc = batchMeasureFunc;
+}
+
 static void YGTraverseChildrenPreOrder(
     const YGVector& children,
     const std::function<void(YGNodeRef node)>& f) {
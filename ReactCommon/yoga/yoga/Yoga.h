@@ -52,6 +52,30 @@ typedef int (*YGLogger)(
 typedef YGNodeRef (
     *YGCloneNodeFunc)(YGNodeRef oldNode, YGNodeRef owner, int childIndex);
 
+// A leaf and the constraints its measure function would be called with, and
+// the size measured for them.
+typedef struct YGMeasureRequest {
+  YGNodeRef node;
+  float width;
+  YGMeasureMode widthMode;
+  float height;
+  YGMeasureMode heightMode;
+  YGSize size;
+} YGMeasureRequest;
+typedef void (*YGBatchMeasureFunc)(YGMeasureRequest* requests, uint32_t count);
+
+// The part of a container's main axis that is visible, for containers with
+// many children that lay out lazily, such as the content of a scroll view.
+// The offset is from the leading edge of the container's main axis, e.g. from
+// the bottom for YGFlexDirectionColumnReverse, and the overscan extends the
+// viewport on either side.
+typedef struct YGViewport {
+  float offset;
+  float length;
+  float overscan;
+  float estimatedChildSize;
+} YGViewport;
+
 // YGNode
 WIN_EXPORT YGNodeRef YGNodeNew(void);
 WIN_EXPORT YGNodeRef YGNodeNewWithConfig(YGConfigRef config);
@@ -91,6 +115,16 @@ WIN_EXPORT void YGNodeCalculateLayout(
     float availableHeight,
     YGDirection ownerDirection);
 
+// Lays out only the children of the node that are within the viewport along
+// its main axis, when it doesn't wrap, justifies its content to flex-start and
+// doesn't align to baselines. Children are predicted to be where they would be
+// if the ones before them had the size they were last laid out at, or the
+// estimated child size if they never were. Those predicted to be outside the
+// viewport are deferred, see YGNodeLayoutGetIsDeferred. They are laid out once
+// they are in the viewport, by a layout after it has been moved there.
+WIN_EXPORT void YGNodeSetViewport(YGNodeRef node, YGViewport viewport);
+WIN_EXPORT void YGNodeClearViewport(YGNodeRef node);
+
 // Mark a node as dirty. Only valid for nodes with a custom measure function
 // set.
 //
@@ -126,6 +160,53 @@ WIN_EXPORT bool YGNodeCanUseCachedMeasurement(
 
 WIN_EXPORT void YGNodeCopyStyle(YGNodeRef dstNode, YGNodeRef srcNode);
 
+// Style properties, numbered as in YGStyle. Margin, position, padding and
+// border are followed by one property per YGEdge, and the dimensions and their
+// bounds by one per YGDimension, so e.g. the top margin is
+// YGStylePropMargin + YGEdgeTop.
+typedef enum YGStyleProp {
+  YGStylePropDirection,
+  YGStylePropFlexDirection,
+  YGStylePropJustifyContent,
+  YGStylePropAlignContent,
+  YGStylePropAlignItems,
+  YGStylePropAlignSelf,
+  YGStylePropPositionType,
+  YGStylePropFlexWrap,
+  YGStylePropOverflow,
+  YGStylePropDisplay,
+  YGStylePropFlex,
+  YGStylePropFlexGrow,
+  YGStylePropFlexShrink,
+  YGStylePropFlexBasis,
+  YGStylePropMargin,
+  YGStylePropPosition = YGStylePropMargin + 9,
+  YGStylePropPadding = YGStylePropPosition + 9,
+  YGStylePropBorder = YGStylePropPadding + 9,
+  YGStylePropDimensions = YGStylePropBorder + 9,
+  YGStylePropMaxDimensions = YGStylePropDimensions + 2,
+  YGStylePropMinDimensions = YGStylePropMaxDimensions + 2,
+  YGStylePropAspectRatio = YGStylePropMinDimensions + 2,
+  YGStylePropCount,
+} YGStyleProp;
+
+// The value of a style property. Enums are stored as the float of their
+// value, and properties without a unit ignore it. Otherwise the unit selects
+// between the setters of the property, e.g. YGNodeStyleSetWidthPercent for
+// YGUnitPercent. A unit that the property has no setter for, e.g. YGUnitAuto
+// for a padding, is a fatal error.
+typedef struct YGStyleUpdate {
+  uint32_t prop;
+  YGValue value;
+} YGStyleUpdate;
+
+// Applies the updates to the style of the node in order, and marks the node
+// and its owners dirty once if any of them changed it.
+WIN_EXPORT void YGNodeStyleApplyUpdates(
+    YGNodeRef node,
+    const YGStyleUpdate* updates,
+    uint32_t count);
+
 WIN_EXPORT void* YGNodeGetContext(YGNodeRef node);
 WIN_EXPORT void YGNodeSetContext(YGNodeRef node, void* context);
 void YGConfigSetPrintTreeFlag(YGConfigRef config, bool enabled);
@@ -278,6 +359,11 @@ WIN_EXPORT float YGNodeLayoutGetWidth(YGNodeRef node);
 WIN_EXPORT float YGNodeLayoutGetHeight(YGNodeRef node);
 WIN_EXPORT YGDirection YGNodeLayoutGetDirection(YGNodeRef node);
 WIN_EXPORT bool YGNodeLayoutGetHadOverflow(YGNodeRef node);
+// Whether the node's layout was deferred because it is outside the viewport of
+// its owner. It was then only sized along its owner's main axis, to the size
+// it was last laid out at, or else to the estimated child size of the
+// viewport, and its subtree keeps the layout it had.
+WIN_EXPORT bool YGNodeLayoutGetIsDeferred(YGNodeRef node);
 bool YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(YGNodeRef node);
 
 float YGNodeLayoutGetPointScaleFactor(YGNodeRef node);
@@ -342,6 +428,16 @@ WIN_EXPORT void YGConfigSetCloneNodeFunc(
     YGConfigRef config,
     YGCloneNodeFunc callback);
 
+// Measures many leaves in one call at the start of each layout pass, which
+// hosts can spread across threads.  It is given the dirty leaves under the
+// root, with the constraints each was measured with by the last pass, as when
+// only their content changed.  Sizes left undefined, other constraints and
+// leaves that were never laid out are measured by the measure functions of
+// the nodes during the pass.  The config of the root is the one used.
+WIN_EXPORT void YGConfigSetBatchMeasureFunc(
+    YGConfigRef config,
+    YGBatchMeasureFunc batchMeasureFunc);
+
 // Export only for C#
 WIN_EXPORT YGConfigRef YGConfigGetDefault(void);
 
@@ -368,4 +464,18 @@ void YGTraversePreOrder(
 
 void YGNodeSetChildren(YGNodeRef owner, const std::vector<YGNodeRef>& children);
 
+// Like YGNodeCalculateLayoutWithContext, replacing the contents of
+// changedNodes with the nodes whose layout (position, dimensions, margin,
+// border, padding or direction) differs from when it was last collected this
+// way, in pre-order.  The first call collects every node.  Changes made in
+// between by YGNodeCalculateLayout are collected by the next call.  Only the
+// nodes laid out or positioned since the last call are compared.
+void YGNodeCalculateLayoutWithChangedNodes(
+    YGNodeRef node,
+    float ownerWidth,
+    float ownerHeight,
+    YGDirection ownerDirection,
+    void* layoutContext,
+    std::vector<YGNodeRef>& changedNodes);
+
 #endif
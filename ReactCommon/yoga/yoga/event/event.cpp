@@ -5,51 +5,43 @@
  * file in the root directory of this source tree.
  */
 #include "event.h"
-#include <memory>
-#include <stdexcept>
-#include <mutex>
-
-#include <iostream>
+#include "../YGConfig.h"
+#include "../YGNode.h"
 
 namespace facebook {
 namespace yoga {
 
 namespace {
 
-std::mutex& eventSubscribersMutex() {
-  static std::mutex subscribersMutex;
-  return subscribersMutex;
-}
-
-std::shared_ptr<Event::Subscribers>& eventSubscribers() {
-  static auto subscribers = std::make_shared<Event::Subscribers>();
+Event::Subscribers& globalSubscribers() {
+  static Event::Subscribers subscribers;
   return subscribers;
 }
 
 } // namespace
 
 void Event::reset() {
-  eventSubscribers() = std::make_shared<Event::Subscribers>();
+  globalSubscribers().clear();
 }
 
 void Event::subscribe(std::function<Subscriber>&& subscriber) {
-  std::lock_guard<std::mutex> guard(eventSubscribersMutex());
-  eventSubscribers() =
-      std::make_shared<Event::Subscribers>(*eventSubscribers());
-  eventSubscribers()->push_back(subscriber);
+  globalSubscribers().add(std::move(subscriber));
 }
 
-void Event::publish(const YGNode& node, Type eventType, const Data& eventData) {
-  std::shared_ptr<Event::Subscribers> subscribers;
-  {
-    std::lock_guard<std::mutex> guard(eventSubscribersMutex());
-    subscribers = eventSubscribers();
+void Event::subscribe(
+    YGConfig* config,
+    std::function<Subscriber>&& subscriber) {
+  if (config->eventSubscribers == nullptr) {
+    config->eventSubscribers = new Subscribers;
   }
+  config->eventSubscribers->add(std::move(subscriber));
+}
 
-  for (auto& subscriber : *subscribers) {
-    if (subscriber) {
-      subscriber(node, eventType, eventData);
-    }
+void Event::publish(const YGNode& node, Type eventType, const Data& eventData) {
+  globalSubscribers().publish(node, eventType, eventData);
+  auto config = node.getConfig();
+  if (config != nullptr && config->eventSubscribers != nullptr) {
+    config->eventSubscribers->publish(node, eventType, eventData);
   }
 }
 
@@ -6,8 +6,9 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
-#include <vector>
 
 struct YGConfig;
 struct YGNode;
@@ -15,6 +16,8 @@ struct YGNode;
 namespace facebook {
 namespace yoga {
 
+class EventSubscribers;
+
 struct Event {
   enum Type {
     NodeAllocation,
@@ -25,7 +28,8 @@ struct Event {
   };
   class Data;
   using Subscriber = void(const YGNode&, Type, Data);
-  using Subscribers = std::vector<std::function<Subscriber>>;
+
+  using Subscribers = EventSubscribers;
 
   template <Type E>
   struct TypedData {};
@@ -43,13 +47,23 @@ struct Event {
     };
   };
 
+  // Removes the global subscribers.  Those of a config go with it.  Can be
+  // called while events are published, but not while subscribing.
   static void reset();
 
   static void subscribe(std::function<Subscriber>&& subscriber);
 
+  // Receives the events of the nodes using the config.  Like the config's
+  // setters, this must not race with layouts using the config.
+  static void subscribe(
+      YGConfig* config,
+      std::function<Subscriber>&& subscriber);
+
   template <Type E>
   static void publish(const YGNode& node, const TypedData<E>& eventData = {}) {
-    publish(node, E, Data{eventData});
+    if (subscriberCount().load(std::memory_order_relaxed) != 0) {
+      publish(node, E, Data{eventData});
+    }
   }
 
   template <Type E>
@@ -58,9 +72,103 @@ struct Event {
   }
 
 private:
+  friend class EventSubscribers;
+
+  // All subscribers, global and per config, so that publishing costs a
+  // single load while there are none.  Constant initialized, so there's no
+  // guard to check.
+  static std::atomic<size_t>& subscriberCount() {
+    static std::atomic<size_t> count{0};
+    return count;
+  }
+
   static void publish(const YGNode&, Type, const Data&);
 };
 
+// A list that can be published to while subscribers are added or cleared,
+// without locking.  Subscribers are called in the order they were added.
+// They can only be removed all at once, with clear(), which must not race
+// with add().  Publishers may still be walking the nodes clear() removes, so
+// these are only deleted with the list.
+//
+// Defined here rather than in event.cpp, so that YGConfigFree can delete the
+// list of a config in builds that leave event.cpp out.
+class EventSubscribers {
+public:
+  EventSubscribers() = default;
+  EventSubscribers(const EventSubscribers&) = delete;
+  EventSubscribers& operator=(const EventSubscribers&) = delete;
+  ~EventSubscribers() {
+    clear();
+    auto node = retired_.load(std::memory_order_acquire);
+    while (node != nullptr) {
+      auto next = node->nextRetired;
+      delete node;
+      node = next;
+    }
+  }
+
+  void add(std::function<Event::Subscriber>&& subscriber) {
+    auto node = new Node(std::move(subscriber));
+    // Appended to the last node, whichever it is by the time the exchange
+    // succeeds.  Release, so that publishers only see fully constructed
+    // nodes.
+    auto next = &head_;
+    Node* last = nullptr;
+    while (!next->compare_exchange_weak(
+        last, node, std::memory_order_release, std::memory_order_acquire)) {
+      if (last != nullptr) {
+        next = &last->next;
+        last = nullptr;
+      }
+    }
+    Event::subscriberCount().fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void clear() {
+    auto node = head_.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+      auto next = node->next.load(std::memory_order_acquire);
+      // Kept apart from `next`, which publishers may still follow.
+      node->nextRetired = retired_.load(std::memory_order_relaxed);
+      while (!retired_.compare_exchange_weak(
+          node->nextRetired,
+          node,
+          std::memory_order_release,
+          std::memory_order_relaxed)) {
+      }
+      Event::subscriberCount().fetch_sub(1, std::memory_order_relaxed);
+      node = next;
+    }
+  }
+
+  void publish(
+      const YGNode& node,
+      Event::Type eventType,
+      const Event::Data& eventData) const {
+    for (auto subscriber = head_.load(std::memory_order_acquire);
+         subscriber != nullptr;
+         subscriber = subscriber->next.load(std::memory_order_acquire)) {
+      if (subscriber->subscriber) {
+        subscriber->subscriber(node, eventType, eventData);
+      }
+    }
+  }
+
+private:
+  struct Node {
+    explicit Node(std::function<Event::Subscriber>&& subscriber)
+        : subscriber{std::move(subscriber)} {}
+
+    std::function<Event::Subscriber> subscriber;
+    std::atomic<Node*> next{nullptr};
+    Node* nextRetired = nullptr;
+  };
+
+  std::atomic<Node*> head_{nullptr};
+  std::atomic<Node*> retired_{nullptr};
+};
+
 template <>
 struct Event::TypedData<Event::NodeAllocation> {
   YGConfig* config;